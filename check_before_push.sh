@@ -53,6 +53,28 @@ else
     ANY_FAILURE=1
 fi
 
+echo ""
+echo "---------------------------------------"
+echo "And now let's start RadioHub tests:"
+if [ -f "build_test/radio-hub/tests/radiohub_tests" ]; then
+    ./build_test/radio-hub/tests/radiohub_tests
+    if [ $? -ne 0 ]; then ANY_FAILURE=1; fi
+else
+    echo "Oops: received an error: radiohub_tests binary not found!"
+    ANY_FAILURE=1
+fi
+
+echo ""
+echo "---------------------------------------"
+echo "And now let's start Controller tests:"
+if [ -f "build_test/controller/tests/controller_tests" ]; then
+    ./build_test/controller/tests/controller_tests
+    if [ $? -ne 0 ]; then ANY_FAILURE=1; fi
+else
+    echo "Oops: received an error: controller_tests binary not found!"
+    ANY_FAILURE=1
+fi
+
 echo "---------------------------------------"
 
 if [ $ANY_FAILURE -ne 0 ]; then
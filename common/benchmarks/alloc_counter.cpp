@@ -0,0 +1,78 @@
+#include "alloc_counter.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+
+namespace {
+
+std::atomic<uint64_t> alloc_count{0};
+std::atomic<uint64_t> alloc_bytes{0};
+
+void track(size_t size)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+#if defined(__GLIBC__)
+
+// glibc lets a program replace malloc; these forward to the real allocator
+// so memory from memalign and friends can still be freed here.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size)
+{
+    track(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    track(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    track(size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr)
+{
+    __libc_free(ptr);
+}
+}
+
+#endif
+
+AllocStats allocStats()
+{
+    return {alloc_count.load(std::memory_order_relaxed),
+            alloc_bytes.load(std::memory_order_relaxed)};
+}
+
+AllocScope::AllocScope(benchmark::State& state)
+    : state_(state)
+    , start_(allocStats())
+{
+}
+
+AllocScope::~AllocScope()
+{
+    const AllocStats end = allocStats();
+    state_.counters["allocs/op"] =
+        benchmark::Counter(static_cast<double>(end.count - start_.count),
+                           benchmark::Counter::kAvgIterations);
+    state_.counters["bytes/op"] =
+        benchmark::Counter(static_cast<double>(end.bytes - start_.bytes),
+                           benchmark::Counter::kAvgIterations);
+}
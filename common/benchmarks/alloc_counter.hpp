@@ -0,0 +1,40 @@
+#ifndef ALLOC_COUNTER_HPP
+#define ALLOC_COUNTER_HPP
+
+#include <cstdint>
+
+namespace benchmark {
+class State;
+}
+
+/**
+ * @brief Heap allocations made by this process so far: every malloc,
+ * calloc and realloc, so Qt containers and operator new both count.
+ * Only tracked on glibc; elsewhere both stay 0.
+ */
+struct AllocStats {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+AllocStats allocStats();
+
+/**
+ * @brief Reports allocs/op and bytes/op (heap bytes requested) for the
+ * benchmark loop that runs between construction and destruction.
+ */
+class AllocScope
+{
+public:
+    explicit AllocScope(benchmark::State& state);
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+    benchmark::State& state_;
+    const AllocStats start_;
+};
+
+#endif  // ALLOC_COUNTER_HPP
@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+
+// Generated on every build (git_commit.cmake); lets JSON runs of different
+// commits be told apart, e.g.
+//   common_benchmarks --benchmark_out=before.json --benchmark_out_format=json
+//   compare.py benchmarks before.json after.json
+#include "benchmark_git_commit.hpp"
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::AddCustomContext("git_commit", BENCHMARK_GIT_COMMIT);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
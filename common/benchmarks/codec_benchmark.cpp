@@ -0,0 +1,277 @@
+#include <benchmark/benchmark.h>
+
+#include <QByteArray>
+
+#include "alloc_counter.hpp"
+#include "iserializer.hpp"
+#include "message_fields.hpp"
+
+// Encode and decode cost of every ISerializer message. The ISerializer
+// benchmarks take the PayloadCodec as argument; the MessageCodec ones call
+// the generated templates directly, without virtual dispatch.
+// wire_bytes is the encoded payload size.
+
+namespace {
+
+const char* codecName(PayloadCodec codec)
+{
+    switch (codec) {
+        case PayloadCodec::PerAligned:
+            return "per_aligned";
+        case PayloadCodec::PerUnaligned:
+            return "per_unaligned";
+        case PayloadCodec::QDataStream:
+        default:
+            return "qdatastream";
+    }
+}
+
+SIB1Info makeSib1()
+{
+    SIB1Info sib1{101, GnbCellConfig({{250, 1}, {262, 2}}, 2)};
+    sib1.cell_config.tac = 100;
+    sib1.cell_config.minRxLevel = -115;
+    return sib1;
+}
+
+const SIB1Info SIB1 = makeSib1();
+const RachPreambleInfo RACH_PREAMBLE{17};
+const RarInfo RAR{17, 1501, 10};
+const RrcSetupRequest RRC_SETUP_REQUEST{0x2A5F00D1, 3};
+const RrcSetupInfo RRC_SETUP{0x2A5F00D1, 1};
+const RrcSetupCompleteInfo RRC_SETUP_COMPLETE{{250, 1}};
+const RrcReleaseCause RRC_RELEASE = RrcReleaseCause::UserInactivity;
+const RegistrationRequestInfo REGISTRATION_REQUEST{501, "NR-SA;n78"};
+const RegistrationAnswerInfo REGISTRATION_ANSWER{RegistrationStatus::Accepted};
+const MeasurementReportInfo MEASUREMENT_REPORT{102, -87.5};
+const HandoverInfo HANDOVER{102};
+const ChatMessageInfo CHAT_MESSAGE{501, 502, "See you at the next cell"};
+const GnbRegistrationInfo GNB_REGISTRATION{1200.0, 43.0, -115};
+
+template <typename Encode>
+void BM_Encode(benchmark::State& state, Encode encode)
+{
+    const auto codec = static_cast<PayloadCodec>(state.range(0));
+    const auto serializer = makeSerializer(codec);
+
+    QByteArray encoded;
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            encoded = encode(*serializer);
+            benchmark::DoNotOptimize(encoded.constData());
+        }
+    }
+    state.SetLabel(codecName(codec));
+    state.counters["wire_bytes"] = encoded.size();
+}
+
+template <typename Encode, typename Decode>
+void BM_Decode(benchmark::State& state, Encode encode, Decode decode)
+{
+    const auto codec = static_cast<PayloadCodec>(state.range(0));
+    const auto serializer = makeSerializer(codec);
+    const QByteArray encoded = encode(*serializer);
+
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            auto decoded = decode(*serializer, encoded);
+            benchmark::DoNotOptimize(decoded);
+        }
+    }
+    state.SetLabel(codecName(codec));
+    state.counters["wire_bytes"] = encoded.size();
+}
+
+template <typename T>
+void BM_MessageCodecEncode(benchmark::State& state, const T& message)
+{
+    QByteArray encoded;
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            encoded = MessageCodec::encode(message);
+            benchmark::DoNotOptimize(encoded.constData());
+        }
+    }
+    state.SetLabel("message_codec");
+    state.counters["wire_bytes"] = encoded.size();
+}
+
+template <typename T>
+void BM_MessageCodecDecode(benchmark::State& state, const T& message)
+{
+    const QByteArray encoded = MessageCodec::encode(message);
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            auto decoded = MessageCodec::decode<T>(encoded);
+            benchmark::DoNotOptimize(decoded);
+        }
+    }
+    state.SetLabel("message_codec");
+    state.counters["wire_bytes"] = encoded.size();
+}
+
+QByteArray encodeSib1(const ISerializer& s)
+{
+    return s.serializeSB1Info(SIB1);
+}
+auto decodeSib1(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeSB1Info(p);
+}
+
+QByteArray encodeRachPreamble(const ISerializer& s)
+{
+    return s.serializeRachPreamble(RACH_PREAMBLE.ra_rnti);
+}
+auto decodeRachPreamble(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRachPreamble(p);
+}
+
+QByteArray encodeRar(const ISerializer& s)
+{
+    return s.serializeRar(RAR);
+}
+auto decodeRar(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRar(p);
+}
+
+QByteArray encodeRrcSetupRequest(const ISerializer& s)
+{
+    return s.serializeRrcSetupRequest(RRC_SETUP_REQUEST);
+}
+auto decodeRrcSetupRequest(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRrcSetupRequest(p);
+}
+
+QByteArray encodeRrcSetup(const ISerializer& s)
+{
+    return s.serializeRrcSetup(RRC_SETUP);
+}
+auto decodeRrcSetup(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRrcSetup(p);
+}
+
+QByteArray encodeRrcSetupComplete(const ISerializer& s)
+{
+    return s.serializeRrcSetupComplete(RRC_SETUP_COMPLETE);
+}
+auto decodeRrcSetupComplete(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRrcSetupComplete(p);
+}
+
+QByteArray encodeRrcRelease(const ISerializer& s)
+{
+    return s.serializeRrcRelease(RRC_RELEASE);
+}
+auto decodeRrcRelease(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRrcRelease(p);
+}
+
+QByteArray encodeRegistrationRequest(const ISerializer& s)
+{
+    return s.serializeRegistrationRequest(REGISTRATION_REQUEST);
+}
+auto decodeRegistrationRequest(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRegistrationRequest(p);
+}
+
+QByteArray encodeRegistrationAnswer(const ISerializer& s)
+{
+    return s.serializeRegistrationAnswer(REGISTRATION_ANSWER);
+}
+auto decodeRegistrationAnswer(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRegistrationAnswer(p);
+}
+
+QByteArray encodeMeasurementReport(const ISerializer& s)
+{
+    return s.serializeMeasurementReport(MEASUREMENT_REPORT);
+}
+auto decodeMeasurementReport(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeMeasurementReport(p);
+}
+
+QByteArray encodeHandover(const ISerializer& s)
+{
+    return s.serializeTriggerHandover(HANDOVER);
+}
+auto decodeHandover(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeTriggerHandover(p);
+}
+
+// The UE side of a handover command.
+auto decodeRrcReconfiguration(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeRrcReconfiguration(p);
+}
+
+QByteArray encodeChatMessage(const ISerializer& s)
+{
+    return s.serializeChatMessage(CHAT_MESSAGE);
+}
+auto decodeChatMessage(const ISerializer& s, const QByteArray& p)
+{
+    return s.deserializeChatMessage(p);
+}
+
+QByteArray encodeGnbRegistration(const ISerializer& s)
+{
+    return s.serializeRegistrationPayload(GNB_REGISTRATION);
+}
+
+}  // namespace
+
+#define CODEC_BENCHMARKS(name)                                           \
+    BENCHMARK_CAPTURE(BM_Encode, name, &encode##name)->DenseRange(0, 2); \
+    BENCHMARK_CAPTURE(BM_Decode, name, &encode##name, &decode##name)     \
+        ->DenseRange(0, 2)
+
+CODEC_BENCHMARKS(Sib1);
+CODEC_BENCHMARKS(RachPreamble);
+CODEC_BENCHMARKS(Rar);
+CODEC_BENCHMARKS(RrcSetupRequest);
+CODEC_BENCHMARKS(RrcSetup);
+CODEC_BENCHMARKS(RrcSetupComplete);
+CODEC_BENCHMARKS(RrcRelease);
+CODEC_BENCHMARKS(RegistrationRequest);
+CODEC_BENCHMARKS(RegistrationAnswer);
+CODEC_BENCHMARKS(MeasurementReport);
+CODEC_BENCHMARKS(Handover);
+CODEC_BENCHMARKS(ChatMessage);
+BENCHMARK_CAPTURE(BM_Decode, RrcReconfiguration, &encodeHandover,
+                  &decodeRrcReconfiguration)
+    ->DenseRange(0, 2);
+BENCHMARK_CAPTURE(BM_Encode, GnbRegistration, &encodeGnbRegistration)
+    ->DenseRange(0, 2);
+
+#define MESSAGE_CODEC_BENCHMARKS(name, message)              \
+    BENCHMARK_CAPTURE(BM_MessageCodecEncode, name, message); \
+    BENCHMARK_CAPTURE(BM_MessageCodecDecode, name, message)
+
+MESSAGE_CODEC_BENCHMARKS(Sib1, SIB1);
+MESSAGE_CODEC_BENCHMARKS(RachPreamble, RACH_PREAMBLE);
+MESSAGE_CODEC_BENCHMARKS(Rar, RAR);
+MESSAGE_CODEC_BENCHMARKS(RrcSetupRequest, RRC_SETUP_REQUEST);
+MESSAGE_CODEC_BENCHMARKS(RrcSetup, RRC_SETUP);
+MESSAGE_CODEC_BENCHMARKS(RrcSetupComplete, RRC_SETUP_COMPLETE);
+MESSAGE_CODEC_BENCHMARKS(RrcRelease, RRC_RELEASE);
+MESSAGE_CODEC_BENCHMARKS(RegistrationRequest, REGISTRATION_REQUEST);
+MESSAGE_CODEC_BENCHMARKS(RegistrationAnswer, REGISTRATION_ANSWER);
+MESSAGE_CODEC_BENCHMARKS(MeasurementReport, MEASUREMENT_REPORT);
+MESSAGE_CODEC_BENCHMARKS(Handover, HANDOVER);
+MESSAGE_CODEC_BENCHMARKS(ChatMessage, CHAT_MESSAGE);
+MESSAGE_CODEC_BENCHMARKS(GnbRegistration, GNB_REGISTRATION);
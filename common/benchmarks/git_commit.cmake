@@ -0,0 +1,39 @@
+# Run at build time (cmake -P) so the commit is current on every build,
+# not only when CMake reconfigures.
+#   OUTPUT:    header defining BENCHMARK_GIT_COMMIT; rewritten only when
+#              the commit changed, so an unchanged tree rebuilds nothing.
+#   BENCHMARK: optional benchmark binary to run, writing
+#              <OUT_PREFIX>_<commit>.json for tools/compare.py.
+execute_process(
+    COMMAND git rev-parse --short HEAD
+    WORKING_DIRECTORY "${SOURCE_DIR}"
+    OUTPUT_VARIABLE commit
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+)
+if(NOT commit)
+    set(commit "unknown")
+endif()
+
+if(OUTPUT)
+    set(content "#define BENCHMARK_GIT_COMMIT \"${commit}\"\n")
+    set(current "")
+    if(EXISTS "${OUTPUT}")
+        file(READ "${OUTPUT}" current)
+    endif()
+    if(NOT current STREQUAL content)
+        file(WRITE "${OUTPUT}" "${content}")
+    endif()
+endif()
+
+if(BENCHMARK)
+    execute_process(
+        COMMAND "${BENCHMARK}"
+            --benchmark_out=${OUT_PREFIX}_${commit}.json
+            --benchmark_out_format=json
+        RESULT_VARIABLE result
+    )
+    if(result)
+        message(FATAL_ERROR "${BENCHMARK} failed: ${result}")
+    endif()
+endif()
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <QByteArray>
+#include <QPointF>
+
+#include "alloc_counter.hpp"
+#include "message_fields.hpp"
+#include "packet_pool.hpp"
+#include "sim_protocol.hpp"
+
+// SimProtocol header cost; the argument is the payload size in bytes.
+
+namespace {
+
+constexpr uint32_t SRC_ID = 501;
+constexpr uint32_t DST_ID = 101;
+const QPointF POSITION{1250.5, -730.25};
+
+QByteArray makePacket(int payload_size)
+{
+    return SimProtocol::buildDataPacket(
+        SRC_ID, EntityType::UE, DST_ID, POSITION,
+        ProtocolMsgType::MeasurementReport, QByteArray(payload_size, 'x'));
+}
+
+void BM_BuildPacket(benchmark::State& state)
+{
+    const QByteArray payload(static_cast<int>(state.range(0)), 'x');
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            QByteArray packet = SimProtocol::buildPacket(
+                SRC_ID, EntityType::UE, DST_ID, SimMessageType::Data,
+                POSITION, payload);
+            benchmark::DoNotOptimize(packet.constData());
+        }
+    }
+    state.counters["wire_bytes"] = SimProtocol::HEADER_SIZE + payload.size();
+}
+
+void BM_BuildDataPacket(benchmark::State& state)
+{
+    const QByteArray payload(static_cast<int>(state.range(0)), 'x');
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            QByteArray packet = SimProtocol::buildDataPacket(
+                SRC_ID, EntityType::UE, DST_ID, POSITION,
+                ProtocolMsgType::MeasurementReport, payload);
+            benchmark::DoNotOptimize(packet.constData());
+        }
+    }
+    state.counters["wire_bytes"] =
+        SimProtocol::PROTOCOL_TYPE_OFFSET + 1 + payload.size();
+}
+
+// One outgoing message as BaseEntity::sendSimData builds it: payload
+// encoding plus the Data datagram. Allocation-free once the pool is warm.
+void BM_MessageToPacket(benchmark::State& state)
+{
+    const MeasurementReportInfo report{102, -87.5};
+    const uint64_t misses_before = PacketPool::local().misses();
+    QByteArray packet;
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            packet = SimProtocol::buildDataPacket(
+                SRC_ID, EntityType::UE, DST_ID, POSITION,
+                ProtocolMsgType::MeasurementReport,
+                MessageCodec::encode(report));
+            benchmark::DoNotOptimize(packet.constData());
+        }
+    }
+    state.counters["pool_misses"] =
+        static_cast<double>(PacketPool::local().misses() - misses_before);
+    state.counters["wire_bytes"] = packet.size();
+}
+
+// Owning parse, as used by the RadioHub.
+void BM_Parse(benchmark::State& state)
+{
+    const QByteArray packet = makePacket(static_cast<int>(state.range(0)));
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            SimProtocol::DecodedPacket decoded = SimProtocol::parse(packet);
+            benchmark::DoNotOptimize(decoded);
+        }
+    }
+    state.counters["wire_bytes"] = packet.size();
+}
+
+// Zero-copy view, as used by BaseEntity.
+void BM_View(benchmark::State& state)
+{
+    const QByteArray packet = makePacket(static_cast<int>(state.range(0)));
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            const SimProtocol::PacketView view = SimProtocol::view(packet);
+            QByteArray payload = view.protocolPayload();
+            benchmark::DoNotOptimize(payload.constData());
+        }
+    }
+    state.counters["wire_bytes"] = packet.size();
+}
+
+void BM_PeekHeader(benchmark::State& state)
+{
+    const QByteArray packet = makePacket(0);
+    {
+        AllocScope allocs(state);
+        for (auto _ : state) {
+            SimProtocol::HeaderView header = SimProtocol::peekHeader(packet);
+            benchmark::DoNotOptimize(header);
+        }
+    }
+    state.counters["wire_bytes"] = SimProtocol::HEADER_SIZE;
+}
+
+}  // namespace
+
+BENCHMARK(BM_BuildPacket)->Arg(0)->Arg(64)->Arg(512);
+BENCHMARK(BM_BuildDataPacket)->Arg(0)->Arg(64)->Arg(512);
+BENCHMARK(BM_MessageToPacket);
+BENCHMARK(BM_Parse)->Arg(0)->Arg(64)->Arg(512);
+BENCHMARK(BM_View)->Arg(0)->Arg(64)->Arg(512);
+BENCHMARK(BM_PeekHeader);
@@ -1,16 +1,22 @@
 #ifndef BASE_ENTITY_HPP
 #define BASE_ENTITY_HPP
 
+#include <functional>
+
 #include <QDebug>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QPoint>
+#include <QTimer>
 #include <QUdpSocket>
 
 #include "iserializer.hpp"
 #include "network_node.hpp"
 #include "settings.hpp"
+#include "shm_channel.hpp"
+#include "sim_protocol.hpp"
+#include "timer_scheduler.hpp"
 #include "types.hpp"
 #include "udp_transport.hpp"
 
@@ -25,8 +31,25 @@ public:
     void stop();
     virtual void run() = 0;
     bool setupNetwork(quint16 port);
+    /**
+     * @brief Sends through transport, owned by a host process, instead of
+     * a socket of its own. The host passes received datagrams on to
+     * handleIncomingRawData.
+     */
+    void attachTransport(UdpTransport* transport);
+    using Registrar = std::function<void(
+        uint32_t id, const QHostAddress& hub_address, quint16 hub_port)>;
+    /**
+     * @brief Has registerAtHub() hand the node to registrar instead of
+     * sending a Registration of its own, so that a host re-registers its
+     * nodes in RegistrationBatch datagrams, as sharing its endpoint.
+     */
+    void setRegistrar(Registrar registrar);
     void registerAtHub();
     void handleRegistrationResponse(QDataStream& ds);
+    void handleHubRedirect(const QByteArray& payload);
+    void handleShmAttach(const QByteArray& payload);
+    void handleHeartbeat(const QByteArray& payload);
 
     uint32_t getId() const override;
     EntityType getType() const override;
@@ -46,6 +69,15 @@ protected:
     virtual void sendSimData(ProtocolMsgType protoType,
                              const QByteArray& payload, uint32_t targetId);
     virtual QByteArray getRegistrationPayload() const;
+    void requestShmChannel();
+    void startHeartbeat();
+    void sendHeartbeat();
+    virtual sendingResult sendToHub(const QByteArray& packet);
+    void sendDataPacket(ProtocolMsgType proto_type, const QByteArray& payload,
+                        uint32_t target_id);
+    void queuePdu(ProtocolMsgType proto_type, const QByteArray& payload,
+                  uint32_t target_id);
+    void flushBundle();
 
     uint32_t id_;
     EntityType type_;
@@ -53,15 +85,43 @@ protected:
     quint16 port_;
 
     UdpTransport* transport_ = nullptr;
+    Registrar registrar_;
     HubSettings hub_set_;
+    // hub_set_.address, parsed once instead of on every send.
+    QHostAddress hub_address_;
     bool is_registered_;
+    // Set up after registration when the hub shares this host.
+    std::unique_ptr<ShmChannel> shm_channel_;
+    bool is_shm_active_ = false;
+    // Keeps the registration alive when the hub expires silent nodes.
+    Deadline heartbeat_deadline_;
+
+    // Protocol messages sent this event loop pass, flushed as one Bundle.
+    struct PendingPdu {
+        uint32_t target_id;
+        ProtocolMsgType type;
+        QByteArray payload;
+    };
+    std::vector<PendingPdu> pending_pdus_;
+    int pending_bytes_ = 0;  // size of the Bundle carrying pending_pdus_
+    std::vector<PendingPdu> flushing_pdus_;  // swapped in by flushes
+    std::vector<SimProtocol::BundlePdu> bundle_pdus_;  // reused by flushes
 
     double tx_power_dbm_;
     std::unique_ptr<ISerializer> serializer_;
 
+    // payload is only valid during the call; copy it to keep it.
     virtual void onProtocolMessageReceived(uint32_t source_id,
                                            ProtocolMsgType type,
                                            const QByteArray& payload) = 0;
+    // SINR of UEs towards this node as computed by the hub's interference
+    // engine. Ignored by default.
+    virtual void onSinrReport(
+        const std::vector<SimProtocol::SinrSample>& samples);
+    // RSRP of every gNB this node can hear, from the hub's link budget.
+    // Only sent when the hub runs a path loss model. Ignored by default.
+    virtual void onRsrpReport(
+        const std::vector<SimProtocol::RsrpSample>& samples);
 
 public slots:
     void handleIncomingRawData(const QByteArray& data, const QHostAddress& addr,
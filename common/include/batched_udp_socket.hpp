@@ -0,0 +1,89 @@
+#ifndef BATCHED_UDP_SOCKET_HPP
+#define BATCHED_UDP_SOCKET_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QObject>
+
+#ifdef Q_OS_LINUX
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+class QSocketNotifier;
+
+/**
+ * @brief Linux batched datagram backend for UdpTransport.
+ * Receives with recvmmsg into a preallocated buffer ring and queues sends,
+ * which are flushed with sendmmsg once per event-loop turn. A send that
+ * fails at flush time, or draws an ICMP error later (IP_RECVERR), is
+ * reported through sendFailed().
+ * On other platforms bind() fails and UdpTransport keeps the QUdpSocket path.
+ */
+class BatchedUdpSocket : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr size_t BATCH_SIZE = 32;
+    // Largest IPv4 UDP payload (65507 bytes), rounded up.
+    static constexpr size_t SLOT_SIZE = 65536;
+
+    explicit BatchedUdpSocket(QObject* parent = nullptr);
+    ~BatchedUdpSocket();
+
+    bool bind(quint16 listen_port, bool reuse_port);
+    bool queue(const QByteArray& data, const QHostAddress& receiver_ip,
+               quint16 receiver_port);
+    void flush();
+
+    quint16 localPort() const;
+    uint64_t sendErrors() const;
+    uint64_t truncatedDatagrams() const;
+    // Totals of every batched socket of the process.
+    static uint64_t totalSendErrors();
+    static uint64_t totalTruncatedDatagrams();
+
+signals:
+    void datagramReceived(const QByteArray& data, const QHostAddress& addr,
+                          quint16 port);
+    void sendFailed(const QHostAddress& addr, quint16 port);
+
+private:
+    void readPendingDatagrams();
+    void drainErrorQueue();
+    void scheduleFlush();
+
+    int fd_ = -1;
+    QSocketNotifier* read_notifier_ = nullptr;
+    QSocketNotifier* write_notifier_ = nullptr;
+    bool flush_scheduled_ = false;
+    uint64_t send_errors_ = 0;
+    uint64_t truncated_ = 0;
+
+#ifdef Q_OS_LINUX
+    struct PendingSend {
+        QByteArray data;
+        sockaddr_in addr;
+    };
+
+    // Left uninitialized: pages are only committed once datagrams land in
+    // them, so full-size slots cost address space, not memory.
+    std::unique_ptr<char[]> rx_ring_;
+    std::array<mmsghdr, BATCH_SIZE> rx_msgs_{};
+    std::array<iovec, BATCH_SIZE> rx_iovs_{};
+    std::array<sockaddr_in, BATCH_SIZE> rx_addrs_{};
+
+    std::vector<PendingSend> tx_queue_;
+    size_t tx_head_ = 0;
+    std::array<mmsghdr, BATCH_SIZE> tx_msgs_{};
+    std::array<iovec, BATCH_SIZE> tx_iovs_{};
+#endif
+};
+
+#endif  // BATCHED_UDP_SOCKET_HPP
@@ -24,6 +24,10 @@ public:
     HubSettings getHubSettings() const;
     std::optional<GnbRuntimeContext> getGnbContext() const;
     std::optional<UeRuntimeContext> getUeContext() const;
+    // Set when the process was started with --count.
+    std::optional<HostRange> getHostRange() const;
+    std::optional<UeHostContext> getUeHostContext() const;
+    std::optional<GnbHostContext> getGnbHostContext() const;
 
     bool load(const std::string& filename);
     const SimulationSettings& getSimulationSettings() const;
@@ -36,12 +40,27 @@ private:
     ConfigManager() = default;
 
     uint32_t node_id_;
+    std::optional<HostRange> host_range_;
     EntityType node_type_;
     std::optional<SettingsPack> pack_;
 
     HubSettings parseHub(const YAML::Node& node);
+    PathLossModel parsePathLossModel(const std::string& name);
+    PayloadCodec parsePayloadCodec(const std::string& name);
+    LinkProfile parseLinkProfile(const YAML::Node& node);
+    LinkImpairmentSettings parseLinkImpairment(const YAML::Node& node);
+    InterferenceSettings parseInterference(const YAML::Node& node);
+    LivenessSettings parseLiveness(const YAML::Node& node);
+    CaptureSettings parseCapture(const YAML::Node& node);
+    TrafficRecordingSettings parseRecording(const YAML::Node& node);
+    MetricsSettings parseMetrics(const YAML::Node& node);
+    FederationSettings parseFederation(const YAML::Node& node);
+    ShmTransportSettings parseShmTransport(const YAML::Node& node);
+    BundlingSettings parseBundling(const YAML::Node& node);
     UeSettings parseUe(const YAML::Node& node, const HubSettings hub_set);
+    UeHostSettings parseUeHost(const YAML::Node& node);
     GnbSettings parseGnb(const YAML::Node& root, const HubSettings hub_set);
+    GnbHostSettings parseGnbHost(const YAML::Node& node);
     SimulationSettings parseSimulation(const YAML::Node& node);
     Positions parsePositions(const YAML::Node& node);
     Paths parsePaths(const YAML::Node& node);
@@ -0,0 +1,52 @@
+#ifndef IN_PROCESS_BUS_HPP
+#define IN_PROCESS_BUS_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include <QByteArray>
+#include <QMutex>
+
+class UdpTransport;
+
+/**
+ * @brief Process-wide switchboard for UdpBackend::InProcess transports.
+ * Transports bind virtual ports here instead of sockets; a send hands the
+ * implicitly shared QByteArray to the receiver's thread as a queued call,
+ * so the payload is never copied. All ports live on 127.0.0.1.
+ * Several transports may share a port with reuse_port, like SO_REUSEPORT:
+ * the sender port picks one, so a sender always reaches the same receiver.
+ */
+class InProcessBus
+{
+public:
+    static constexpr quint16 FIRST_EPHEMERAL_PORT = 49152;
+
+    static InProcessBus& instance();
+
+    /**
+     * @brief Returns the bound port (an ephemeral one for port 0),
+     * or 0 when the port is taken.
+     */
+    quint16 bind(UdpTransport* transport, quint16 port, bool reuse_port);
+    void unbind(UdpTransport* transport);
+
+    bool deliver(const QByteArray& data, quint16 sender_port,
+                 quint16 receiver_port);
+
+private:
+    InProcessBus() = default;
+
+    struct Endpoint {
+        std::vector<UdpTransport*> transports;
+        bool is_shared = false;
+    };
+
+    quint16 nextEphemeralPort();
+
+    QMutex mutex_;
+    std::unordered_map<quint16, Endpoint> endpoints_;
+    quint16 next_ephemeral_ = FIRST_EPHEMERAL_PORT;
+};
+
+#endif  // IN_PROCESS_BUS_HPP
@@ -1,8 +1,11 @@
 #ifndef ISERIALIZER_HPP
 #define ISERIALIZER_HPP
 
+#include <memory>
+
 #include <QByteArray>
 
+#include "settings.hpp"
 #include "types.hpp"
 
 class ISerializer
@@ -65,7 +68,7 @@ public:
         const QByteArray& payload) const = 0;
 
     virtual QByteArray serializeRegistrationPayload(
-        const double radius) const = 0;
+        const GnbRegistrationInfo& info) const = 0;
 
     virtual QByteArray serializeTriggerHandover(
         const HandoverInfo info) const = 0;
@@ -73,4 +76,6 @@ public:
         const QByteArray& payload) const = 0;
 };
 
+std::unique_ptr<ISerializer> makeSerializer(PayloadCodec codec);
+
 #endif  // ISERIALIZER_HPP
@@ -0,0 +1,428 @@
+#ifndef MESSAGE_CODEC_HPP
+#define MESSAGE_CODEC_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <QByteArray>
+#include <QString>
+#include <QtEndian>
+
+#include "packet_pool.hpp"
+
+/**
+ * @brief Encoders and decoders generated from field descriptors.
+ *
+ * A message opts in by specializing MessageCodec::Message<T> with a
+ * Fields<...> list naming its members in wire order. encode() and
+ * decode() are plain templates: no virtual calls, no QDataStream.
+ * Messages whose fields are all fixed-width get a compile-time SIZE,
+ * are encoded into one exactly sized buffer and decoded after a single
+ * length check. Encoded messages live in PacketPool buffers.
+ *
+ * The wire layout is the one QDataStream (big-endian, double precision)
+ * writes for the same fields: integers and enums at their own width,
+ * doubles as IEEE 754, QString as a u32 byte length (0xFFFFFFFF for a
+ * null string) followed by UTF-16.
+ */
+namespace MessageCodec {
+
+// Member in wire order; the encoding follows from the member type.
+template <auto Member>
+struct Field {};
+
+// Vector preceded by its element count, which lives in member Count.
+template <auto Count, auto Items>
+struct CountedField {};
+
+template <typename... F>
+struct Fields {};
+
+// Specialize with `using fields = Fields<...>;` to describe a message.
+template <typename T>
+struct Message;
+
+namespace detail {
+
+template <typename T, typename = void>
+struct IsDescribed : std::false_type {};
+
+template <typename T>
+struct IsDescribed<T, std::void_t<typename Message<T>::fields>>
+    : std::true_type {};
+
+template <typename M>
+struct MemberOf;
+
+template <typename C, typename V>
+struct MemberOf<V C::*> {
+    using Class = C;
+    using Value = V;
+};
+
+template <auto Member>
+using MemberValue = typename MemberOf<decltype(Member)>::Value;
+
+/**
+ * @brief Cursor over an encoded buffer. CHECKED readers test every read
+ * against the end; fixed-size messages check the length once up front
+ * and read unchecked.
+ */
+template <bool CHECKED>
+struct Reader {
+    const char* pos;
+    const char* end;
+    bool ok = true;
+
+    bool take(size_t size)
+    {
+        if constexpr (CHECKED) {
+            if (!ok || static_cast<size_t>(end - pos) < size) {
+                ok = false;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool atEnd() const
+    {
+        return pos == end;
+    }
+};
+
+template <typename V, typename = void>
+struct ValueCodec;
+
+// Integers and enums at their own width, big-endian.
+template <typename V>
+struct ValueCodec<
+    V, std::enable_if_t<std::is_integral_v<V> || std::is_enum_v<V>>> {
+    using Wire = typename QIntegerForSizeof<V>::Unsigned;
+
+    static constexpr bool FIXED = true;
+    static constexpr size_t SIZE = sizeof(V);
+
+    static size_t size(const V&)
+    {
+        return SIZE;
+    }
+
+    static void write(char*& out, const V& value)
+    {
+        qToBigEndian<Wire>(static_cast<Wire>(value), out);
+        out += SIZE;
+    }
+
+    template <bool CHECKED>
+    static void read(Reader<CHECKED>& in, V& value)
+    {
+        if (!in.take(SIZE)) {
+            return;
+        }
+        value = static_cast<V>(qFromBigEndian<Wire>(in.pos));
+        in.pos += SIZE;
+    }
+};
+
+template <>
+struct ValueCodec<double> {
+    static constexpr bool FIXED = true;
+    static constexpr size_t SIZE = sizeof(double);
+
+    static size_t size(const double&)
+    {
+        return SIZE;
+    }
+
+    static void write(char*& out, const double& value)
+    {
+        quint64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        qToBigEndian<quint64>(bits, out);
+        out += SIZE;
+    }
+
+    template <bool CHECKED>
+    static void read(Reader<CHECKED>& in, double& value)
+    {
+        if (!in.take(SIZE)) {
+            return;
+        }
+        const quint64 bits = qFromBigEndian<quint64>(in.pos);
+        std::memcpy(&value, &bits, sizeof(value));
+        in.pos += SIZE;
+    }
+};
+
+template <>
+struct ValueCodec<QString> {
+    static constexpr bool FIXED = false;
+    static constexpr quint32 NULL_STRING = 0xFFFFFFFF;
+
+    static size_t size(const QString& value)
+    {
+        return sizeof(quint32) + 2 * static_cast<size_t>(value.size());
+    }
+
+    static void write(char*& out, const QString& value)
+    {
+        if (value.isNull()) {
+            qToBigEndian<quint32>(NULL_STRING, out);
+            out += sizeof(quint32);
+            return;
+        }
+        const auto length = static_cast<quint32>(value.size());
+        qToBigEndian<quint32>(2 * length, out);
+        out += sizeof(quint32);
+        const QChar* chars = value.constData();
+        for (quint32 i = 0; i < length; ++i) {
+            qToBigEndian<quint16>(chars[i].unicode(), out);
+            out += sizeof(char16_t);
+        }
+    }
+
+    template <bool CHECKED>
+    static void read(Reader<CHECKED>& in, QString& value)
+    {
+        if (!in.take(sizeof(quint32))) {
+            return;
+        }
+        const quint32 bytes = qFromBigEndian<quint32>(in.pos);
+        in.pos += sizeof(quint32);
+        if (bytes == NULL_STRING) {
+            value = QString();
+            return;
+        }
+        if (bytes % 2 != 0) {
+            in.ok = false;
+            return;
+        }
+        if (!in.take(bytes)) {
+            return;
+        }
+        value.resize(static_cast<qsizetype>(bytes / 2));
+        QChar* chars = value.data();
+        for (quint32 i = 0; i < bytes / 2; ++i) {
+            chars[i] = QChar(qFromBigEndian<quint16>(in.pos));
+            in.pos += sizeof(char16_t);
+        }
+    }
+};
+
+// Trailing optional: written when set, read when bytes are left.
+template <typename V>
+struct ValueCodec<std::optional<V>> {
+    static constexpr bool FIXED = false;
+
+    static size_t size(const std::optional<V>& value)
+    {
+        return value.has_value() ? ValueCodec<V>::size(*value) : 0;
+    }
+
+    static void write(char*& out, const std::optional<V>& value)
+    {
+        if (value.has_value()) {
+            ValueCodec<V>::write(out, *value);
+        }
+    }
+
+    template <bool CHECKED>
+    static void read(Reader<CHECKED>& in, std::optional<V>& value)
+    {
+        if (in.atEnd()) {
+            value.reset();
+            return;
+        }
+        value.emplace();
+        ValueCodec<V>::read(in, *value);
+    }
+};
+
+template <typename F>
+struct FieldCodec;
+
+template <typename T, typename L = typename Message<T>::fields>
+struct MessageLayout;
+
+// Nested described structs are written field by field.
+template <typename V>
+struct ValueCodec<V, std::enable_if_t<IsDescribed<V>::value>>
+    : MessageLayout<V> {};
+
+template <auto Member>
+struct FieldCodec<Field<Member>> {
+    using Codec = ValueCodec<MemberValue<Member>>;
+    using Owner = typename MemberOf<decltype(Member)>::Class;
+
+    static constexpr bool FIXED = Codec::FIXED;
+
+    static constexpr size_t fixedSize()
+    {
+        if constexpr (FIXED) {
+            return Codec::SIZE;
+        } else {
+            return 0;
+        }
+    }
+
+    static size_t size(const Owner& message)
+    {
+        return Codec::size(message.*Member);
+    }
+
+    static void write(char*& out, const Owner& message)
+    {
+        Codec::write(out, message.*Member);
+    }
+
+    template <bool CHECKED>
+    static void read(Reader<CHECKED>& in, Owner& message)
+    {
+        Codec::read(in, message.*Member);
+    }
+};
+
+template <auto Count, auto Items>
+struct FieldCodec<CountedField<Count, Items>> {
+    using CountType = MemberValue<Count>;
+    using Item = typename MemberValue<Items>::value_type;
+    using Owner = typename MemberOf<decltype(Count)>::Class;
+
+    static constexpr bool FIXED = false;
+
+    static constexpr size_t fixedSize()
+    {
+        return 0;
+    }
+
+    static size_t count(const Owner& message)
+    {
+        return std::min<size_t>((message.*Items).size(),
+                                std::numeric_limits<CountType>::max());
+    }
+
+    static size_t size(const Owner& message)
+    {
+        size_t total = sizeof(CountType);
+        const size_t items = count(message);
+        for (size_t i = 0; i < items; ++i) {
+            total += ValueCodec<Item>::size((message.*Items)[i]);
+        }
+        return total;
+    }
+
+    static void write(char*& out, const Owner& message)
+    {
+        const size_t items = count(message);
+        ValueCodec<CountType>::write(out, static_cast<CountType>(items));
+        for (size_t i = 0; i < items; ++i) {
+            ValueCodec<Item>::write(out, (message.*Items)[i]);
+        }
+    }
+
+    template <bool CHECKED>
+    static void read(Reader<CHECKED>& in, Owner& message)
+    {
+        CountType items{};
+        ValueCodec<CountType>::read(in, items);
+        message.*Count = items;
+
+        auto& list = message.*Items;
+        list.clear();
+        list.reserve(items);
+        for (CountType i = 0; i < items && in.ok; ++i) {
+            Item item{};
+            ValueCodec<Item>::read(in, item);
+            list.push_back(item);
+        }
+    }
+};
+
+template <typename T, typename... F>
+struct MessageLayout<T, Fields<F...>> {
+    static constexpr bool FIXED = (FieldCodec<F>::FIXED && ...);
+    static constexpr size_t SIZE = (FieldCodec<F>::fixedSize() + ... + 0);
+
+    static size_t size(const T& message)
+    {
+        if constexpr (FIXED) {
+            return SIZE;
+        } else {
+            return (FieldCodec<F>::size(message) + ... + 0);
+        }
+    }
+
+    static void write(char*& out, const T& message)
+    {
+        (FieldCodec<F>::write(out, message), ...);
+    }
+
+    template <bool CHECKED>
+    static void read(Reader<CHECKED>& in, T& message)
+    {
+        (FieldCodec<F>::read(in, message), ...);
+    }
+};
+
+}  // namespace detail
+
+// T is a described message or a single value (integer, enum, QString).
+template <typename T>
+inline constexpr bool IS_FIXED_SIZE = detail::ValueCodec<T>::FIXED;
+
+// Encoded size of a fixed-size T.
+template <typename T>
+inline constexpr size_t FIXED_SIZE = detail::ValueCodec<T>::SIZE;
+
+template <typename T>
+QByteArray encode(const T& message)
+{
+    using Layout = detail::ValueCodec<T>;
+
+    QByteArray& out =
+        PacketPool::local().acquire(static_cast<int>(Layout::size(message)));
+    char* pos = out.data();
+    Layout::write(pos, message);
+    return out;
+}
+
+/**
+ * @brief Decodes a T from the start of data; trailing bytes are ignored
+ * unless T ends in an optional field.
+ */
+template <typename T>
+std::optional<T> decode(const char* data, size_t size)
+{
+    using Layout = detail::ValueCodec<T>;
+
+    T message{};
+    if constexpr (Layout::FIXED) {
+        if (size < Layout::SIZE) {
+            return std::nullopt;
+        }
+        detail::Reader<false> in{data, data + size};
+        Layout::read(in, message);
+        return message;
+    } else {
+        detail::Reader<true> in{data, data + size};
+        Layout::read(in, message);
+        return in.ok ? std::optional<T>(std::move(message)) : std::nullopt;
+    }
+}
+
+template <typename T>
+std::optional<T> decode(const QByteArray& data)
+{
+    return decode<T>(data.constData(), static_cast<size_t>(data.size()));
+}
+
+}  // namespace MessageCodec
+
+#endif  // MESSAGE_CODEC_HPP
@@ -0,0 +1,113 @@
+#ifndef MESSAGE_FIELDS_HPP
+#define MESSAGE_FIELDS_HPP
+
+#include "message_codec.hpp"
+#include "types.hpp"
+
+/**
+ * @brief Wire fields of the gNB <-> UE messages, in wire order.
+ * Adding a field here changes both its encoder and its decoder.
+ */
+namespace MessageCodec {
+
+template <>
+struct Message<PlmnIdentity> {
+    using fields =
+        Fields<Field<&PlmnIdentity::mcc>, Field<&PlmnIdentity::mnc>>;
+};
+
+template <>
+struct Message<RachPreambleInfo> {
+    using fields = Fields<Field<&RachPreambleInfo::ra_rnti>>;
+};
+
+template <>
+struct Message<RarInfo> {
+    using fields =
+        Fields<Field<&RarInfo::ra_rnti>, Field<&RarInfo::temp_c_rnti>,
+               Field<&RarInfo::timing_advance>>;
+};
+
+template <>
+struct Message<RrcSetupRequest> {
+    using fields = Fields<Field<&RrcSetupRequest::ue_identity>,
+                          Field<&RrcSetupRequest::cause>>;
+};
+
+template <>
+struct Message<RrcSetupInfo> {
+    using fields = Fields<Field<&RrcSetupInfo::received_identity>,
+                          Field<&RrcSetupInfo::config_status>>;
+};
+
+template <>
+struct Message<RrcSetupCompleteInfo> {
+    using fields = Fields<Field<&RrcSetupCompleteInfo::plmn>>;
+};
+
+template <>
+struct Message<RegistrationRequestInfo> {
+    using fields = Fields<Field<&RegistrationRequestInfo::ue_id>,
+                          Field<&RegistrationRequestInfo::ue_cap>>;
+};
+
+// reject_reason is only on the wire when set.
+template <>
+struct Message<RegistrationAnswerInfo> {
+    using fields = Fields<Field<&RegistrationAnswerInfo::status>,
+                          Field<&RegistrationAnswerInfo::reject_reason>>;
+};
+
+template <>
+struct Message<RrcReconfigurationInfo> {
+    using fields = Fields<Field<&RrcReconfigurationInfo::gnb_id>>;
+};
+
+template <>
+struct Message<HandoverInfo> {
+    using fields = Fields<Field<&HandoverInfo::gnb_id>>;
+};
+
+template <>
+struct Message<ChatMessageInfo> {
+    using fields = Fields<Field<&ChatMessageInfo::receiver_ue_id>,
+                          Field<&ChatMessageInfo::sender_ue_id>,
+                          Field<&ChatMessageInfo::text>>;
+};
+
+template <>
+struct Message<MeasurementReportInfo> {
+    using fields = Fields<Field<&MeasurementReportInfo::reported_gnb_id>,
+                          Field<&MeasurementReportInfo::rsrp>>;
+};
+
+template <>
+struct Message<GnbRegistrationInfo> {
+    using fields = Fields<Field<&GnbRegistrationInfo::radius>,
+                          Field<&GnbRegistrationInfo::tx_power_dbm>,
+                          Field<&GnbRegistrationInfo::min_rx_level>>;
+};
+
+// The SIB1 part of the cell config; txPowerDb is not broadcast.
+template <>
+struct Message<GnbCellConfig> {
+    using fields =
+        Fields<Field<&GnbCellConfig::tac>, Field<&GnbCellConfig::minRxLevel>,
+               CountedField<&GnbCellConfig::plmns_size,
+                            &GnbCellConfig::plmns>>;
+};
+
+template <>
+struct Message<SIB1Info> {
+    using fields =
+        Fields<Field<&SIB1Info::gnb_id>, Field<&SIB1Info::cell_config>>;
+};
+
+static_assert(IS_FIXED_SIZE<RarInfo> && FIXED_SIZE<RarInfo> == 6);
+static_assert(IS_FIXED_SIZE<MeasurementReportInfo> &&
+              FIXED_SIZE<MeasurementReportInfo> == 12);
+static_assert(!IS_FIXED_SIZE<SIB1Info>);
+
+}  // namespace MessageCodec
+
+#endif  // MESSAGE_FIELDS_HPP
@@ -2,6 +2,7 @@
 #define NETWORK_NODE_HPP
 
 #include <cstdint>
+#include <limits>
 
 #include <QHostAddress>
 #include <QPointF>
@@ -25,6 +26,8 @@ struct GnbData {
     static constexpr uint32_t INITIAL_UE_COUNT = 0;
     double radius = 0.0;
     uint32_t connected_ue_count = INITIAL_UE_COUNT;
+    double tx_power_dbm = 43.0;
+    double min_rx_level_dbm = -115.0;
 };
 
 struct UeData {
@@ -32,6 +35,8 @@ struct UeData {
     bool is_connected = false;
     QString state = "IDLE";
     uint32_t target_gnb = INITIAL_TARGET_GNB;
+    // Best SINR from the hub's interference engine, NaN when unknown.
+    double sinr_db = std::numeric_limits<double>::quiet_NaN();
 };
 
 struct GnbGuiSnapshot {
@@ -0,0 +1,59 @@
+#ifndef PACKET_POOL_HPP
+#define PACKET_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QByteArray>
+
+/**
+ * @brief Per-thread pool of reusable datagram buffers.
+ *
+ * The pool keeps its own reference to every buffer and hands out buffers
+ * nobody else shares. There is no explicit release: a buffer is free
+ * again once every copy of it (a send queue, an in-process receiver, the
+ * caller) is gone. Writing through the reference acquire() returns does
+ * not detach until it has been copied.
+ *
+ * A miss (every buffer busy, or more than BUFFER_SIZE bytes requested)
+ * allocates. The pool grows up to MAX_BUFFERS; misses beyond that return
+ * unpooled buffers. Once it covers the buffers in flight, acquire() does
+ * not allocate.
+ */
+class PacketPool
+{
+public:
+    // Room for a typical datagram; larger ones are unpooled misses.
+    static constexpr int BUFFER_SIZE = 2048;
+    static constexpr size_t MAX_BUFFERS = 256;
+
+    PacketPool();
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    // Pool of the calling thread.
+    static PacketPool& local();
+    // Misses of every thread's pool since start.
+    static uint64_t totalMisses();
+
+    /**
+     * @brief Returns a free buffer resized to size, contents unspecified.
+     * The reference is only valid until the next acquire() on this thread;
+     * copy the buffer to keep it.
+     */
+    QByteArray& acquire(int size);
+
+    uint64_t misses() const;
+    size_t bufferCount() const;
+
+private:
+    void recordMiss();
+
+    std::vector<QByteArray> buffers_;
+    size_t next_ = 0;
+    QByteArray unpooled_;
+    uint64_t misses_ = 0;
+};
+
+#endif  // PACKET_POOL_HPP
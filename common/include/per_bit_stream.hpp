@@ -0,0 +1,274 @@
+#ifndef PER_BIT_STREAM_HPP
+#define PER_BIT_STREAM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Variant of the packed encoding rules (X.691).
+ * Aligned pads to an octet boundary before octet strings, lengths and
+ * whole numbers whose range exceeds one octet; Unaligned never pads.
+ */
+enum class PerVariant : uint8_t {
+    Aligned = 0,
+    Unaligned = 1
+};
+
+namespace PerCodec {
+
+// Largest length a single-fragment length determinant can carry.
+inline constexpr size_t MAX_LENGTH = 16383;
+
+// Bits needed for the values 0..range-1 of a constrained whole number.
+inline constexpr uint32_t bitsForRange(uint64_t range)
+{
+    uint32_t bits = 0;
+    while (bits < 64 && (uint64_t{1} << bits) < range) {
+        ++bits;
+    }
+    return bits;
+}
+
+// Field width of a constrained whole number in the aligned variant:
+// bit-field up to one octet of range, whole octets above.
+inline constexpr uint32_t alignedBitsForRange(uint64_t range)
+{
+    return range <= 255 ? bitsForRange(range)
+                        : (bitsForRange(range) + 7) / 8 * 8;
+}
+
+}  // namespace PerCodec
+
+/**
+ * @brief MSB-first bit writer producing PER-style encodings.
+ */
+class PerBitWriter
+{
+public:
+    explicit PerBitWriter(PerVariant variant)
+        : variant_(variant)
+    {
+        bytes_.reserve(32);
+    }
+
+    void writeBits(uint64_t value, uint32_t count)
+    {
+        while (count > 0) {
+            if (bit_offset_ == 0) {
+                bytes_.push_back(0);
+            }
+            const uint32_t free_bits = 8 - bit_offset_;
+            const uint32_t take = std::min(free_bits, count);
+            const uint64_t chunk =
+                (value >> (count - take)) & ((uint64_t{1} << take) - 1);
+            bytes_.back() |=
+                static_cast<uint8_t>(chunk << (free_bits - take));
+            bit_offset_ = (bit_offset_ + take) % 8;
+            count -= take;
+        }
+    }
+
+    void writeBool(bool value)
+    {
+        writeBits(value ? 1 : 0, 1);
+    }
+
+    // Pads with zero bits to the next octet boundary.
+    void align()
+    {
+        bit_offset_ = 0;
+    }
+
+    /**
+     * @brief Constrained whole number lb..ub; values outside are clamped.
+     */
+    void writeConstrained(int64_t value, int64_t lb, int64_t ub)
+    {
+        value = std::clamp(value, lb, ub);
+        const uint64_t range = static_cast<uint64_t>(ub - lb) + 1;
+        writeBits(static_cast<uint64_t>(value - lb), fieldBits(range));
+    }
+
+    /**
+     * @brief Unconstrained length determinant: one octet below 128,
+     * two octets (10xxxxxx) up to PerCodec::MAX_LENGTH.
+     */
+    void writeLength(size_t length)
+    {
+        alignIfAligned();
+        length = std::min(length, PerCodec::MAX_LENGTH);
+        if (length < 128) {
+            writeBits(length, 8);
+        } else {
+            writeBits(0x8000 | length, 16);
+        }
+    }
+
+    // Length-prefixed octet string, truncated to PerCodec::MAX_LENGTH.
+    void writeOctetString(const char* data, size_t size)
+    {
+        size = std::min(size, PerCodec::MAX_LENGTH);
+        writeLength(size);
+        alignIfAligned();
+        if (bit_offset_ == 0) {
+            bytes_.insert(bytes_.end(), data, data + size);
+            return;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            writeBits(static_cast<uint8_t>(data[i]), 8);
+        }
+    }
+
+    const std::vector<uint8_t>& bytes() const
+    {
+        return bytes_;
+    }
+
+private:
+    uint32_t fieldBits(uint64_t range)
+    {
+        if (variant_ == PerVariant::Unaligned || range <= 255) {
+            return PerCodec::bitsForRange(range);
+        }
+        align();
+        return PerCodec::alignedBitsForRange(range);
+    }
+
+    void alignIfAligned()
+    {
+        if (variant_ == PerVariant::Aligned) {
+            align();
+        }
+    }
+
+    const PerVariant variant_;
+    std::vector<uint8_t> bytes_;
+    uint32_t bit_offset_ = 0;  // bits used in bytes_.back(), 0 = full
+};
+
+/**
+ * @brief Reader for PerBitWriter encodings. Reading past the end or a
+ * constrained value above its upper bound clears ok() for good; values
+ * read after that are 0.
+ */
+class PerBitReader
+{
+public:
+    PerBitReader(const uint8_t* data, size_t size, PerVariant variant)
+        : data_(data)
+        , size_bits_(size * 8)
+        , variant_(variant)
+    {
+    }
+
+    bool ok() const
+    {
+        return ok_;
+    }
+
+    uint64_t readBits(uint32_t count)
+    {
+        if (!ok_ || position_ + count > size_bits_) {
+            ok_ = false;
+            return 0;
+        }
+        uint64_t value = 0;
+        while (count > 0) {
+            const uint32_t bit_offset = position_ % 8;
+            const uint32_t available = 8 - bit_offset;
+            const uint32_t take = std::min(available, count);
+            const uint8_t byte = data_[position_ / 8];
+            const uint32_t chunk =
+                (byte >> (available - take)) & ((1u << take) - 1);
+            value = (value << take) | chunk;
+            position_ += take;
+            count -= take;
+        }
+        return value;
+    }
+
+    bool readBool()
+    {
+        return readBits(1) != 0;
+    }
+
+    void align()
+    {
+        position_ = (position_ + 7) / 8 * 8;
+    }
+
+    int64_t readConstrained(int64_t lb, int64_t ub)
+    {
+        const uint64_t range = static_cast<uint64_t>(ub - lb) + 1;
+        const uint64_t offset = readBits(fieldBits(range));
+        if (offset >= range) {
+            ok_ = false;
+            return lb;
+        }
+        return lb + static_cast<int64_t>(offset);
+    }
+
+    size_t readLength()
+    {
+        alignIfAligned();
+        const uint64_t first = readBits(8);
+        if ((first & 0x80) == 0) {
+            return first;
+        }
+        if ((first & 0x40) != 0) {
+            // Fragmented lengths are never written.
+            ok_ = false;
+            return 0;
+        }
+        return ((first & 0x3F) << 8) | readBits(8);
+    }
+
+    std::string readOctetString()
+    {
+        const size_t size = readLength();
+        alignIfAligned();
+        if (!ok_ || position_ + size * 8 > size_bits_) {
+            ok_ = false;
+            return std::string();
+        }
+        if (position_ % 8 == 0) {
+            const char* begin =
+                reinterpret_cast<const char*>(data_ + position_ / 8);
+            position_ += size * 8;
+            return std::string(begin, size);
+        }
+        std::string value(size, '\0');
+        for (char& c : value) {
+            c = static_cast<char>(readBits(8));
+        }
+        return value;
+    }
+
+private:
+    uint32_t fieldBits(uint64_t range)
+    {
+        if (variant_ == PerVariant::Unaligned || range <= 255) {
+            return PerCodec::bitsForRange(range);
+        }
+        align();
+        return PerCodec::alignedBitsForRange(range);
+    }
+
+    void alignIfAligned()
+    {
+        if (variant_ == PerVariant::Aligned) {
+            align();
+        }
+    }
+
+    const uint8_t* data_;
+    const size_t size_bits_;
+    const PerVariant variant_;
+    size_t position_ = 0;
+    bool ok_ = true;
+};
+
+#endif  // PER_BIT_STREAM_HPP
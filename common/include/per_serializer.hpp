@@ -0,0 +1,88 @@
+#ifndef PER_SERIALIZER_HPP
+#define PER_SERIALIZER_HPP
+
+#include "iserializer.hpp"
+#include "per_bit_stream.hpp"
+#include "types.hpp"
+
+/**
+ * @brief Bit-packed codec in the style of ASN.1 PER (X.691).
+ * Fields are constrained whole numbers sized to their 3GPP value ranges,
+ * strings are UTF-8 octet strings behind a length determinant. Values
+ * outside a field's range are clamped on encode; RSRP goes in 0.1 dB
+ * steps over the 3GPP RSRP-Range.
+ */
+class PerSerializer : public ISerializer
+{
+public:
+    explicit PerSerializer(PerVariant variant = PerVariant::Unaligned);
+
+    QByteArray serializeRrcSetupRequest(
+        const RrcSetupRequest& info) const override;
+
+    std::optional<RrcSetupRequest> deserializeRrcSetupRequest(
+        const QByteArray& payload) const override;
+    QByteArray serializeRachPreamble(const uint16_t& ra_rnti) const override;
+    std::optional<RachPreambleInfo> deserializeRachPreamble(
+        const QByteArray& payload) const override;
+
+    QByteArray serializeRar(const RarInfo& info) const override;
+    std::optional<RarInfo> deserializeRar(
+        const QByteArray& payload) const override;
+
+    QByteArray serializeRrcSetup(const RrcSetupInfo& info) const override;
+    std::optional<RrcSetupInfo> deserializeRrcSetup(
+        const QByteArray& payload) const override;
+
+    QByteArray serializeRrcSetupComplete(
+        const RrcSetupCompleteInfo& info) const override;
+
+    std::optional<RrcSetupCompleteInfo> deserializeRrcSetupComplete(
+        const QByteArray& payload) const override;
+
+    QByteArray serializeRrcRelease(const RrcReleaseCause& info) const override;
+    std::optional<RrcReleaseCause> deserializeRrcRelease(
+        const QByteArray& payload) const override;
+
+    QByteArray serializeRegistrationRequest(
+        const RegistrationRequestInfo& info) const override;
+    std::optional<RegistrationRequestInfo> deserializeRegistrationRequest(
+        const QByteArray& payload) const override;
+
+    QByteArray serializeRegistrationAnswer(
+        const RegistrationAnswerInfo& info) const override;
+    std::optional<RegistrationAnswerInfo> deserializeRegistrationAnswer(
+        const QByteArray& payload) const override;
+
+    std::optional<RrcReconfigurationInfo> deserializeRrcReconfiguration(
+        const QByteArray& payload) const override;
+    QByteArray serializeChatMessage(
+        const ChatMessageInfo& message) const override;
+    std::optional<ChatMessageInfo> deserializeChatMessage(
+        const QByteArray& payload) const override;
+
+    QByteArray serializeSB1Info(const SIB1Info& sib1) const override;
+    std::optional<SIB1Info> deserializeSB1Info(
+        const QByteArray& payload) const override;
+
+    QByteArray serializeMeasurementReport(
+        const MeasurementReportInfo& info) const override;
+    std::optional<MeasurementReportInfo> deserializeMeasurementReport(
+        const QByteArray& payload) const override;
+
+    // Read by the RadioHub itself, so it keeps the QDataStream layout.
+    QByteArray serializeRegistrationPayload(
+        const GnbRegistrationInfo& info) const override;
+
+    QByteArray serializeTriggerHandover(const HandoverInfo info) const override;
+    std::optional<HandoverInfo> deserializeTriggerHandover(
+        const QByteArray& payload) const override;
+
+private:
+    PerBitWriter writer() const;
+    PerBitReader reader(const QByteArray& payload) const;
+
+    const PerVariant variant_;
+};
+
+#endif  // PER_SERIALIZER_HPP
@@ -6,6 +6,10 @@
 #include "iserializer.hpp"
 #include "types.hpp"
 
+/**
+ * @brief Big-endian QDataStream wire layout. The encoders and decoders are
+ * generated by MessageCodec from the field lists in message_fields.hpp.
+ */
 class QDataStreamSerializer : public ISerializer
 {
 public:
@@ -62,7 +66,8 @@ public:
     std::optional<MeasurementReportInfo> deserializeMeasurementReport(
         const QByteArray& payload) const override;
 
-    QByteArray serializeRegistrationPayload(const double radius) const override;
+    QByteArray serializeRegistrationPayload(
+        const GnbRegistrationInfo& info) const override;
 
     QByteArray serializeTriggerHandover(const HandoverInfo info) const override;
     std::optional<HandoverInfo> deserializeTriggerHandover(
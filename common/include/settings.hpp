@@ -15,12 +15,197 @@ struct Paths {
     std::string build_dir;
 };
 
+/**
+ * @brief Datagram I/O backend used by UdpTransport.
+ * InProcess passes buffers between transports of one process, no sockets.
+ */
+enum class UdpBackend : uint8_t {
+    Datagram = 0,
+    Batched = 1,
+    InProcess = 2
+};
+
+/**
+ * @brief ISerializer used by gNBs and UEs for protocol payloads.
+ * All nodes of a simulation must use the same codec.
+ */
+enum class PayloadCodec : uint8_t {
+    QDataStream = 0,
+    PerAligned = 1,
+    PerUnaligned = 2
+};
+
+/**
+ * @brief Traffic recording mode of the RadioHub.
+ * Record writes every inbound datagram to a file, Replay feeds such a file
+ * back into the hub instead of listening on a socket.
+ */
+enum class TrafficMode : uint8_t {
+    Off = 0,
+    Record = 1,
+    Replay = 2
+};
+
+/**
+ * @brief Path loss model used by the RadioHub link budget.
+ * None keeps the plain gNB radius check.
+ */
+enum class PathLossModel : uint8_t {
+    None = 0,
+    FreeSpace = 1,
+    UrbanMacro = 2,
+    UrbanMicro = 3
+};
+
+/**
+ * @brief One-way impairment of a radio link emulated by the RadioHub.
+ */
+struct LinkProfile {
+    double delay_ms = 0.0;
+    double jitter_ms = 0.0;
+    double loss_probability = 0.0;
+};
+
+struct LinkOverride {
+    uint32_t src_id;
+    uint32_t dst_id;
+    LinkProfile profile;
+};
+
+struct LinkImpairmentSettings {
+    LinkProfile base;
+    double delay_per_km_ms = 0.0;
+    std::vector<LinkOverride> links;
+};
+
+/**
+ * @brief Per-UE SINR computed by the RadioHub; needs a path loss model.
+ * gNBs interfere up to interference_range_m, which should be at least the
+ * largest gNB radius. A covering gNB gets a SinrReport for a UE whenever
+ * its SINR there moved by report_threshold_db.
+ */
+struct InterferenceSettings {
+    bool enabled = false;
+    double noise_floor_dbm = -94.0;  // kTB over 20 MHz + 7 dB noise figure
+    double interference_range_m = 5000.0;
+    double report_threshold_db = 1.0;
+};
+
+/**
+ * @brief Expiry of nodes that went silent without deregistering.
+ * Registered nodes send a Heartbeat every heartbeat_interval_ms; the hub
+ * drops a node it has not heard from for node_timeout_ms. The hub stops
+ * sending to an endpoint for quarantine_ms after max_send_errors send
+ * errors on any routing thread, failed sends or ICMP errors reported by
+ * the batched backend, with no datagram from it in between.
+ */
+struct LivenessSettings {
+    bool enabled = false;
+    uint32_t heartbeat_interval_ms = 5000;
+    uint32_t node_timeout_ms = 15000;
+    uint32_t max_send_errors = 5;
+    uint32_t quarantine_ms = 10000;
+};
+
+/**
+ * @brief Signaling capture of every datagram routed by the RadioHub.
+ * Records go through one lock-free ring per routing thread into a pcapng
+ * file; ring_capacity is per thread and rounded up to a power of two.
+ */
+struct CaptureSettings {
+    bool enabled = false;
+    std::string path = "radiohub_capture.pcapng";
+    uint32_t ring_capacity = 4096;
+};
+
+/**
+ * @brief Record and replay of the RadioHub's inbound traffic.
+ * replay_speed 1 replays in real time, 10 ten times faster and 0 as fast
+ * as possible. Replayed sends are never transmitted; they are counted and,
+ * with replay_output_path set, recorded there in the same format.
+ */
+struct TrafficRecordingSettings {
+    TrafficMode mode = TrafficMode::Off;
+    std::string path = "radiohub_traffic.rec";
+    double replay_speed = 1.0;
+    std::string replay_output_path;
+};
+
+/**
+ * @brief Prometheus endpoint of the RadioHub, bound to localhost only.
+ */
+struct MetricsSettings {
+    bool enabled = false;
+    uint16_t port = 9464;
+};
+
+/**
+ * @brief Shared-memory rings between the RadioHub and nodes on its host.
+ * Nodes attach after registering; remote nodes and failed attaches stay on
+ * UDP. ring_bytes is per direction and rounded up to a power of two.
+ */
+struct ShmTransportSettings {
+    bool enabled = false;
+    uint32_t ring_bytes = 1u << 20;
+};
+
+/**
+ * @brief Aggregation of the protocol messages a node sends in one event
+ * loop pass into a single Bundle datagram of at most max_datagram_bytes.
+ * The RadioHub splits bundles and regroups their PDUs per destination.
+ */
+struct BundlingSettings {
+    bool enabled = false;
+    uint32_t max_datagram_bytes = 1400;
+};
+
+/**
+ * @brief Rectangular region of the plane owned by one RadioHub process.
+ * min is inclusive and max exclusive, so adjacent regions do not overlap.
+ */
+struct HubRegion {
+    uint32_t id = 0;
+    double min_x = 0.0;
+    double min_y = 0.0;
+    double max_x = 0.0;
+    double max_y = 0.0;
+    std::string address = "127.0.0.1";
+    uint16_t port = 0;
+};
+
+/**
+ * @brief Geographic multi-hub setup. Nodes within border_margin_m of a
+ * neighbouring region are mirrored to that region's hub; the margin should
+ * be at least the largest gNB radius.
+ */
+struct FederationSettings {
+    bool enabled = false;
+    uint32_t region_id = 0;
+    double border_margin_m = 0.0;
+    std::vector<HubRegion> regions;
+};
+
 struct HubSettings {
     uint16_t port;
     uint32_t id;
     uint32_t broadcast_id;
     Point2D virt_pos;
     std::string address;
+    double grid_cell_size = 500.0;
+    uint32_t worker_threads = 1;
+    UdpBackend udp_backend = UdpBackend::Datagram;
+    PayloadCodec payload_codec = PayloadCodec::QDataStream;
+    PathLossModel path_loss_model = PathLossModel::None;
+    double carrier_frequency_ghz = 3.5;
+    LinkImpairmentSettings link_impairment;
+    InterferenceSettings interference;
+    LivenessSettings liveness;
+    CaptureSettings capture;
+    TrafficRecordingSettings recording;
+    MetricsSettings metrics;
+    FederationSettings federation;
+    ShmTransportSettings shm_transport;
+    BundlingSettings bundling;
 
     HubSettings() = delete;
 
@@ -35,7 +220,6 @@ struct Cell {
 };
 
 struct RadioSettings {
-    int radio_frame_duration;
     double tx_power_db;
 
     RadioSettings() = delete;
@@ -51,14 +235,51 @@ struct NodeSettings {
     NodeSettings(HubSettings hub_set, RadioSettings radio_set, Cell cell_set);
 };
 
+/**
+ * @brief Consecutive node IDs run by one host process
+ * (--count N --id-start X).
+ */
+struct HostRange {
+    uint32_t id_start = 0;
+    uint32_t count = 0;
+};
+
+/**
+ * @brief gNB host mode: many cells in one process behind one socket.
+ * registrations_per_interval cells register every
+ * registration_interval_ms. Cells without a configured position are laid
+ * out on a square grid of grid_spacing_m around the hub's virtual
+ * position.
+ */
+struct GnbHostSettings {
+    uint32_t registrations_per_interval = 64;
+    uint32_t registration_interval_ms = 10;
+    double grid_spacing_m = 2000.0;
+};
+
 struct GnbSettings : NodeSettings {
     double radius;
+    GnbHostSettings host;
 
     GnbSettings() = delete;
     GnbSettings(HubSettings h, RadioSettings r_set, Cell c, double r);
 };
 
+/**
+ * @brief UE host mode: many UEs in one process behind one socket.
+ * Registration goes out in batches of registration_batch_size every
+ * registration_interval_ms. UEs without a configured position are placed
+ * at random within placement_radius_m of the hub's virtual position.
+ */
+struct UeHostSettings {
+    uint32_t registration_batch_size = 64;
+    uint32_t registration_interval_ms = 10;
+    double placement_radius_m = 3000.0;
+};
+
 struct UeSettings : NodeSettings {
+    UeHostSettings host;
+
     UeSettings() = delete;
     UeSettings(HubSettings hub_set, RadioSettings radio_set, Cell cell_set);
 };
@@ -87,6 +308,22 @@ struct UeRuntimeContext : BaseNodeContext {
     UeRuntimeContext(uint32_t node_id, UeSettings settings, Point2D pos);
 };
 
+struct UeHostContext {
+    HostRange range;
+    UeSettings set;
+
+    UeHostContext() = delete;
+    UeHostContext(HostRange host_range, UeSettings settings);
+};
+
+struct GnbHostContext {
+    HostRange range;
+    GnbSettings set;
+
+    GnbHostContext() = delete;
+    GnbHostContext(HostRange host_range, GnbSettings settings);
+};
+
 struct Positions {
     std::unordered_map<uint32_t, Point2D> gnbs;
     std::unordered_map<uint32_t, Point2D> ues;
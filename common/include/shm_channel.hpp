@@ -0,0 +1,71 @@
+#ifndef SHM_CHANNEL_HPP
+#define SHM_CHANNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <QByteArray>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+
+#include "shm_ring.hpp"
+
+class QSocketNotifier;
+
+/**
+ * @brief Datagram channel between a node and the RadioHub on one host.
+ * A POSIX shared-memory segment holds one ShmRing per direction. Each
+ * direction has a named FIFO as doorbell, rung only when the consumer went
+ * to sleep, so a busy consumer drains the ring without any syscall.
+ * The node creates (and finally unlinks) the segment, the hub attaches it.
+ * Linux only: elsewhere create() and attach() return nullptr.
+ */
+class ShmChannel : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr uint32_t MAGIC = 0x53484d31;  // "SHM1"
+
+    /**
+     * @brief Segment name of node_id at the hub listening on hub_port.
+     */
+    static QString nameFor(quint16 hub_port, uint32_t node_id);
+
+    static std::unique_ptr<ShmChannel> create(const QString& name,
+                                              size_t ring_bytes);
+    static std::unique_ptr<ShmChannel> attach(const QString& name);
+
+    ~ShmChannel();
+
+    /**
+     * @brief Thread-safe. Returns false when the datagram does not fit in
+     * the ring; the caller falls back to UDP.
+     */
+    bool send(const QByteArray& data);
+
+    /**
+     * @brief Starts watching the doorbell from the calling thread.
+     */
+    void listen();
+
+signals:
+    void datagramReceived(const QByteArray& data);
+
+private:
+    struct Mapping;
+
+    ShmChannel(std::unique_ptr<Mapping> mapping, bool is_owner);
+
+    void onDoorbell();
+
+    std::unique_ptr<Mapping> mapping_;
+    const bool is_owner_;
+    ShmRing tx_;
+    ShmRing rx_;
+    QMutex tx_mutex_;
+    QSocketNotifier* notifier_ = nullptr;
+};
+
+#endif  // SHM_CHANNEL_HPP
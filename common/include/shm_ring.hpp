@@ -0,0 +1,186 @@
+#ifndef SHM_RING_HPP
+#define SHM_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Control block of a ShmRing, placed in shared memory.
+ * Positions are free-running byte counters, so head == tail means empty.
+ * consumer_waiting is raised by a consumer about to sleep on its doorbell.
+ */
+struct ShmRingControl {
+    static constexpr size_t CACHE_LINE = 64;
+
+    alignas(CACHE_LINE) std::atomic<uint64_t> head{0};
+    alignas(CACHE_LINE) std::atomic<uint64_t> tail{0};
+    alignas(CACHE_LINE) std::atomic<uint32_t> consumer_waiting{0};
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "ShmRing needs address-free 64-bit atomics");
+
+/**
+ * @brief Single-producer/single-consumer ring of variable-length datagrams
+ * over caller-provided memory, usable across processes.
+ * A record is a u32 length plus the bytes, padded to 8. A record that does
+ * not fit before the end of the buffer is preceded by a padding record
+ * that skips to the start, so every record is contiguous and is handed to
+ * the consumer in place.
+ */
+class ShmRing
+{
+public:
+    static constexpr uint32_t PADDING = UINT32_MAX;
+    static constexpr size_t RECORD_ALIGN = 8;
+
+    /**
+     * @brief capacity must be a power of two; data is capacity bytes.
+     */
+    ShmRing(ShmRingControl* control, char* data, size_t capacity)
+        : control_(control)
+        , data_(data)
+        , capacity_(capacity)
+        , mask_(capacity - 1)
+    {
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    // Largest datagram that always fits into an empty ring.
+    size_t maxRecordSize() const
+    {
+        return capacity_ / 2 - sizeof(uint32_t);
+    }
+
+    /**
+     * @brief Producer side. Returns false without blocking when the ring
+     * has no room or the datagram is larger than maxRecordSize().
+     */
+    bool push(const char* bytes, size_t size)
+    {
+        if (size > maxRecordSize()) {
+            return false;
+        }
+
+        const size_t need = recordSize(size);
+        const uint64_t tail = control_->tail.load(std::memory_order_relaxed);
+        const size_t offset = static_cast<size_t>(tail & mask_);
+        const size_t to_end = capacity_ - offset;
+        const size_t skip = to_end < need ? to_end : 0;
+
+        if (tail + skip + need - cached_head_ > capacity_) {
+            cached_head_ = control_->head.load(std::memory_order_acquire);
+            if (tail + skip + need - cached_head_ > capacity_) {
+                return false;
+            }
+        }
+
+        if (skip != 0) {
+            writeLength(offset, PADDING);
+        }
+        const size_t start = (offset + skip) & mask_;
+        writeLength(start, static_cast<uint32_t>(size));
+        std::memcpy(data_ + start + sizeof(uint32_t), bytes, size);
+
+        control_->tail.store(tail + skip + need, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Calls consume(const char*, size_t) for every
+     * published datagram in FIFO order; the bytes are valid during the
+     * call only. Returns the number of datagrams consumed.
+     */
+    template <typename Consume>
+    size_t drain(Consume&& consume)
+    {
+        uint64_t head = control_->head.load(std::memory_order_relaxed);
+        const uint64_t tail = control_->tail.load(std::memory_order_acquire);
+
+        size_t consumed = 0;
+        while (head != tail) {
+            const size_t offset = static_cast<size_t>(head & mask_);
+            const uint32_t length = readLength(offset);
+            if (length == PADDING) {
+                head += capacity_ - offset;
+                continue;
+            }
+            consume(static_cast<const char*>(data_ + offset +
+                                             sizeof(uint32_t)),
+                    static_cast<size_t>(length));
+            head += recordSize(length);
+            ++consumed;
+        }
+
+        control_->head.store(head, std::memory_order_release);
+        return consumed;
+    }
+
+    bool empty() const
+    {
+        return control_->head.load(std::memory_order_acquire) ==
+               control_->tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Consumer side, before sleeping on the doorbell. Returns false
+     * when data arrived meanwhile and the consumer must drain again.
+     */
+    bool prepareToSleep()
+    {
+        control_->consumer_waiting.store(1, std::memory_order_relaxed);
+        // Pairs with the fence in needsWakeup(): either this side sees the
+        // new tail or the producer sees the raised flag.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!empty()) {
+            control_->consumer_waiting.store(0, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Producer side, after push(). True when the consumer went to
+     * sleep and the doorbell has to be rung (once per sleep).
+     */
+    bool needsWakeup()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return control_->consumer_waiting.load(std::memory_order_relaxed) &&
+               control_->consumer_waiting.exchange(
+                   0, std::memory_order_acq_rel) != 0;
+    }
+
+private:
+    static size_t recordSize(size_t size)
+    {
+        return (sizeof(uint32_t) + size + RECORD_ALIGN - 1) &
+               ~(RECORD_ALIGN - 1);
+    }
+
+    void writeLength(size_t offset, uint32_t length)
+    {
+        std::memcpy(data_ + offset, &length, sizeof(length));
+    }
+
+    uint32_t readLength(size_t offset) const
+    {
+        uint32_t length;
+        std::memcpy(&length, data_ + offset, sizeof(length));
+        return length;
+    }
+
+    ShmRingControl* control_;
+    char* data_;
+    const size_t capacity_;
+    const size_t mask_;
+    uint64_t cached_head_ = 0;
+};
+
+#endif  // SHM_RING_HPP
@@ -2,15 +2,44 @@
 #define SIMPROTOCOL_HPP
 
 #include <cstdint>
+#include <vector>
 
 #include <QByteArray>
 #include <QDataStream>
+#include <QHostAddress>
 #include <QPoint>
 
 #include "types.hpp"
 
 namespace SimProtocol {
 
+/**
+ * Fixed big-endian header layout written by writeHeader(). Every field
+ * sits at a fixed, naturally aligned offset behind a version byte;
+ * datagrams of another version are rejected as invalid.
+ */
+inline constexpr uint8_t VERSION = 2;
+inline constexpr int VERSION_OFFSET = 0;
+inline constexpr int MSG_TYPE_OFFSET = 1;
+inline constexpr int NODE_TYPE_OFFSET = 2;
+inline constexpr int FLAGS_OFFSET = 3;  // reserved, written as 0
+inline constexpr int SRC_ID_OFFSET = 4;
+inline constexpr int DST_ID_OFFSET = 8;
+inline constexpr int POS_X_OFFSET = 12;
+inline constexpr int POS_Y_OFFSET = 20;
+inline constexpr int HEADER_SIZE = 28;
+// Data payloads start with the ProtocolMsgType byte (BaseEntity::sendSimData).
+inline constexpr int PROTOCOL_TYPE_OFFSET = HEADER_SIZE;
+
+/**
+ * Bundle payload: a u8 PDU count, then per PDU a u32 destination id, the
+ * ProtocolMsgType byte, a u16 length and the PDU bytes.
+ */
+inline constexpr int BUNDLE_COUNT_SIZE = 1;
+inline constexpr int BUNDLE_PDU_HEADER_SIZE = 7;
+inline constexpr int MAX_BUNDLE_PDUS = 255;
+inline constexpr int MAX_BUNDLE_PDU_SIZE = 0xFFFF;
+
 struct DecodedPacket {
     uint32_t srcId;
     uint32_t dstId;
@@ -26,14 +55,183 @@ struct DecodedPacket {
     bool isFromHub(const uint32_t hub_id) const;
 };
 
+/**
+ * @brief Header fields read in place from a received buffer.
+ * No QDataStream and no payload copy: routing code can use it and forward
+ * the original bytes untouched.
+ */
+struct HeaderView {
+    uint32_t srcId = 0;
+    uint32_t dstId = 0;
+    SimMessageType type = SimMessageType::Unknown;
+    EntityType nodeType = EntityType::UNKNOWN;
+    QPointF position;
+    bool isValid = false;
+
+    bool isForHub(const uint32_t hub_id) const;
+    bool isBroadcast(const uint32_t broadcast_id) const;
+};
+
+/**
+ * @brief A received datagram: the header fields and a non-owning view of
+ * the payload. Only valid while the parsed buffer is alive and unchanged.
+ */
+struct PacketView : HeaderView {
+    const char* payloadData = nullptr;
+    int payloadSize = 0;
+
+    bool isForMe(uint32_t myId, uint32_t broadcast_id) const;
+
+    // Wraps the payload bytes without copying them.
+    QByteArray payload() const;
+    // ProtocolMsgType of a Data datagram, Unknown for anything else.
+    ProtocolMsgType protocolType() const;
+    // Data payload behind the ProtocolMsgType byte, without copying it.
+    QByteArray protocolPayload() const;
+};
+
+/**
+ * @brief Writes the HEADER_SIZE header bytes to out.
+ */
+void writeHeader(char* out, uint32_t src, EntityType entity_type,
+                 uint32_t dst, SimMessageType type, const QPointF& position);
+
+/**
+ * Packets are built in buffers of the thread's PacketPool: the payload goes
+ * in place behind the reserved header, which is written last. The buffer
+ * returns to the pool once every copy of the packet is gone.
+ */
 QByteArray buildPacket(uint32_t src, EntityType entity_type, uint32_t dst,
                        SimMessageType type, const QPointF& position,
                        const QByteArray& payload = QByteArray());
 
+/**
+ * @brief Builds a Data datagram: header, ProtocolMsgType byte and payload
+ * in one pooled buffer, without an intermediate protocol payload.
+ */
+QByteArray buildDataPacket(uint32_t src, EntityType entity_type,
+                           uint32_t dst, const QPointF& position,
+                           ProtocolMsgType protocol_type,
+                           const QByteArray& payload);
+
+/**
+ * @brief One protocol message of a Bundle datagram. data is not owned: it
+ * points into the payload being built or the datagram being parsed.
+ */
+struct BundlePdu {
+    uint32_t dstId = 0;
+    ProtocolMsgType type = ProtocolMsgType::Unknown;
+    const char* data = nullptr;
+    int size = 0;
+
+    // Wraps the PDU bytes without copying them.
+    QByteArray payload() const;
+};
+
+// Size of the Bundle datagram carrying pdus.
+int bundlePacketSize(const std::vector<BundlePdu>& pdus);
+
+/**
+ * @brief Builds a Bundle datagram carrying pdus in order, in one buffer.
+ * At most MAX_BUNDLE_PDUS PDUs of up to MAX_BUNDLE_PDU_SIZE bytes each.
+ */
+QByteArray buildBundlePacket(uint32_t src, EntityType entity_type,
+                             uint32_t dst, const QPointF& position,
+                             const std::vector<BundlePdu>& pdus);
+
+/**
+ * @brief Splits a Bundle datagram into pdus, which point into the viewed
+ * buffer. Returns false and leaves pdus empty if the bundle is malformed.
+ */
+bool parseBundle(const PacketView& packet, std::vector<BundlePdu>& pdus);
+
+/**
+ * @brief Pooled copy of packet addressed to dst. The hub uses it for the
+ * broadcast copies of nodes that share one endpoint, so that their host
+ * can tell them apart.
+ */
+QByteArray readdress(const QByteArray& packet, uint32_t dst);
+
+/**
+ * @brief Header and owned payload copy, for callers that keep the payload.
+ */
 DecodedPacket parse(const QByteArray& data);
 
+HeaderView peekHeader(const QByteArray& data);
+PacketView view(const QByteArray& data);
+
+/**
+ * @brief ProtocolMsgType of a Data datagram, Unknown for anything else.
+ */
+ProtocolMsgType peekProtocolType(const QByteArray& data);
+
 double parseRadius(const QByteArray& data);
 
+/**
+ * @brief Decodes a gNB registration payload. Older payloads that carry only
+ * the radius keep the default TX power and min RX level.
+ */
+GnbRegistrationInfo parseGnbRegistration(const QByteArray& data);
+
+/**
+ * @brief Tells a node to talk to another RadioHub from now on. With
+ * mustRegister the node registers there again; otherwise the hubs have
+ * already moved its registration.
+ */
+struct HubRedirect {
+    QHostAddress address;
+    quint16 port = 0;
+    bool mustRegister = false;
+    bool isValid = false;
+};
+
+QByteArray buildHubRedirectPayload(const QHostAddress& address, quint16 port,
+                                   bool must_register);
+HubRedirect parseHubRedirect(const QByteArray& data);
+
+/**
+ * @brief SINR of one UE as seen from the gNB receiving the SinrReport.
+ * Carried as a u32 UE id and an i16 in 0.1 dB steps.
+ */
+struct SinrSample {
+    uint32_t ueId = 0;
+    double sinrDb = 0.0;
+};
+
+QByteArray buildSinrReportPayload(const std::vector<SinrSample>& samples);
+std::vector<SinrSample> parseSinrReport(const QByteArray& data);
+
+/**
+ * @brief RSRP of one gNB as computed by the hub's link budget for the UE
+ * receiving the RsrpReport. Same wire layout as SinrSample; a report lists
+ * every gNB the UE can hear and replaces the previous one.
+ */
+struct RsrpSample {
+    uint32_t gnbId = 0;
+    double rsrpDbm = 0.0;
+};
+
+QByteArray buildRsrpReportPayload(const std::vector<RsrpSample>& samples);
+std::vector<RsrpSample> parseRsrpReport(const QByteArray& data);
+
+/**
+ * @brief One node of a RegistrationBatch, sent by a process hosting many
+ * nodes behind one endpoint. Carried as a u32 id and the position as two
+ * doubles, behind a u16 node count.
+ */
+struct BatchedNode {
+    uint32_t id = 0;
+    QPointF position;
+};
+
+// Keeps a batch within one 1400 byte datagram.
+inline constexpr int MAX_REGISTRATION_BATCH = 64;
+
+QByteArray buildRegistrationBatchPayload(
+    const std::vector<BatchedNode>& nodes);
+// Nodes of a batch; a truncated entry ends the list.
+std::vector<BatchedNode> parseRegistrationBatch(const QByteArray& data);
+
 }  // namespace SimProtocol
 
 #endif  // SIMPROTOCOL_HPP
@@ -0,0 +1,96 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring.
+ * Slots are preallocated and filled in place, so pushing a record is one
+ * write into the slot plus one release store. The producer caches the
+ * consumer index and only reloads it when the ring looks full; the consumer
+ * loads the producer index once per drain() batch.
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    static constexpr size_t CACHE_LINE = 64;
+
+    explicit SpscRing(size_t capacity)
+        : slots_(roundUpToPowerOfTwo(capacity))
+        , mask_(slots_.size() - 1)
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const
+    {
+        return slots_.size();
+    }
+
+    /**
+     * @brief Producer side. Calls fill(T&) on a free slot and publishes it.
+     * Returns false without blocking when the ring is full.
+     */
+    template <typename Fill>
+    bool tryPush(Fill&& fill)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == slots_.size()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == slots_.size()) {
+                return false;
+            }
+        }
+
+        fill(slots_[tail & mask_]);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Calls consume(const T&) for up to max_items
+     * published slots in FIFO order and returns how many were consumed.
+     */
+    template <typename Consume>
+    size_t drain(Consume&& consume, size_t max_items = SIZE_MAX)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+
+        size_t consumed = 0;
+        while (head != tail && consumed < max_items) {
+            consume(static_cast<const T&>(slots_[head & mask_]));
+            ++head;
+            ++consumed;
+        }
+
+        head_.store(head, std::memory_order_release);
+        return consumed;
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    std::vector<T> slots_;
+    const size_t mask_;
+
+    alignas(CACHE_LINE) std::atomic<size_t> head_{0};
+
+    alignas(CACHE_LINE) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+};
+
+#endif  // SPSC_RING_HPP
@@ -0,0 +1,93 @@
+#ifndef TIMER_SCHEDULER_HPP
+#define TIMER_SCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <QElapsedTimer>
+#include <QObject>
+
+#include "timing_wheel.hpp"
+
+class QTimer;
+
+/**
+ * @brief Per-thread scheduler for the deadlines of simulated nodes.
+ *
+ * Deadlines of every node on the thread live in one millisecond timing
+ * wheel. A single single-shot QTimer is armed for the earliest deadline,
+ * so the thread wakes up when something is due rather than once per radio
+ * frame per node. Callbacks run on the scheduler's thread, in deadline
+ * order. A scheduler built with its own clock has no timer: its owner
+ * moves the clock and calls fireDue(), e.g. in tests.
+ */
+class TimerScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    using Callback = std::function<void()>;
+    using TimerId = TimingWheel<Callback>::TimerId;
+    static constexpr TimerId INVALID_TIMER =
+        TimingWheel<Callback>::INVALID_TIMER;
+    // Milliseconds on any monotonic scale.
+    using Clock = std::function<uint64_t()>;
+
+    explicit TimerScheduler(QObject* parent = nullptr, Clock clock = {});
+
+    // Scheduler of the calling thread.
+    static TimerScheduler& local();
+
+    // Runs callback once, delay_ms from now.
+    TimerId schedule(uint32_t delay_ms, Callback callback);
+    // False when the timer has already fired or was cancelled.
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Runs every callback that is due. The timer calls it; owners
+     * without an event loop can call it themselves.
+     */
+    size_t fireDue();
+
+    size_t pending() const;
+    // Times the timer woke the thread, for comparison with per-node ticks.
+    uint64_t wakeups() const;
+
+private:
+    uint64_t nowMs() const;
+    void onTimer();
+    void armTimer();
+
+    QTimer* timer_ = nullptr;
+    const Clock clock_;
+    QElapsedTimer elapsed_;
+    TimingWheel<Callback> wheel_;
+    // Earliest pending deadline; may still name a cancelled timer.
+    uint64_t next_due_ms_ = TimingWheel<Callback>::NEVER;
+    bool is_firing_ = false;
+    uint64_t wakeups_ = 0;
+};
+
+/**
+ * @brief One restartable deadline of a node, e.g. its next SIB1.
+ * Restarting replaces the pending expiry; destroying it cancels it, so
+ * callbacks may capture the owner.
+ */
+class Deadline
+{
+public:
+    explicit Deadline(TimerScheduler& scheduler = TimerScheduler::local());
+    ~Deadline();
+    Deadline(const Deadline&) = delete;
+    Deadline& operator=(const Deadline&) = delete;
+
+    void start(uint32_t delay_ms, TimerScheduler::Callback on_expire);
+    void stop();
+    bool isActive() const;
+
+private:
+    TimerScheduler& scheduler_;
+    TimerScheduler::TimerId timer_ = TimerScheduler::INVALID_TIMER;
+};
+
+#endif  // TIMER_SCHEDULER_HPP
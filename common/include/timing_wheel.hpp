@@ -0,0 +1,281 @@
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Hierarchical timing wheel (Varghese & Lauck).
+ * LEVELS wheels of SLOTS slots each; level L slots are SLOTS^L ticks wide.
+ * schedule() and cancel() are O(1), advance() costs O(1) per elapsed tick
+ * plus O(1) per expired or cascaded timer. Timers live in a pooled node
+ * array, so steady-state scheduling does not allocate.
+ */
+template <typename T>
+class TimingWheel
+{
+public:
+    using TimerId = uint64_t;
+    static constexpr TimerId INVALID_TIMER = 0;
+    // nextWakeup() of an empty wheel.
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    static constexpr uint32_t SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t LEVELS = 4;
+
+    explicit TimingWheel(uint64_t start_tick = 0)
+        : now_(start_tick)
+    {
+        for (auto& level : wheels_) {
+            level.fill(Slot{});
+        }
+    }
+
+    uint64_t now() const
+    {
+        return now_;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    /**
+     * @brief Deadlines that are not in the future fire on the next tick.
+     */
+    TimerId schedule(uint64_t deadline, T payload)
+    {
+        const uint32_t index = allocate();
+        Node& node = nodes_[index];
+        node.deadline = deadline > now_ ? deadline : now_ + 1;
+        node.payload = std::move(payload);
+        node.active = true;
+        place(index);
+        ++size_;
+        return makeId(index, node.generation);
+    }
+
+    bool cancel(TimerId id)
+    {
+        const uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+        const uint32_t generation = static_cast<uint32_t>(id >> 32);
+        if (id == INVALID_TIMER || index >= nodes_.size()) {
+            return false;
+        }
+        Node& node = nodes_[index];
+        if (!node.active || node.generation != generation) {
+            return false;
+        }
+        // Unlinked lazily when its slot is expired or cascaded.
+        node.active = false;
+        node.payload = T{};
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Moves time forward to tick and calls on_expire(T&&) for every
+     * timer whose deadline has been reached, in deadline order.
+     */
+    template <typename Fn>
+    size_t advance(uint64_t tick, Fn&& on_expire)
+    {
+        size_t expired = 0;
+        while (now_ < tick) {
+            if (size_ == 0) {
+                reclaimCancelled();
+                now_ = tick;
+                break;
+            }
+            ++now_;
+
+            // Outer wheels first, so timers cascading through several levels
+            // land in inner slots that are still to be processed.
+            uint32_t top = 0;
+            while (top + 1 < LEVELS && slotOf(now_, top) == 0) {
+                ++top;
+            }
+            for (uint32_t level = top; level >= 1; --level) {
+                cascade(level, slotOf(now_, level));
+            }
+
+            Slot slot = std::exchange(wheels_[0][now_ & (SLOTS - 1)], Slot{});
+            uint32_t index = slot.head;
+            while (index != NIL) {
+                Node& node = nodes_[index];
+                const uint32_t next = node.next;
+                --pending_;
+                if (node.active) {
+                    node.active = false;
+                    --size_;
+                    T payload = std::move(node.payload);
+                    release(index);
+                    on_expire(std::move(payload));
+                    ++expired;
+                } else {
+                    release(index);
+                }
+                index = next;
+            }
+        }
+        return expired;
+    }
+
+    /**
+     * @brief Earliest deadline of a pending timer, NEVER if there is none.
+     * Each wheel is scanned from its current slot; the first slot holding
+     * a live timer has that wheel's earliest deadlines, since the current
+     * slot itself only holds timers of the next rotation. Costs at most
+     * LEVELS * SLOTS slot checks, so callers arm on it, not poll it.
+     */
+    uint64_t nextWakeup() const
+    {
+        uint64_t earliest = NEVER;
+        for (uint32_t level = 0; level < LEVELS; ++level) {
+            const uint32_t current = slotOf(now_, level);
+            for (uint32_t step = 1; step <= SLOTS; ++step) {
+                const uint64_t deadline =
+                    earliestIn(wheels_[level][(current + step) & (SLOTS - 1)]);
+                if (deadline != NEVER) {
+                    earliest = std::min(earliest, deadline);
+                    break;
+                }
+            }
+        }
+        return earliest;
+    }
+
+private:
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+
+    struct Node {
+        uint64_t deadline = 0;
+        uint32_t next = NIL;
+        uint32_t generation = 1;
+        bool active = false;
+        T payload{};
+    };
+
+    struct Slot {
+        uint32_t head = NIL;
+        uint32_t tail = NIL;
+    };
+
+    static TimerId makeId(uint32_t index, uint32_t generation)
+    {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+
+    static uint32_t slotOf(uint64_t tick, uint32_t level)
+    {
+        return static_cast<uint32_t>(tick >> (SLOT_BITS * level)) &
+               (SLOTS - 1);
+    }
+
+    uint32_t allocate()
+    {
+        if (free_head_ != NIL) {
+            const uint32_t index = free_head_;
+            free_head_ = nodes_[index].next;
+            return index;
+        }
+        nodes_.emplace_back();
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void release(uint32_t index)
+    {
+        Node& node = nodes_[index];
+        ++node.generation;
+        node.next = free_head_;
+        free_head_ = index;
+    }
+
+    void place(uint32_t index)
+    {
+        Node& node = nodes_[index];
+        const uint64_t delta = node.deadline - now_;
+
+        uint32_t level = 0;
+        while (level + 1 < LEVELS &&
+               delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+
+        Slot& slot = wheels_[level][slotOf(node.deadline, level)];
+        node.next = NIL;
+        if (slot.tail == NIL) {
+            slot.head = index;
+        } else {
+            nodes_[slot.tail].next = index;
+        }
+        slot.tail = index;
+        ++pending_;
+    }
+
+    uint64_t earliestIn(const Slot& slot) const
+    {
+        uint64_t earliest = NEVER;
+        for (uint32_t index = slot.head; index != NIL;
+             index = nodes_[index].next) {
+            if (nodes_[index].active) {
+                earliest = std::min(earliest, nodes_[index].deadline);
+            }
+        }
+        return earliest;
+    }
+
+    void reclaimCancelled()
+    {
+        if (pending_ == 0) {
+            return;
+        }
+        for (auto& level : wheels_) {
+            for (Slot& slot : level) {
+                for (uint32_t index = slot.head; index != NIL;) {
+                    const uint32_t next = nodes_[index].next;
+                    release(index);
+                    index = next;
+                }
+                slot = Slot{};
+            }
+        }
+        pending_ = 0;
+    }
+
+    void cascade(uint32_t level, uint32_t slot_index)
+    {
+        Slot slot = std::exchange(wheels_[level][slot_index], Slot{});
+        uint32_t index = slot.head;
+        while (index != NIL) {
+            const uint32_t next = nodes_[index].next;
+            --pending_;
+            if (nodes_[index].active) {
+                place(index);
+            } else {
+                release(index);
+            }
+            index = next;
+        }
+    }
+
+    uint64_t now_;
+    size_t size_ = 0;
+    size_t pending_ = 0;
+    uint32_t free_head_ = NIL;
+    std::vector<Node> nodes_;
+    std::array<std::array<Slot, SLOTS>, LEVELS> wheels_;
+};
+
+#endif  // TIMING_WHEEL_HPP
@@ -166,6 +166,12 @@ struct HandoverInfo {
     uint32_t gnb_id;
 };
 
+struct GnbRegistrationInfo {
+    double radius = 0.0;
+    double tx_power_dbm = 43.0;
+    int16_t min_rx_level = -115;
+};
+
 struct GnbCellConfig {
     uint16_t tac = 100;  // Tracking Area Code
     std::vector<PlmnIdentity> plmns;
@@ -248,6 +254,15 @@ enum class SimMessageType : uint8_t {
     RegistrationResponse,
     Deregistration,
     Data,
+    HubRedirect,
+    HubSync,
+    HubForward,
+    ShmAttach,
+    SinrReport,
+    Heartbeat,
+    Bundle,
+    RegistrationBatch,
+    RsrpReport,
     Unknown = 255
 };
 
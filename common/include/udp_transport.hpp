@@ -4,6 +4,10 @@
 #include <QString>
 #include <QUdpSocket>
 
+#include "settings.hpp"
+
+class BatchedUdpSocket;
+
 struct sendingResult {
     qint64 bytes_;
     bool is_socket_error_ = false;
@@ -15,27 +19,55 @@ struct sendingResult {
 /**
  * @brief unique class for asynchronous UDP connection
  * Used by all nodes: UE, gNB
+ * UdpBackend::Batched uses recvmmsg/sendmmsg on Linux and falls back to the
+ * per-datagram QUdpSocket path elsewhere.
+ * UdpBackend::InProcess binds no socket: datagrams go through InProcessBus
+ * to transports of the same process and arrive from 127.0.0.1. Sends to
+ * any other address fail.
  */
 class UdpTransport : public QObject
 {
     Q_OBJECT
 public:
-    UdpTransport(QObject* parent = nullptr);
+    UdpTransport(QObject* parent = nullptr,
+                 UdpBackend backend = UdpBackend::Datagram);
+    ~UdpTransport();
+    /**
+     * @brief The batched backend only queues here; a send that fails once
+     * the queue is flushed is reported through sendFailed().
+     */
     sendingResult sendData(const QByteArray& data,
                            const QHostAddress& receiver_ip,
                            quint16 receiver_port);
 
-    bool init(quint16 listen_port);
+    /**
+     * @brief Binds the socket. With reuse_port several transports (one per
+     * thread) can bind the same port and the kernel load-balances between
+     * them (SO_REUSEPORT).
+     */
+    bool init(quint16 listen_port, bool reuse_port = false);
     quint16 localPort() const;
+    bool isBatched() const;
+    bool isInProcess() const;
 
 signals:
     void dataReceived(const QByteArray& data, const QHostAddress& addr,
                       quint16 port);
+    // A send that failed after sendData() had returned.
+    void sendFailed(const QHostAddress& addr, quint16 port);
 
 private:
+    friend class InProcessBus;
+
     void readPendingDatagrams();
+    void receiveInProcess(const QByteArray& data, quint16 sender_port);
+    bool initDatagram(quint16 listen_port, bool reuse_port);
+    bool bindSharedPort(quint16 listen_port);
 
+    UdpBackend backend_;
     QUdpSocket* socket_ = nullptr;
+    BatchedUdpSocket* batched_ = nullptr;
+    quint16 in_process_port_ = 0;
 };
 
 #endif  // UDP_TRANSPORT_H
@@ -1,10 +1,12 @@
 #include "base_entity.hpp"
 
+#include <utility>
+
 #include <QDebug>
 #include <QNetworkDatagram>
 
 #include "base_entity.hpp"
-#include "qdatastream_serializer.hpp"
+#include "iserializer.hpp"
 #include "sim_protocol.hpp"
 
 BaseEntity::BaseEntity(uint32_t id, const EntityType& type, HubSettings hub_set,
@@ -13,8 +15,9 @@ BaseEntity::BaseEntity(uint32_t id, const EntityType& type, HubSettings hub_set,
     , id_(id)
     , type_(type)
     , hub_set_(hub_set)
+    , hub_address_(QString::fromStdString(hub_set_.address))
     , is_registered_(false)
-    , serializer_(std::make_unique<QDataStreamSerializer>())
+    , serializer_(makeSerializer(hub_set.payload_codec))
 {
 }
 
@@ -49,7 +52,7 @@ NodeInfo BaseEntity::getNodeInfo() const
 bool BaseEntity::setupNetwork(quint16 port)
 {
     if (!transport_) {
-        transport_ = new UdpTransport(this);
+        transport_ = new UdpTransport(this, hub_set_.udp_backend);
         transport_->setObjectName(
             QString("transport-%1-%2").arg(typeToString(type_)).arg(id_));
     }
@@ -80,17 +83,30 @@ bool BaseEntity::setupNetwork(quint16 port)
     return true;
 }
 
+void BaseEntity::attachTransport(UdpTransport* transport)
+{
+    transport_ = transport;
+}
+
+void BaseEntity::setRegistrar(Registrar registrar)
+{
+    registrar_ = std::move(registrar);
+}
+
 void BaseEntity::registerAtHub()
 {
+    if (registrar_) {
+        registrar_(id_, hub_address_, hub_set_.port);
+        return;
+    }
+
     const QByteArray payload = getRegistrationPayload();
 
     const QByteArray packet = SimProtocol::buildPacket(
         id_, type_, hub_set_.id, SimMessageType::Registration, position_,
         payload);
 
-    transport_->sendData(packet,
-                         QHostAddress(QString::fromStdString(hub_set_.address)),
-                         hub_set_.port);
+    transport_->sendData(packet, hub_address_, hub_set_.port);
 }
 
 QByteArray BaseEntity::getRegistrationPayload() const
@@ -109,6 +125,8 @@ void BaseEntity::handleRegistrationResponse(QDataStream& ds)
             << QString("[Entity %1] Registration SUCCESS at RadioHub").arg(id_);
 
         emit registrationAtRadioHubConfirmed();
+        requestShmChannel();
+        startHeartbeat();
     } else {
         is_registered_ = false;
         qWarning()
@@ -116,21 +134,158 @@ void BaseEntity::handleRegistrationResponse(QDataStream& ds)
     }
 }
 
+void BaseEntity::handleHubRedirect(const QByteArray& payload)
+{
+    const auto redirect = SimProtocol::parseHubRedirect(payload);
+    if (!redirect.isValid) {
+        qWarning() << QString("[Entity %1] Malformed hub redirect").arg(id_);
+        return;
+    }
+
+    // The channel belongs to the previous hub.
+    shm_channel_.reset();
+    is_shm_active_ = false;
+
+    hub_set_.address = redirect.address.toString().toStdString();
+    hub_address_ = redirect.address;
+    hub_set_.port = redirect.port;
+    qDebug() << QString("[Entity %1] RadioHub changed to %2:%3")
+                    .arg(id_)
+                    .arg(redirect.address.toString())
+                    .arg(redirect.port);
+
+    if (redirect.mustRegister) {
+        registerAtHub();
+    } else {
+        requestShmChannel();
+    }
+}
+
+void BaseEntity::requestShmChannel()
+{
+    const QHostAddress hub_address = hub_address_;
+    if (!hub_set_.shm_transport.enabled || shm_channel_ ||
+        !hub_address.isLoopback()) {
+        return;
+    }
+
+    shm_channel_ = ShmChannel::create(
+        ShmChannel::nameFor(hub_set_.port, id_),
+        hub_set_.shm_transport.ring_bytes);
+    if (!shm_channel_) {
+        qWarning() << QString("[Entity %1] Shared-memory channel unavailable,"
+                              " staying on UDP")
+                          .arg(id_);
+        return;
+    }
+
+    connect(shm_channel_.get(), &ShmChannel::datagramReceived, this,
+            [this, hub_address](const QByteArray& data) {
+                handleIncomingRawData(data, hub_address, hub_set_.port);
+            });
+    shm_channel_->listen();
+
+    transport_->sendData(
+        SimProtocol::buildPacket(id_, type_, hub_set_.id,
+                                 SimMessageType::ShmAttach, position_),
+        hub_address, hub_set_.port);
+}
+
+void BaseEntity::handleShmAttach(const QByteArray& payload)
+{
+    if (!shm_channel_) {
+        return;
+    }
+
+    is_shm_active_ = !payload.isEmpty() &&
+                     static_cast<uint8_t>(payload.at(0)) ==
+                         HubResponse::REG_ACCEPTED;
+    if (!is_shm_active_) {
+        shm_channel_.reset();
+        return;
+    }
+    qDebug() << QString("[Entity %1] Using shared-memory channel to RadioHub")
+                    .arg(id_);
+}
+
+void BaseEntity::startHeartbeat()
+{
+    if (!hub_set_.liveness.enabled || heartbeat_deadline_.isActive()) {
+        return;
+    }
+
+    heartbeat_deadline_.start(hub_set_.liveness.heartbeat_interval_ms,
+                              [this]() {
+                                  sendHeartbeat();
+                                  startHeartbeat();
+                              });
+}
+
+void BaseEntity::sendHeartbeat()
+{
+    if (!is_registered_) {
+        return;
+    }
+
+    sendToHub(SimProtocol::buildPacket(id_, type_, hub_set_.id,
+                                       SimMessageType::Heartbeat, position_));
+}
+
+void BaseEntity::handleHeartbeat(const QByteArray& payload)
+{
+    if (payload.isEmpty() ||
+        static_cast<uint8_t>(payload.at(0)) != HubResponse::REG_DENIED) {
+        return;
+    }
+
+    qWarning() << QString("[Entity %1] RadioHub expired the registration,"
+                          " registering again")
+                      .arg(id_);
+    is_registered_ = false;
+    is_shm_active_ = false;
+    shm_channel_.reset();
+    registerAtHub();
+}
+
+void BaseEntity::onSinrReport(
+    const std::vector<SimProtocol::SinrSample>& samples)
+{
+    Q_UNUSED(samples);
+}
+
+void BaseEntity::onRsrpReport(
+    const std::vector<SimProtocol::RsrpSample>& samples)
+{
+    Q_UNUSED(samples);
+}
+
+sendingResult BaseEntity::sendToHub(const QByteArray& packet)
+{
+    if (is_shm_active_ && shm_channel_->send(packet)) {
+        sendingResult result;
+        result.bytes_ = packet.size();
+        return result;
+    }
+    return transport_->sendData(packet, hub_address_, hub_set_.port);
+}
+
 void BaseEntity::sendSimData(ProtocolMsgType proto_type,
                              const QByteArray& payload, uint32_t target_id)
 {
-    QByteArray protocolPayload;
-
-    protocolPayload.append(static_cast<char>(proto_type));
-    protocolPayload.append(payload);
+    if (hub_set_.bundling.enabled) {
+        queuePdu(proto_type, payload, target_id);
+        return;
+    }
+    sendDataPacket(proto_type, payload, target_id);
+}
 
-    QByteArray finalPacket =
-        SimProtocol::buildPacket(id_, type_, target_id, SimMessageType::Data,
-                                 position_, protocolPayload);
+void BaseEntity::sendDataPacket(ProtocolMsgType proto_type,
+                                const QByteArray& payload, uint32_t target_id)
+{
+    QByteArray finalPacket = SimProtocol::buildDataPacket(
+        id_, type_, target_id, position_, proto_type, payload);
 
-    sendingResult result = transport_->sendData(
-        finalPacket, QHostAddress(QString::fromStdString(hub_set_.address)),
-        hub_set_.port);
+    sendingResult result = sendToHub(finalPacket);
 
     if (result.is_socket_error_) {
         qWarning() << QString("[%1 #%2] Send Error to %3: %4")
@@ -141,47 +296,148 @@ void BaseEntity::sendSimData(ProtocolMsgType proto_type,
     }
 }
 
+void BaseEntity::queuePdu(ProtocolMsgType proto_type,
+                          const QByteArray& payload, uint32_t target_id)
+{
+    const int empty_bundle =
+        SimProtocol::HEADER_SIZE + SimProtocol::BUNDLE_COUNT_SIZE;
+    const int pdu_bytes =
+        SimProtocol::BUNDLE_PDU_HEADER_SIZE + static_cast<int>(payload.size());
+    const int limit = static_cast<int>(hub_set_.bundling.max_datagram_bytes);
+
+    if (payload.size() > SimProtocol::MAX_BUNDLE_PDU_SIZE ||
+        empty_bundle + pdu_bytes > limit) {
+        // Too large to share a datagram; flush first to keep the order.
+        flushBundle();
+        sendDataPacket(proto_type, payload, target_id);
+        return;
+    }
+
+    if (pending_bytes_ + pdu_bytes > limit ||
+        static_cast<int>(pending_pdus_.size()) ==
+            SimProtocol::MAX_BUNDLE_PDUS) {
+        flushBundle();
+    }
+    if (pending_pdus_.empty()) {
+        pending_bytes_ = empty_bundle;
+        QTimer::singleShot(0, this, &BaseEntity::flushBundle);
+    }
+    pending_pdus_.push_back({target_id, proto_type, payload});
+    pending_bytes_ += pdu_bytes;
+}
+
+void BaseEntity::flushBundle()
+{
+    if (pending_pdus_.empty()) {
+        return;
+    }
+
+    // A send may hand a reply straight back and queue, or even flush, new
+    // PDUs; those go to pending_pdus_ while this batch is sent. The
+    // scratch vector is taken, so a nested flush gets one of its own.
+    std::vector<PendingPdu> flushing = std::move(flushing_pdus_);
+    flushing.swap(pending_pdus_);
+    pending_bytes_ = 0;
+
+    if (flushing.size() == 1) {
+        const PendingPdu& pdu = flushing.front();
+        sendDataPacket(pdu.type, pdu.payload, pdu.target_id);
+    } else {
+        // The vectors keep their capacity, so a warm flush allocates
+        // nothing.
+        bundle_pdus_.clear();
+        for (const PendingPdu& pdu : flushing) {
+            bundle_pdus_.push_back({pdu.target_id, pdu.type,
+                                    pdu.payload.constData(),
+                                    static_cast<int>(pdu.payload.size())});
+        }
+
+        const sendingResult result = sendToHub(SimProtocol::buildBundlePacket(
+            id_, type_, hub_set_.id, position_, bundle_pdus_));
+        if (result.is_socket_error_) {
+            qWarning() << QString("[%1 #%2] Send Error for bundle of %3: %4")
+                              .arg(typeToString(type_))
+                              .arg(id_)
+                              .arg(flushing.size())
+                              .arg(result.toString());
+        }
+    }
+
+    flushing.clear();
+    flushing_pdus_ = std::move(flushing);
+}
+
 void BaseEntity::handleIncomingRawData(const QByteArray& data,
                                        const QHostAddress& addr, quint16 port)
 {
     Q_UNUSED(addr);
     Q_UNUSED(port);
 
-    auto decoded = SimProtocol::parse(data);
+    // Payloads below are views into data, valid for the handler call only.
+    const SimProtocol::PacketView packet = SimProtocol::view(data);
 
-    if (!decoded.isValid) {
+    if (!packet.isForMe(id_, hub_set_.broadcast_id)) {
         return;
     }
 
-    if (!decoded.isForMe(id_, hub_set_.broadcast_id) &&
-        !decoded.isBroadcast(hub_set_.broadcast_id)) {
-        return;
-    }
-
-    switch (decoded.type) {
+    switch (packet.type) {
         case SimMessageType::RegistrationResponse: {
-            QDataStream ds(decoded.payload);
+            QDataStream ds(packet.payload());
             ds.setByteOrder(QDataStream::BigEndian);
             handleRegistrationResponse(ds);
             break;
         }
 
+        case SimMessageType::HubRedirect: {
+            handleHubRedirect(packet.payload());
+            break;
+        }
+
+        case SimMessageType::ShmAttach: {
+            handleShmAttach(packet.payload());
+            break;
+        }
+
+        case SimMessageType::Heartbeat: {
+            handleHeartbeat(packet.payload());
+            break;
+        }
+
+        case SimMessageType::SinrReport: {
+            onSinrReport(SimProtocol::parseSinrReport(packet.payload()));
+            break;
+        }
+
+        case SimMessageType::RsrpReport: {
+            onRsrpReport(SimProtocol::parseRsrpReport(packet.payload()));
+            break;
+        }
+
         case SimMessageType::Data: {
-            if (decoded.payload.isEmpty()) {
+            if (packet.payloadSize == 0) {
                 return;
             }
 
-            QDataStream ds(decoded.payload);
-            ds.setByteOrder(QDataStream::BigEndian);
-
-            uint8_t raw_proto_type;
-            ds >> raw_proto_type;
-            ProtocolMsgType proto_type =
-                static_cast<ProtocolMsgType>(raw_proto_type);
+            onProtocolMessageReceived(packet.srcId, packet.protocolType(),
+                                      packet.protocolPayload());
+            break;
+        }
 
-            QByteArray actualPayload = decoded.payload.mid(sizeof(uint8_t));
+        case SimMessageType::Bundle: {
+            std::vector<SimProtocol::BundlePdu> pdus;
+            if (!SimProtocol::parseBundle(packet, pdus)) {
+                qWarning() << QString("[Entity %1] Malformed bundle from %2")
+                                  .arg(id_)
+                                  .arg(packet.srcId);
+                return;
+            }
 
-            onProtocolMessageReceived(decoded.srcId, proto_type, actualPayload);
+            for (const SimProtocol::BundlePdu& pdu : pdus) {
+                if (pdu.dstId == id_ || pdu.dstId == hub_set_.broadcast_id) {
+                    onProtocolMessageReceived(packet.srcId, pdu.type,
+                                              pdu.payload());
+                }
+            }
             break;
         }
 
@@ -189,7 +445,7 @@ void BaseEntity::handleIncomingRawData(const QByteArray& data,
             qWarning() << QString(
                               "[Entity %1] Received unknown SimMessageType: %2")
                               .arg(id_)
-                              .arg(static_cast<int>(decoded.type));
+                              .arg(static_cast<int>(packet.type));
             break;
     }
 }
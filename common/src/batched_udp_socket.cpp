@@ -0,0 +1,290 @@
+#include "batched_udp_socket.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <QMetaObject>
+#include <QSocketNotifier>
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> total_send_errors{0};
+std::atomic<uint64_t> total_truncated{0};
+
+}  // namespace
+
+BatchedUdpSocket::BatchedUdpSocket(QObject* parent)
+    : QObject(parent)
+{
+}
+
+BatchedUdpSocket::~BatchedUdpSocket()
+{
+#ifdef Q_OS_LINUX
+    if (fd_ >= 0) {
+        flush();
+        ::close(fd_);
+    }
+#endif
+}
+
+bool BatchedUdpSocket::bind(quint16 listen_port, bool reuse_port)
+{
+#ifdef Q_OS_LINUX
+    fd_ = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    const int enable = 1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(listen_port);
+
+    const bool options_ok =
+        !reuse_port ||
+        (::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &enable,
+                      sizeof(enable)) == 0 &&
+         ::setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &enable,
+                      sizeof(enable)) == 0);
+    // Queue ICMP errors with their destination instead of dropping them.
+    ::setsockopt(fd_, IPPROTO_IP, IP_RECVERR, &enable, sizeof(enable));
+
+    if (!options_ok ||
+        ::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    rx_ring_.reset(new char[BATCH_SIZE * SLOT_SIZE]);
+    for (size_t i = 0; i < BATCH_SIZE; ++i) {
+        rx_iovs_[i].iov_base = rx_ring_.get() + i * SLOT_SIZE;
+        rx_iovs_[i].iov_len = SLOT_SIZE;
+        rx_msgs_[i].msg_hdr.msg_iov = &rx_iovs_[i];
+        rx_msgs_[i].msg_hdr.msg_iovlen = 1;
+        rx_msgs_[i].msg_hdr.msg_name = &rx_addrs_[i];
+        tx_msgs_[i].msg_hdr.msg_iov = &tx_iovs_[i];
+        tx_msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+    tx_queue_.reserve(BATCH_SIZE);
+
+    read_notifier_ = new QSocketNotifier(fd_, QSocketNotifier::Read, this);
+    connect(read_notifier_, &QSocketNotifier::activated, this,
+            &BatchedUdpSocket::readPendingDatagrams);
+
+    write_notifier_ = new QSocketNotifier(fd_, QSocketNotifier::Write, this);
+    write_notifier_->setEnabled(false);
+    connect(write_notifier_, &QSocketNotifier::activated, this,
+            &BatchedUdpSocket::flush);
+
+    return true;
+#else
+    Q_UNUSED(listen_port);
+    Q_UNUSED(reuse_port);
+    return false;
+#endif
+}
+
+bool BatchedUdpSocket::queue(const QByteArray& data,
+                             const QHostAddress& receiver_ip,
+                             quint16 receiver_port)
+{
+#ifdef Q_OS_LINUX
+    bool is_ipv4 = false;
+    const quint32 ipv4 = receiver_ip.toIPv4Address(&is_ipv4);
+    if (fd_ < 0 || !is_ipv4) {
+        return false;
+    }
+
+    PendingSend pending{data, {}};
+    pending.addr.sin_family = AF_INET;
+    pending.addr.sin_addr.s_addr = htonl(ipv4);
+    pending.addr.sin_port = htons(receiver_port);
+    tx_queue_.push_back(std::move(pending));
+
+    scheduleFlush();
+    return true;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(receiver_ip);
+    Q_UNUSED(receiver_port);
+    return false;
+#endif
+}
+
+void BatchedUdpSocket::scheduleFlush()
+{
+    if (flush_scheduled_) {
+        return;
+    }
+    flush_scheduled_ = true;
+    QMetaObject::invokeMethod(this, &BatchedUdpSocket::flush,
+                              Qt::QueuedConnection);
+}
+
+void BatchedUdpSocket::flush()
+{
+    flush_scheduled_ = false;
+#ifdef Q_OS_LINUX
+    write_notifier_->setEnabled(false);
+
+    while (tx_head_ < tx_queue_.size()) {
+        const size_t count = std::min(BATCH_SIZE, tx_queue_.size() - tx_head_);
+        for (size_t i = 0; i < count; ++i) {
+            PendingSend& pending = tx_queue_[tx_head_ + i];
+            // constData() keeps implicitly shared broadcast payloads intact.
+            tx_iovs_[i].iov_base = const_cast<char*>(pending.data.constData());
+            tx_iovs_[i].iov_len = static_cast<size_t>(pending.data.size());
+            tx_msgs_[i].msg_hdr.msg_name = &pending.addr;
+            tx_msgs_[i].msg_hdr.msg_namelen = sizeof(pending.addr);
+        }
+
+        const int sent = ::sendmmsg(fd_, tx_msgs_.data(),
+                                    static_cast<unsigned int>(count), 0);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                write_notifier_->setEnabled(true);
+                return;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            // The first datagram of the batch failed: drop it and go on.
+            const sockaddr_in& to = tx_queue_[tx_head_].addr;
+            ++send_errors_;
+            total_send_errors.fetch_add(1, std::memory_order_relaxed);
+            ++tx_head_;
+            emit sendFailed(QHostAddress(ntohl(to.sin_addr.s_addr)),
+                            ntohs(to.sin_port));
+            continue;
+        }
+        tx_head_ += static_cast<size_t>(sent);
+    }
+
+    tx_queue_.clear();
+    tx_head_ = 0;
+#endif
+}
+
+void BatchedUdpSocket::readPendingDatagrams()
+{
+#ifdef Q_OS_LINUX
+    drainErrorQueue();
+    while (true) {
+        for (size_t i = 0; i < BATCH_SIZE; ++i) {
+            rx_msgs_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            rx_msgs_[i].msg_hdr.msg_flags = 0;
+        }
+
+        const int received = ::recvmmsg(fd_, rx_msgs_.data(), BATCH_SIZE,
+                                        MSG_DONTWAIT, nullptr);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            // A pending ICMP error is reported once by the next receive.
+            if (received < 0 && (errno == ECONNREFUSED ||
+                                 errno == EHOSTUNREACH ||
+                                 errno == ENETUNREACH)) {
+                drainErrorQueue();
+                continue;
+            }
+            break;
+        }
+
+        for (int i = 0; i < received; ++i) {
+            const mmsghdr& msg = rx_msgs_[i];
+            if (msg.msg_hdr.msg_flags & MSG_TRUNC) {
+                ++truncated_;
+                total_truncated.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            const sockaddr_in& from = rx_addrs_[i];
+            const QByteArray data(
+                static_cast<const char*>(rx_iovs_[i].iov_base),
+                static_cast<int>(msg.msg_len));
+
+            emit datagramReceived(data,
+                                  QHostAddress(ntohl(from.sin_addr.s_addr)),
+                                  ntohs(from.sin_port));
+        }
+
+        if (static_cast<size_t>(received) < BATCH_SIZE) {
+            break;
+        }
+    }
+#endif
+}
+
+void BatchedUdpSocket::drainErrorQueue()
+{
+#ifdef Q_OS_LINUX
+    // Each entry carries the destination of the datagram that drew the
+    // error in msg_name; the datagram itself is not needed.
+    std::array<char, 512> control;
+    while (true) {
+        sockaddr_in to{};
+        msghdr msg{};
+        msg.msg_name = &to;
+        msg.msg_namelen = sizeof(to);
+        msg.msg_control = control.data();
+        msg.msg_controllen = control.size();
+
+        if (::recvmsg(fd_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        ++send_errors_;
+        total_send_errors.fetch_add(1, std::memory_order_relaxed);
+        emit sendFailed(QHostAddress(ntohl(to.sin_addr.s_addr)),
+                        ntohs(to.sin_port));
+    }
+#endif
+}
+
+quint16 BatchedUdpSocket::localPort() const
+{
+#ifdef Q_OS_LINUX
+    if (fd_ < 0) {
+        return 0;
+    }
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+#else
+    return 0;
+#endif
+}
+
+uint64_t BatchedUdpSocket::sendErrors() const
+{
+    return send_errors_;
+}
+
+uint64_t BatchedUdpSocket::truncatedDatagrams() const
+{
+    return truncated_;
+}
+
+uint64_t BatchedUdpSocket::totalSendErrors()
+{
+    return total_send_errors.load(std::memory_order_relaxed);
+}
+
+uint64_t BatchedUdpSocket::totalTruncatedDatagrams()
+{
+    return total_truncated.load(std::memory_order_relaxed);
+}
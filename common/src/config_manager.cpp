@@ -1,5 +1,7 @@
 #include "config_manager.hpp"
 
+#include <algorithm>
+
 #include <QCommandLineParser>
 #include <QDebug>
 #include <QFileInfo>
@@ -53,12 +55,230 @@ HubSettings ConfigManager::parseHub(const YAML::Node& node)
     const std::string address = getRequired<std::string>(hub_node, "address");
 
     HubSettings hub_set(port, id, broadcast_id, virt_pos, address);
+    hub_set.grid_cell_size =
+        hub_node["grid_cell_size"].as<double>(hub_set.grid_cell_size);
+    hub_set.worker_threads =
+        std::max(1u, hub_node["worker_threads"].as<uint32_t>(1));
+    hub_set.udp_backend =
+        hub_node["udp_backend"].as<std::string>("datagram") == "batched"
+            ? UdpBackend::Batched
+            : UdpBackend::Datagram;
+    hub_set.payload_codec = parsePayloadCodec(
+        hub_node["payload_codec"].as<std::string>("qdatastream"));
+    hub_set.path_loss_model =
+        parsePathLossModel(hub_node["path_loss_model"].as<std::string>("none"));
+    hub_set.carrier_frequency_ghz =
+        hub_node["carrier_frequency_ghz"].as<double>(
+            hub_set.carrier_frequency_ghz);
+    if (hub_node["link_impairment"]) {
+        hub_set.link_impairment =
+            parseLinkImpairment(hub_node["link_impairment"]);
+    }
+    if (hub_node["interference"]) {
+        hub_set.interference = parseInterference(hub_node["interference"]);
+    }
+    if (hub_node["liveness"]) {
+        hub_set.liveness = parseLiveness(hub_node["liveness"]);
+    }
+    if (hub_node["capture"]) {
+        hub_set.capture = parseCapture(hub_node["capture"]);
+    }
+    if (hub_node["recording"]) {
+        hub_set.recording = parseRecording(hub_node["recording"]);
+    }
+    if (hub_node["metrics"]) {
+        hub_set.metrics = parseMetrics(hub_node["metrics"]);
+    }
+    if (hub_node["federation"]) {
+        hub_set.federation = parseFederation(hub_node["federation"]);
+    }
+    if (hub_node["shm_transport"]) {
+        hub_set.shm_transport = parseShmTransport(hub_node["shm_transport"]);
+    }
+    if (hub_node["bundling"]) {
+        hub_set.bundling = parseBundling(hub_node["bundling"]);
+    }
 
     qDebug() << "[ConfigManager]: Network settings parsed successfully";
 
     return hub_set;
 }
 
+PathLossModel ConfigManager::parsePathLossModel(const std::string& name)
+{
+    if (name == "free_space") {
+        return PathLossModel::FreeSpace;
+    }
+    if (name == "uma") {
+        return PathLossModel::UrbanMacro;
+    }
+    if (name == "umi") {
+        return PathLossModel::UrbanMicro;
+    }
+    if (name != "none") {
+        qWarning() << "[ConfigManager]: Unknown path_loss_model"
+                   << QString::fromStdString(name) << "- using radius only";
+    }
+    return PathLossModel::None;
+}
+
+PayloadCodec ConfigManager::parsePayloadCodec(const std::string& name)
+{
+    if (name == "per_aligned") {
+        return PayloadCodec::PerAligned;
+    }
+    if (name == "per_unaligned") {
+        return PayloadCodec::PerUnaligned;
+    }
+    if (name != "qdatastream") {
+        qWarning() << "[ConfigManager]: Unknown payload_codec"
+                   << QString::fromStdString(name) << "- using qdatastream";
+    }
+    return PayloadCodec::QDataStream;
+}
+
+LinkProfile ConfigManager::parseLinkProfile(const YAML::Node& node)
+{
+    LinkProfile profile;
+    profile.delay_ms = node["delay_ms"].as<double>(profile.delay_ms);
+    profile.jitter_ms = node["jitter_ms"].as<double>(profile.jitter_ms);
+    profile.loss_probability =
+        node["loss_probability"].as<double>(profile.loss_probability);
+    return profile;
+}
+
+LinkImpairmentSettings ConfigManager::parseLinkImpairment(
+    const YAML::Node& node)
+{
+    LinkImpairmentSettings settings;
+    settings.base = parseLinkProfile(node);
+    settings.delay_per_km_ms =
+        node["delay_per_km_ms"].as<double>(settings.delay_per_km_ms);
+
+    if (node["links"]) {
+        for (const auto& link : node["links"]) {
+            settings.links.push_back({getRequired<uint32_t>(link, "src"),
+                                      getRequired<uint32_t>(link, "dst"),
+                                      parseLinkProfile(link)});
+        }
+    }
+
+    return settings;
+}
+
+InterferenceSettings ConfigManager::parseInterference(const YAML::Node& node)
+{
+    InterferenceSettings interference;
+    interference.enabled = node["enabled"].as<bool>(interference.enabled);
+    interference.noise_floor_dbm =
+        node["noise_floor_dbm"].as<double>(interference.noise_floor_dbm);
+    interference.interference_range_m =
+        node["interference_range_m"].as<double>(
+            interference.interference_range_m);
+    interference.report_threshold_db =
+        node["report_threshold_db"].as<double>(
+            interference.report_threshold_db);
+    return interference;
+}
+
+LivenessSettings ConfigManager::parseLiveness(const YAML::Node& node)
+{
+    LivenessSettings liveness;
+    liveness.enabled = node["enabled"].as<bool>(liveness.enabled);
+    liveness.heartbeat_interval_ms =
+        node["heartbeat_interval_ms"].as<uint32_t>(
+            liveness.heartbeat_interval_ms);
+    liveness.node_timeout_ms =
+        node["node_timeout_ms"].as<uint32_t>(liveness.node_timeout_ms);
+    liveness.max_send_errors =
+        node["max_send_errors"].as<uint32_t>(liveness.max_send_errors);
+    liveness.quarantine_ms =
+        node["quarantine_ms"].as<uint32_t>(liveness.quarantine_ms);
+    return liveness;
+}
+
+CaptureSettings ConfigManager::parseCapture(const YAML::Node& node)
+{
+    CaptureSettings capture;
+    capture.enabled = node["enabled"].as<bool>(capture.enabled);
+    capture.path = node["path"].as<std::string>(capture.path);
+    capture.ring_capacity =
+        node["ring_capacity"].as<uint32_t>(capture.ring_capacity);
+    return capture;
+}
+
+TrafficRecordingSettings ConfigManager::parseRecording(const YAML::Node& node)
+{
+    TrafficRecordingSettings recording;
+    const std::string mode = node["mode"].as<std::string>("off");
+    if (mode == "record") {
+        recording.mode = TrafficMode::Record;
+    } else if (mode == "replay") {
+        recording.mode = TrafficMode::Replay;
+    } else if (mode != "off") {
+        qWarning() << "[ConfigManager]: Unknown recording mode"
+                   << QString::fromStdString(mode) << "- recording is off";
+    }
+    recording.path = node["path"].as<std::string>(recording.path);
+    recording.replay_speed =
+        node["replay_speed"].as<double>(recording.replay_speed);
+    recording.replay_output_path = node["replay_output_path"].as<std::string>(
+        recording.replay_output_path);
+    return recording;
+}
+
+MetricsSettings ConfigManager::parseMetrics(const YAML::Node& node)
+{
+    MetricsSettings metrics;
+    metrics.enabled = node["enabled"].as<bool>(metrics.enabled);
+    metrics.port = node["port"].as<uint16_t>(metrics.port);
+    return metrics;
+}
+
+ShmTransportSettings ConfigManager::parseShmTransport(const YAML::Node& node)
+{
+    ShmTransportSettings shm;
+    shm.enabled = node["enabled"].as<bool>(shm.enabled);
+    shm.ring_bytes = node["ring_bytes"].as<uint32_t>(shm.ring_bytes);
+    return shm;
+}
+
+BundlingSettings ConfigManager::parseBundling(const YAML::Node& node)
+{
+    BundlingSettings bundling;
+    bundling.enabled = node["enabled"].as<bool>(bundling.enabled);
+    bundling.max_datagram_bytes = node["max_datagram_bytes"].as<uint32_t>(
+        bundling.max_datagram_bytes);
+    return bundling;
+}
+
+FederationSettings ConfigManager::parseFederation(const YAML::Node& node)
+{
+    FederationSettings federation;
+    federation.enabled = node["enabled"].as<bool>(federation.enabled);
+    federation.region_id =
+        node["region_id"].as<uint32_t>(federation.region_id);
+    federation.border_margin_m =
+        node["border_margin_m"].as<double>(federation.border_margin_m);
+
+    if (node["regions"]) {
+        for (const auto& region_node : node["regions"]) {
+            HubRegion region;
+            region.id = getRequired<uint32_t>(region_node, "id");
+            region.min_x = getRequired<double>(region_node, "min_x");
+            region.min_y = getRequired<double>(region_node, "min_y");
+            region.max_x = getRequired<double>(region_node, "max_x");
+            region.max_y = getRequired<double>(region_node, "max_y");
+            region.address =
+                region_node["address"].as<std::string>(region.address);
+            region.port = getRequired<uint16_t>(region_node, "port");
+            federation.regions.push_back(region);
+        }
+    }
+
+    return federation;
+}
+
 UeSettings ConfigManager::parseUe(const YAML::Node& node,
                                   const HubSettings hub_set)
 {
@@ -72,14 +292,30 @@ UeSettings ConfigManager::parseUe(const YAML::Node& node,
 
     validateSection(node_set, "radio");
     const auto radio_node = node_set["radio"];
-    const int rfd = getRequired<int>(radio_node, "radio_frame_duration");
     const double tx_power_db = getRequired<double>(radio_node, "tx_power_db");
 
-    UeSettings ue_set{hub_set, RadioSettings{rfd, tx_power_db}, Cell{tac}};
+    UeSettings ue_set{hub_set, RadioSettings{tx_power_db}, Cell{tac}};
+    if (ue_node["host"]) {
+        ue_set.host = parseUeHost(ue_node["host"]);
+    }
 
     return ue_set;
 }
 
+UeHostSettings ConfigManager::parseUeHost(const YAML::Node& node)
+{
+    UeHostSettings host;
+    host.registration_batch_size =
+        node["registration_batch_size"].as<uint32_t>(
+            host.registration_batch_size);
+    host.registration_interval_ms =
+        node["registration_interval_ms"].as<uint32_t>(
+            host.registration_interval_ms);
+    host.placement_radius_m =
+        node["placement_radius_m"].as<double>(host.placement_radius_m);
+    return host;
+}
+
 GnbSettings ConfigManager::parseGnb(const YAML::Node& root,
                                     const HubSettings hub_set)
 {
@@ -94,15 +330,31 @@ GnbSettings ConfigManager::parseGnb(const YAML::Node& root,
 
     validateSection(node_set, "radio");
     const auto radio_node = node_set["radio"];
-    const int rfd = getRequired<int>(radio_node, "radio_frame_duration");
     const double tx_power_db = getRequired<double>(radio_node, "tx_power_db");
 
-    GnbSettings gnb_set{hub_set, RadioSettings{rfd, tx_power_db}, Cell{tac},
+    GnbSettings gnb_set{hub_set, RadioSettings{tx_power_db}, Cell{tac},
                         radius};
+    if (node["host"]) {
+        gnb_set.host = parseGnbHost(node["host"]);
+    }
 
     return gnb_set;
 }
 
+GnbHostSettings ConfigManager::parseGnbHost(const YAML::Node& node)
+{
+    GnbHostSettings host;
+    host.registrations_per_interval =
+        node["registrations_per_interval"].as<uint32_t>(
+            host.registrations_per_interval);
+    host.registration_interval_ms =
+        node["registration_interval_ms"].as<uint32_t>(
+            host.registration_interval_ms);
+    host.grid_spacing_m =
+        node["grid_spacing_m"].as<double>(host.grid_spacing_m);
+    return host;
+}
+
 SimulationSettings ConfigManager::parseSimulation(const YAML::Node& node)
 {
     validateSection(node, "simulation");
@@ -236,18 +488,40 @@ bool ConfigManager::initializeFromArgs(const QString& description,
                                     "Path to the configuration file.", "file",
                                     "config.yaml");
 
+    QCommandLineOption count_option(
+        "count",
+        "Run this many " + typeToString(node_type_) +
+            "s in one process, with consecutive IDs from --id-start",
+        "n");
+    QCommandLineOption id_start_option("id-start",
+                                       "First ID of a --count range", "id");
+
     parser.addOption(id_option);
     parser.addOption(configOption);
+    const bool can_host =
+        node_type_ == EntityType::UE || node_type_ == EntityType::GNB;
+    if (can_host) {
+        parser.addOption(count_option);
+        parser.addOption(id_start_option);
+    }
 
     parser.process(*QCoreApplication::instance());
 
-    if (!parser.isSet(id_option)) {
+    if (can_host && parser.isSet(count_option)) {
+        if (!parser.isSet(id_start_option)) {
+            qCritical() << "[ConfigManager]: --count needs --id-start.";
+            parser.showHelp(1);
+        }
+        host_range_ = HostRange{parser.value(id_start_option).toUInt(),
+                                parser.value(count_option).toUInt()};
+        node_id_ = host_range_->id_start;
+    } else if (!parser.isSet(id_option)) {
         qCritical() << "[ConfigManager]: node ID is required.";
         parser.showHelp(1);
+    } else {
+        node_id_ = parser.value(id_option).toUInt();
     }
 
-    node_id_ = parser.value(id_option).toUInt();
-
     QString configPath = parser.value(configOption);
     QFileInfo checkFile(configPath);
 
@@ -326,3 +600,27 @@ std::optional<UeRuntimeContext> ConfigManager::getUeContext() const
                 << node_id;
     return std::nullopt;
 }
+
+std::optional<HostRange> ConfigManager::getHostRange() const
+{
+    return host_range_;
+}
+
+std::optional<UeHostContext> ConfigManager::getUeHostContext() const
+{
+    if (!host_range_ || host_range_->count == 0) {
+        qCritical() << "[ConfigManager]: CRITICAL - UE host needs --count > 0";
+        return std::nullopt;
+    }
+    return UeHostContext{*host_range_, getUeSettings()};
+}
+
+std::optional<GnbHostContext> ConfigManager::getGnbHostContext() const
+{
+    if (!host_range_ || host_range_->count == 0) {
+        qCritical()
+            << "[ConfigManager]: CRITICAL - gNB host needs --count > 0";
+        return std::nullopt;
+    }
+    return GnbHostContext{*host_range_, getGnbSettings()};
+}
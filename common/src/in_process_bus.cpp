@@ -0,0 +1,88 @@
+#include "in_process_bus.hpp"
+
+#include <algorithm>
+
+#include <QHostAddress>
+#include <QMetaObject>
+#include <QMutexLocker>
+
+#include "udp_transport.hpp"
+
+InProcessBus& InProcessBus::instance()
+{
+    static InProcessBus bus;
+    return bus;
+}
+
+quint16 InProcessBus::bind(UdpTransport* transport, quint16 port,
+                           bool reuse_port)
+{
+    QMutexLocker locker(&mutex_);
+
+    if (port == 0) {
+        port = nextEphemeralPort();
+        if (port == 0) {
+            return 0;
+        }
+    }
+
+    Endpoint& endpoint = endpoints_[port];
+    if (!endpoint.transports.empty() &&
+        !(endpoint.is_shared && reuse_port)) {
+        return 0;
+    }
+
+    endpoint.is_shared = reuse_port;
+    endpoint.transports.push_back(transport);
+    return port;
+}
+
+void InProcessBus::unbind(UdpTransport* transport)
+{
+    QMutexLocker locker(&mutex_);
+
+    for (auto it = endpoints_.begin(); it != endpoints_.end();) {
+        auto& transports = it->second.transports;
+        transports.erase(
+            std::remove(transports.begin(), transports.end(), transport),
+            transports.end());
+        it = transports.empty() ? endpoints_.erase(it) : std::next(it);
+    }
+}
+
+bool InProcessBus::deliver(const QByteArray& data, quint16 sender_port,
+                           quint16 receiver_port)
+{
+    // Posting under the lock keeps the receiver alive until the call is
+    // queued; Qt discards it if the receiver is destroyed afterwards.
+    QMutexLocker locker(&mutex_);
+
+    const auto it = endpoints_.find(receiver_port);
+    if (it == endpoints_.end()) {
+        return false;
+    }
+
+    const auto& transports = it->second.transports;
+    UdpTransport* receiver = transports[sender_port % transports.size()];
+
+    return QMetaObject::invokeMethod(
+        receiver,
+        [receiver, data, sender_port]() {
+            receiver->receiveInProcess(data, sender_port);
+        },
+        Qt::QueuedConnection);
+}
+
+quint16 InProcessBus::nextEphemeralPort()
+{
+    constexpr uint32_t EPHEMERAL_RANGE = 65536 - FIRST_EPHEMERAL_PORT;
+
+    for (uint32_t attempt = 0; attempt < EPHEMERAL_RANGE; ++attempt) {
+        const quint16 port = next_ephemeral_;
+        next_ephemeral_ = port == 65535 ? FIRST_EPHEMERAL_PORT : port + 1;
+        if (endpoints_.find(port) == endpoints_.end()) {
+            return port;
+        }
+    }
+    return 0;
+}
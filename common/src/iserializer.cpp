@@ -0,0 +1,17 @@
+#include "iserializer.hpp"
+
+#include "per_serializer.hpp"
+#include "qdatastream_serializer.hpp"
+
+std::unique_ptr<ISerializer> makeSerializer(PayloadCodec codec)
+{
+    switch (codec) {
+        case PayloadCodec::PerAligned:
+            return std::make_unique<PerSerializer>(PerVariant::Aligned);
+        case PayloadCodec::PerUnaligned:
+            return std::make_unique<PerSerializer>(PerVariant::Unaligned);
+        case PayloadCodec::QDataStream:
+        default:
+            return std::make_unique<QDataStreamSerializer>();
+    }
+}
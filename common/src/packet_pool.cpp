@@ -0,0 +1,67 @@
+#include "packet_pool.hpp"
+
+#include <atomic>
+
+namespace {
+
+std::atomic<uint64_t> total_misses{0};
+
+}  // namespace
+
+PacketPool::PacketPool()
+{
+    // acquire() hands out references into buffers_, which must not move.
+    buffers_.reserve(MAX_BUFFERS);
+}
+
+PacketPool& PacketPool::local()
+{
+    thread_local PacketPool pool;
+    return pool;
+}
+
+uint64_t PacketPool::totalMisses()
+{
+    return total_misses.load(std::memory_order_relaxed);
+}
+
+QByteArray& PacketPool::acquire(int size)
+{
+    if (size <= BUFFER_SIZE) {
+        for (size_t checked = 0; checked < buffers_.size(); ++checked) {
+            QByteArray& buffer = buffers_[next_];
+            next_ = (next_ + 1) % buffers_.size();
+            if (buffer.isDetached()) {
+                buffer.resize(size);
+                return buffer;
+            }
+        }
+    }
+
+    recordMiss();
+    if (size > BUFFER_SIZE || buffers_.size() == MAX_BUFFERS) {
+        unpooled_ = QByteArray(size, Qt::Uninitialized);
+        return unpooled_;
+    }
+
+    QByteArray& buffer = buffers_.emplace_back();
+    buffer.reserve(BUFFER_SIZE);
+    buffer.resize(size);
+    return buffer;
+}
+
+uint64_t PacketPool::misses() const
+{
+    return misses_;
+}
+
+size_t PacketPool::bufferCount() const
+{
+    return buffers_.size();
+}
+
+void PacketPool::recordMiss()
+{
+    ++misses_;
+    total_misses.fetch_add(1, std::memory_order_relaxed);
+}
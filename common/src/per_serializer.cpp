@@ -0,0 +1,353 @@
+#include "per_serializer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "qdatastream_serializer.hpp"
+
+namespace {
+
+// Value ranges from TS 38.331 / 38.213 / 24.501.
+constexpr int64_t UE_IDENTITY_MAX = (int64_t{1} << 39) - 1;  // randomValue
+constexpr int64_t ESTABLISHMENT_CAUSE_MAX = 15;
+constexpr int64_t TIMING_ADVANCE_MAX = 3846;  // RAR TA command
+constexpr int64_t RRC_CONFIG_STATUS_MAX = 2;
+constexpr int64_t MCC_MNC_MAX = 999;
+constexpr int64_t PLMNS_MAX = 12;  // maxPLMN
+constexpr int64_t RSRP_MIN_DECI_DBM = -1560;
+constexpr int64_t RSRP_MAX_DECI_DBM = -310;
+constexpr int64_t Q_RX_LEV_MIN_DBM = -156;
+constexpr int64_t Q_RX_LEV_MAX_DBM = -31;
+constexpr int64_t REGISTRATION_STATUS_MAX = 2;
+constexpr int64_t U16_MAX = 0xFFFF;
+constexpr int64_t U32_MAX = 0xFFFFFFFF;
+
+QByteArray toByteArray(const PerBitWriter& writer)
+{
+    const auto& bytes = writer.bytes();
+    return QByteArray(reinterpret_cast<const char*>(bytes.data()),
+                      static_cast<int>(bytes.size()));
+}
+
+template <typename T>
+std::optional<T> finish(const PerBitReader& reader, const T& value)
+{
+    return reader.ok() ? std::optional<T>(value) : std::nullopt;
+}
+
+void writeString(PerBitWriter& writer, const QString& text)
+{
+    const QByteArray utf8 = text.toUtf8();
+    writer.writeOctetString(utf8.constData(), utf8.size());
+}
+
+QString readString(PerBitReader& reader)
+{
+    const std::string utf8 = reader.readOctetString();
+    return QString::fromUtf8(utf8.data(), static_cast<int>(utf8.size()));
+}
+
+void writePlmn(PerBitWriter& writer, const PlmnIdentity& plmn)
+{
+    writer.writeConstrained(plmn.mcc, 0, MCC_MNC_MAX);
+    writer.writeConstrained(plmn.mnc, 0, MCC_MNC_MAX);
+}
+
+PlmnIdentity readPlmn(PerBitReader& reader)
+{
+    PlmnIdentity plmn;
+    plmn.mcc = static_cast<uint32_t>(reader.readConstrained(0, MCC_MNC_MAX));
+    plmn.mnc = static_cast<uint32_t>(reader.readConstrained(0, MCC_MNC_MAX));
+    return plmn;
+}
+
+}  // namespace
+
+PerSerializer::PerSerializer(PerVariant variant)
+    : variant_(variant)
+{
+}
+
+PerBitWriter PerSerializer::writer() const
+{
+    return PerBitWriter(variant_);
+}
+
+PerBitReader PerSerializer::reader(const QByteArray& payload) const
+{
+    return PerBitReader(reinterpret_cast<const uint8_t*>(payload.constData()),
+                        static_cast<size_t>(payload.size()), variant_);
+}
+
+QByteArray PerSerializer::serializeRrcSetupRequest(
+    const RrcSetupRequest& info) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(
+        static_cast<int64_t>(info.ue_identity & UE_IDENTITY_MAX), 0,
+        UE_IDENTITY_MAX);
+    out.writeConstrained(info.cause, 0, ESTABLISHMENT_CAUSE_MAX);
+    return toByteArray(out);
+}
+
+std::optional<RrcSetupRequest> PerSerializer::deserializeRrcSetupRequest(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    RrcSetupRequest info;
+    info.ue_identity =
+        static_cast<uint64_t>(in.readConstrained(0, UE_IDENTITY_MAX));
+    info.cause =
+        static_cast<uint8_t>(in.readConstrained(0, ESTABLISHMENT_CAUSE_MAX));
+    return finish(in, info);
+}
+
+QByteArray PerSerializer::serializeRachPreamble(const uint16_t& ra_rnti) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(ra_rnti, 0, U16_MAX);
+    return toByteArray(out);
+}
+
+std::optional<RachPreambleInfo> PerSerializer::deserializeRachPreamble(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    RachPreambleInfo info{static_cast<rnti_t>(in.readConstrained(0, U16_MAX))};
+    return finish(in, info);
+}
+
+QByteArray PerSerializer::serializeRar(const RarInfo& info) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(info.ra_rnti, 0, U16_MAX);
+    out.writeConstrained(info.temp_c_rnti, 0, U16_MAX);
+    out.writeConstrained(info.timing_advance, 0, TIMING_ADVANCE_MAX);
+    return toByteArray(out);
+}
+
+std::optional<RarInfo> PerSerializer::deserializeRar(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    RarInfo info;
+    info.ra_rnti = static_cast<rnti_t>(in.readConstrained(0, U16_MAX));
+    info.temp_c_rnti = static_cast<rnti_t>(in.readConstrained(0, U16_MAX));
+    info.timing_advance =
+        static_cast<ta_index_t>(in.readConstrained(0, TIMING_ADVANCE_MAX));
+    return finish(in, info);
+}
+
+QByteArray PerSerializer::serializeRrcSetup(const RrcSetupInfo& info) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(
+        static_cast<int64_t>(info.received_identity & UE_IDENTITY_MAX), 0,
+        UE_IDENTITY_MAX);
+    out.writeConstrained(info.config_status, 0, RRC_CONFIG_STATUS_MAX);
+    return toByteArray(out);
+}
+
+std::optional<RrcSetupInfo> PerSerializer::deserializeRrcSetup(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    RrcSetupInfo info;
+    info.received_identity =
+        static_cast<quint64>(in.readConstrained(0, UE_IDENTITY_MAX));
+    info.config_status =
+        static_cast<uint8_t>(in.readConstrained(0, RRC_CONFIG_STATUS_MAX));
+    return finish(in, info);
+}
+
+QByteArray PerSerializer::serializeRrcSetupComplete(
+    const RrcSetupCompleteInfo& info) const
+{
+    PerBitWriter out = writer();
+    writePlmn(out, info.plmn);
+    return toByteArray(out);
+}
+
+std::optional<RrcSetupCompleteInfo> PerSerializer::deserializeRrcSetupComplete(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    RrcSetupCompleteInfo info{readPlmn(in)};
+    return finish(in, info);
+}
+
+QByteArray PerSerializer::serializeRrcRelease(
+    const RrcReleaseCause& cause) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(static_cast<int64_t>(cause), 0,
+                         static_cast<int64_t>(RrcReleaseCause::VoiceFallback));
+    return toByteArray(out);
+}
+
+std::optional<RrcReleaseCause> PerSerializer::deserializeRrcRelease(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    const auto cause = static_cast<RrcReleaseCause>(in.readConstrained(
+        0, static_cast<int64_t>(RrcReleaseCause::VoiceFallback)));
+    return finish(in, cause);
+}
+
+QByteArray PerSerializer::serializeRegistrationRequest(
+    const RegistrationRequestInfo& info) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(info.ue_id, 0, U32_MAX);
+    writeString(out, info.ue_cap);
+    return toByteArray(out);
+}
+
+std::optional<RegistrationRequestInfo>
+PerSerializer::deserializeRegistrationRequest(const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    RegistrationRequestInfo info;
+    info.ue_id = static_cast<uint32_t>(in.readConstrained(0, U32_MAX));
+    info.ue_cap = readString(in);
+    return finish(in, info);
+}
+
+QByteArray PerSerializer::serializeRegistrationAnswer(
+    const RegistrationAnswerInfo& info) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(static_cast<int64_t>(info.status), 0,
+                         REGISTRATION_STATUS_MAX);
+    out.writeBool(info.reject_reason.has_value());
+    if (info.reject_reason.has_value()) {
+        writeString(out, info.reject_reason.value());
+    }
+    return toByteArray(out);
+}
+
+std::optional<RegistrationAnswerInfo>
+PerSerializer::deserializeRegistrationAnswer(const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    RegistrationAnswerInfo info;
+    info.status = static_cast<RegistrationStatus>(
+        in.readConstrained(0, REGISTRATION_STATUS_MAX));
+    if (in.readBool()) {
+        info.reject_reason = readString(in);
+    }
+    return finish(in, info);
+}
+
+QByteArray PerSerializer::serializeMeasurementReport(
+    const MeasurementReportInfo& info) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(info.reported_gnb_id, 0, U32_MAX);
+    out.writeConstrained(std::lround(info.rsrp * 10.0), RSRP_MIN_DECI_DBM,
+                         RSRP_MAX_DECI_DBM);
+    return toByteArray(out);
+}
+
+std::optional<MeasurementReportInfo>
+PerSerializer::deserializeMeasurementReport(const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    MeasurementReportInfo info;
+    info.reported_gnb_id =
+        static_cast<uint32_t>(in.readConstrained(0, U32_MAX));
+    info.rsrp =
+        in.readConstrained(RSRP_MIN_DECI_DBM, RSRP_MAX_DECI_DBM) / 10.0;
+    return finish(in, info);
+}
+
+std::optional<RrcReconfigurationInfo>
+PerSerializer::deserializeRrcReconfiguration(const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    RrcReconfigurationInfo info{
+        static_cast<uint32_t>(in.readConstrained(0, U32_MAX))};
+    return finish(in, info);
+}
+
+QByteArray PerSerializer::serializeChatMessage(
+    const ChatMessageInfo& message) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(message.receiver_ue_id, 0, U32_MAX);
+    out.writeConstrained(message.sender_ue_id, 0, U32_MAX);
+    writeString(out, message.text);
+    return toByteArray(out);
+}
+
+std::optional<ChatMessageInfo> PerSerializer::deserializeChatMessage(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    ChatMessageInfo message;
+    message.receiver_ue_id =
+        static_cast<uint32_t>(in.readConstrained(0, U32_MAX));
+    message.sender_ue_id =
+        static_cast<uint32_t>(in.readConstrained(0, U32_MAX));
+    message.text = readString(in);
+    return finish(in, message);
+}
+
+QByteArray PerSerializer::serializeSB1Info(const SIB1Info& sib1) const
+{
+    const auto& cell = sib1.cell_config;
+    const size_t plmns_size =
+        std::min(cell.plmns.size(), static_cast<size_t>(PLMNS_MAX));
+
+    PerBitWriter out = writer();
+    out.writeConstrained(sib1.gnb_id, 0, U32_MAX);
+    out.writeConstrained(cell.tac, 0, U16_MAX);
+    out.writeConstrained(cell.minRxLevel, Q_RX_LEV_MIN_DBM, Q_RX_LEV_MAX_DBM);
+    out.writeConstrained(static_cast<int64_t>(plmns_size), 0, PLMNS_MAX);
+    for (size_t i = 0; i < plmns_size; ++i) {
+        writePlmn(out, cell.plmns[i]);
+    }
+    return toByteArray(out);
+}
+
+std::optional<SIB1Info> PerSerializer::deserializeSB1Info(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    SIB1Info sib1;
+    auto& cell = sib1.cell_config;
+    sib1.gnb_id = static_cast<uint32_t>(in.readConstrained(0, U32_MAX));
+    cell.tac = static_cast<uint16_t>(in.readConstrained(0, U16_MAX));
+    cell.minRxLevel = static_cast<int16_t>(
+        in.readConstrained(Q_RX_LEV_MIN_DBM, Q_RX_LEV_MAX_DBM));
+    cell.plmns_size = static_cast<uint8_t>(in.readConstrained(0, PLMNS_MAX));
+
+    cell.plmns.reserve(cell.plmns_size);
+    for (uint8_t i = 0; i < cell.plmns_size && in.ok(); ++i) {
+        cell.plmns.push_back(readPlmn(in));
+    }
+    return finish(in, sib1);
+}
+
+QByteArray PerSerializer::serializeRegistrationPayload(
+    const GnbRegistrationInfo& info) const
+{
+    return QDataStreamSerializer().serializeRegistrationPayload(info);
+}
+
+QByteArray PerSerializer::serializeTriggerHandover(
+    const HandoverInfo info) const
+{
+    PerBitWriter out = writer();
+    out.writeConstrained(info.gnb_id, 0, U32_MAX);
+    return toByteArray(out);
+}
+
+std::optional<HandoverInfo> PerSerializer::deserializeTriggerHandover(
+    const QByteArray& payload) const
+{
+    PerBitReader in = reader(payload);
+    HandoverInfo info{static_cast<uint32_t>(in.readConstrained(0, U32_MAX))};
+    return finish(in, info);
+}
@@ -78,3 +78,15 @@ UeRuntimeContext::UeRuntimeContext(uint32_t node_id, UeSettings settings,
     , set(settings)
 {
 }
+
+UeHostContext::UeHostContext(HostRange host_range, UeSettings settings)
+    : range(host_range)
+    , set(settings)
+{
+}
+
+GnbHostContext::GnbHostContext(HostRange host_range, GnbSettings settings)
+    : range(host_range)
+    , set(settings)
+{
+}
@@ -0,0 +1,276 @@
+#include "shm_channel.hpp"
+
+#include <atomic>
+#include <new>
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QSocketNotifier>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct alignas(ShmRingControl::CACHE_LINE) SegmentHeader {
+    std::atomic<uint32_t> magic{0};
+    uint32_t ring_bytes = 0;
+};
+
+constexpr size_t CONTROL_OFFSET = sizeof(SegmentHeader);
+constexpr size_t DATA_OFFSET = CONTROL_OFFSET + 2 * sizeof(ShmRingControl);
+
+size_t roundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 64;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+struct ShmChannel::Mapping {
+    QString name;
+    char* base = nullptr;
+    size_t size = 0;
+    size_t ring_bytes = 0;
+    // Node -> hub is "up", hub -> node is "down".
+    int up_bell = -1;
+    int down_bell = -1;
+
+    ShmRingControl* control(int direction) const
+    {
+        return reinterpret_cast<ShmRingControl*>(base + CONTROL_OFFSET) +
+               direction;
+    }
+
+    char* data(int direction) const
+    {
+        return base + DATA_OFFSET + direction * ring_bytes;
+    }
+
+    QByteArray doorbellPath(const char* direction) const
+    {
+        return QString("/dev/shm%1.%2")
+            .arg(name, QLatin1String(direction))
+            .toLocal8Bit();
+    }
+
+    ~Mapping()
+    {
+#ifdef Q_OS_LINUX
+        if (base) {
+            ::munmap(base, size);
+        }
+        if (up_bell >= 0) {
+            ::close(up_bell);
+        }
+        if (down_bell >= 0) {
+            ::close(down_bell);
+        }
+#endif
+    }
+};
+
+namespace {
+
+constexpr int UP = 0;
+constexpr int DOWN = 1;
+
+#ifdef Q_OS_LINUX
+int openDoorbell(const QByteArray& path, bool create)
+{
+    if (create) {
+        ::unlink(path.constData());
+        if (::mkfifo(path.constData(), 0600) < 0) {
+            return -1;
+        }
+    }
+    // O_RDWR keeps the FIFO open without a peer and never blocks.
+    return ::open(path.constData(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+}
+#endif
+
+}  // namespace
+
+QString ShmChannel::nameFor(quint16 hub_port, uint32_t node_id)
+{
+    return QString("/ransim-%1-%2").arg(hub_port).arg(node_id);
+}
+
+std::unique_ptr<ShmChannel> ShmChannel::create(const QString& name,
+                                               size_t ring_bytes)
+{
+#ifdef Q_OS_LINUX
+    auto mapping = std::make_unique<Mapping>();
+    mapping->name = name;
+    mapping->ring_bytes = roundUpToPowerOfTwo(ring_bytes);
+    mapping->size = DATA_OFFSET + 2 * mapping->ring_bytes;
+
+    const QByteArray shm_name = name.toLocal8Bit();
+    const int fd = ::shm_open(shm_name.constData(),
+                              O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+    const bool is_sized =
+        ::ftruncate(fd, static_cast<off_t>(mapping->size)) == 0;
+    void* base = is_sized ? ::mmap(nullptr, mapping->size,
+                                   PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                          : MAP_FAILED;
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        ::shm_unlink(shm_name.constData());
+        return nullptr;
+    }
+    mapping->base = static_cast<char*>(base);
+
+    auto* header = new (mapping->base) SegmentHeader;
+    new (mapping->control(UP)) ShmRingControl;
+    new (mapping->control(DOWN)) ShmRingControl;
+    header->ring_bytes = static_cast<uint32_t>(mapping->ring_bytes);
+
+    mapping->up_bell = openDoorbell(mapping->doorbellPath("up"), true);
+    mapping->down_bell = openDoorbell(mapping->doorbellPath("down"), true);
+    if (mapping->up_bell < 0 || mapping->down_bell < 0) {
+        ::shm_unlink(shm_name.constData());
+        return nullptr;
+    }
+
+    // Published last: the hub refuses a segment that is not ready yet.
+    header->magic.store(MAGIC, std::memory_order_release);
+    return std::unique_ptr<ShmChannel>(
+        new ShmChannel(std::move(mapping), true));
+#else
+    Q_UNUSED(name);
+    Q_UNUSED(ring_bytes);
+    return nullptr;
+#endif
+}
+
+std::unique_ptr<ShmChannel> ShmChannel::attach(const QString& name)
+{
+#ifdef Q_OS_LINUX
+    auto mapping = std::make_unique<Mapping>();
+    mapping->name = name;
+
+    const int fd =
+        ::shm_open(name.toLocal8Bit().constData(), O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info{};
+    const bool has_size = ::fstat(fd, &info) == 0 &&
+                          static_cast<size_t>(info.st_size) > DATA_OFFSET;
+    void* base =
+        has_size ? ::mmap(nullptr, static_cast<size_t>(info.st_size),
+                          PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                 : MAP_FAILED;
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return nullptr;
+    }
+    mapping->base = static_cast<char*>(base);
+    mapping->size = static_cast<size_t>(info.st_size);
+
+    const auto* header = reinterpret_cast<SegmentHeader*>(mapping->base);
+    mapping->ring_bytes = header->ring_bytes;
+    const bool is_power_of_two =
+        mapping->ring_bytes != 0 &&
+        (mapping->ring_bytes & (mapping->ring_bytes - 1)) == 0;
+    if (header->magic.load(std::memory_order_acquire) != MAGIC ||
+        !is_power_of_two ||
+        DATA_OFFSET + 2 * mapping->ring_bytes != mapping->size) {
+        qWarning() << "ShmChannel: segment" << name << "is not usable";
+        return nullptr;
+    }
+
+    mapping->up_bell = openDoorbell(mapping->doorbellPath("up"), false);
+    mapping->down_bell = openDoorbell(mapping->doorbellPath("down"), false);
+    if (mapping->up_bell < 0 || mapping->down_bell < 0) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<ShmChannel>(
+        new ShmChannel(std::move(mapping), false));
+#else
+    Q_UNUSED(name);
+    return nullptr;
+#endif
+}
+
+ShmChannel::ShmChannel(std::unique_ptr<Mapping> mapping, bool is_owner)
+    : mapping_(std::move(mapping))
+    , is_owner_(is_owner)
+    , tx_(mapping_->control(is_owner ? UP : DOWN),
+          mapping_->data(is_owner ? UP : DOWN), mapping_->ring_bytes)
+    , rx_(mapping_->control(is_owner ? DOWN : UP),
+          mapping_->data(is_owner ? DOWN : UP), mapping_->ring_bytes)
+{
+}
+
+ShmChannel::~ShmChannel()
+{
+#ifdef Q_OS_LINUX
+    if (is_owner_) {
+        ::shm_unlink(mapping_->name.toLocal8Bit().constData());
+        ::unlink(mapping_->doorbellPath("up").constData());
+        ::unlink(mapping_->doorbellPath("down").constData());
+    }
+#endif
+}
+
+bool ShmChannel::send(const QByteArray& data)
+{
+    QMutexLocker locker(&tx_mutex_);
+
+    if (!tx_.push(data.constData(), static_cast<size_t>(data.size()))) {
+        return false;
+    }
+#ifdef Q_OS_LINUX
+    if (tx_.needsWakeup()) {
+        const char bell = 1;
+        // EAGAIN means the doorbell is already ringing.
+        [[maybe_unused]] const ssize_t rung = ::write(
+            is_owner_ ? mapping_->up_bell : mapping_->down_bell, &bell, 1);
+    }
+#endif
+    return true;
+}
+
+void ShmChannel::listen()
+{
+    if (notifier_) {
+        return;
+    }
+    notifier_ = new QSocketNotifier(
+        is_owner_ ? mapping_->down_bell : mapping_->up_bell,
+        QSocketNotifier::Read, this);
+    connect(notifier_, &QSocketNotifier::activated, this,
+            &ShmChannel::onDoorbell);
+
+    // Drains what arrived before and arms the doorbell.
+    onDoorbell();
+}
+
+void ShmChannel::onDoorbell()
+{
+#ifdef Q_OS_LINUX
+    char bells[64];
+    const int fd = is_owner_ ? mapping_->down_bell : mapping_->up_bell;
+    while (::read(fd, bells, sizeof(bells)) > 0) {
+    }
+#endif
+
+    do {
+        rx_.drain([this](const char* data, size_t size) {
+            emit datagramReceived(QByteArray(data, static_cast<int>(size)));
+        });
+    } while (!rx_.prepareToSleep());
+}
@@ -1,63 +1,264 @@
 #include "sim_protocol.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <QtEndian>
+
+#include "packet_pool.hpp"
+
 namespace SimProtocol {
 
-const size_t MIN_HEADER_SIZE = 10;
+namespace {
+
+double readBigEndianDouble(const char* data)
+{
+    const quint64 bits = qFromBigEndian<quint64>(data);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void writeBigEndianDouble(double value, char* out)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    qToBigEndian<quint64>(bits, out);
+}
+
+static_assert(SRC_ID_OFFSET % 4 == 0 && DST_ID_OFFSET % 4 == 0 &&
+                  POS_X_OFFSET % 4 == 0 && POS_Y_OFFSET % 4 == 0,
+              "SimProtocol header fields must stay aligned");
+static_assert(POS_Y_OFFSET + static_cast<int>(sizeof(double)) == HEADER_SIZE,
+              "SimProtocol header size does not match its fields");
 
-QByteArray buildPacket(uint32_t src, EntityType nodeType, uint32_t dst,
+}  // namespace
+
+void writeHeader(char* out, uint32_t src, EntityType entity_type,
+                 uint32_t dst, SimMessageType type, const QPointF& position)
+{
+    out[VERSION_OFFSET] = static_cast<char>(VERSION);
+    out[MSG_TYPE_OFFSET] = static_cast<char>(type);
+    out[NODE_TYPE_OFFSET] = static_cast<char>(entity_type);
+    out[FLAGS_OFFSET] = 0;
+    qToBigEndian<quint32>(src, out + SRC_ID_OFFSET);
+    qToBigEndian<quint32>(dst, out + DST_ID_OFFSET);
+    writeBigEndianDouble(position.x(), out + POS_X_OFFSET);
+    writeBigEndianDouble(position.y(), out + POS_Y_OFFSET);
+}
+
+QByteArray buildPacket(uint32_t src, EntityType entity_type, uint32_t dst,
                        SimMessageType type, const QPointF& position,
                        const QByteArray& payload)
 {
-    QByteArray packet;
-    packet.reserve(MIN_HEADER_SIZE + payload.size());
+    QByteArray& packet =
+        PacketPool::local().acquire(HEADER_SIZE + payload.size());
+    char* raw = packet.data();
+    if (!payload.isEmpty()) {
+        std::memcpy(raw + HEADER_SIZE, payload.constData(), payload.size());
+    }
+    writeHeader(raw, src, entity_type, dst, type, position);
+    return packet;
+}
 
-    QDataStream ds(&packet, QIODevice::WriteOnly);
-    ds.setByteOrder(QDataStream::BigEndian);
+QByteArray buildDataPacket(uint32_t src, EntityType entity_type,
+                           uint32_t dst, const QPointF& position,
+                           ProtocolMsgType protocol_type,
+                           const QByteArray& payload)
+{
+    QByteArray& packet =
+        PacketPool::local().acquire(PROTOCOL_TYPE_OFFSET + 1 + payload.size());
+    char* raw = packet.data();
+    if (!payload.isEmpty()) {
+        std::memcpy(raw + PROTOCOL_TYPE_OFFSET + 1, payload.constData(),
+                    payload.size());
+    }
+    raw[PROTOCOL_TYPE_OFFSET] = static_cast<char>(protocol_type);
+    writeHeader(raw, src, entity_type, dst, SimMessageType::Data, position);
+    return packet;
+}
 
-    ds << src;
-    ds << nodeType;
-    ds << dst;
-    ds << static_cast<uint8_t>(type);
-    ds << position.x();
-    ds << position.y();
+QByteArray BundlePdu::payload() const
+{
+    return QByteArray::fromRawData(data, size);
+}
 
-    if (!payload.isEmpty()) {
-        ds.writeRawData(payload.constData(), payload.size());
+int bundlePacketSize(const std::vector<BundlePdu>& pdus)
+{
+    int size = HEADER_SIZE + BUNDLE_COUNT_SIZE;
+    for (const BundlePdu& pdu : pdus) {
+        size += BUNDLE_PDU_HEADER_SIZE + pdu.size;
     }
+    return size;
+}
 
+QByteArray buildBundlePacket(uint32_t src, EntityType entity_type,
+                             uint32_t dst, const QPointF& position,
+                             const std::vector<BundlePdu>& pdus)
+{
+    Q_ASSERT(static_cast<int>(pdus.size()) <= MAX_BUNDLE_PDUS);
+
+    QByteArray& packet = PacketPool::local().acquire(bundlePacketSize(pdus));
+    char* raw = packet.data();
+
+    char* out = raw + HEADER_SIZE;
+    *out++ = static_cast<char>(pdus.size());
+    for (const BundlePdu& pdu : pdus) {
+        Q_ASSERT(pdu.size <= MAX_BUNDLE_PDU_SIZE);
+        qToBigEndian<quint32>(pdu.dstId, out);
+        out[4] = static_cast<char>(pdu.type);
+        qToBigEndian<quint16>(static_cast<quint16>(pdu.size), out + 5);
+        out += BUNDLE_PDU_HEADER_SIZE;
+        if (pdu.size > 0) {
+            std::memcpy(out, pdu.data, pdu.size);
+            out += pdu.size;
+        }
+    }
+    writeHeader(raw, src, entity_type, dst, SimMessageType::Bundle, position);
     return packet;
 }
 
+bool parseBundle(const PacketView& packet, std::vector<BundlePdu>& pdus)
+{
+    pdus.clear();
+    if (!packet.isValid || packet.type != SimMessageType::Bundle ||
+        packet.payloadSize < BUNDLE_COUNT_SIZE) {
+        return false;
+    }
+
+    const char* pos = packet.payloadData;
+    const char* const end = pos + packet.payloadSize;
+    const int count = static_cast<uint8_t>(*pos++);
+    pdus.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (end - pos < BUNDLE_PDU_HEADER_SIZE) {
+            pdus.clear();
+            return false;
+        }
+        BundlePdu pdu;
+        pdu.dstId = qFromBigEndian<quint32>(pos);
+        pdu.type = static_cast<ProtocolMsgType>(pos[4]);
+        pdu.size = qFromBigEndian<quint16>(pos + 5);
+        pos += BUNDLE_PDU_HEADER_SIZE;
+        if (end - pos < pdu.size) {
+            pdus.clear();
+            return false;
+        }
+        pdu.data = pos;
+        pos += pdu.size;
+        pdus.push_back(pdu);
+    }
+    if (pos != end) {
+        pdus.clear();
+        return false;
+    }
+    return true;
+}
+
+QByteArray readdress(const QByteArray& packet, uint32_t dst)
+{
+    QByteArray& copy = PacketPool::local().acquire(packet.size());
+    std::memcpy(copy.data(), packet.constData(), packet.size());
+    if (copy.size() >= HEADER_SIZE) {
+        qToBigEndian<quint32>(dst, copy.data() + DST_ID_OFFSET);
+    }
+    return copy;
+}
+
 DecodedPacket parse(const QByteArray& data)
 {
     DecodedPacket result;
-
-    if (data.size() < MIN_HEADER_SIZE) {
-        result.isValid = false;
+    const PacketView packet = view(data);
+    if (!packet.isValid) {
         return result;
     }
 
-    QDataStream ds(data);
-    ds.setByteOrder(QDataStream::BigEndian);
+    result.srcId = packet.srcId;
+    result.dstId = packet.dstId;
+    result.type = packet.type;
+    result.nodeType = packet.nodeType;
+    result.position = packet.position;
+    result.payload = QByteArray(packet.payloadData, packet.payloadSize);
+    result.isValid = true;
+    return result;
+}
 
-    uint8_t rawType;
-    ds >> result.srcId;
-    ds >> result.nodeType;
-    ds >> result.dstId;
-    ds >> rawType;
-    result.type = static_cast<SimMessageType>(rawType);
-    double position_x{};
-    ds >> position_x;
-    double position_y{};
-    ds >> position_y;
+HeaderView peekHeader(const QByteArray& data)
+{
+    HeaderView header;
 
-    result.position = QPointF(position_x, position_y);
+    if (data.size() < HEADER_SIZE ||
+        static_cast<uint8_t>(data[VERSION_OFFSET]) != VERSION) {
+        return header;
+    }
 
-    int headerSize = ds.device()->pos();
-    result.payload = data.mid(headerSize);
+    const char* raw = data.constData();
+    header.srcId = qFromBigEndian<quint32>(raw + SRC_ID_OFFSET);
+    header.nodeType = static_cast<EntityType>(raw[NODE_TYPE_OFFSET]);
+    header.dstId = qFromBigEndian<quint32>(raw + DST_ID_OFFSET);
+    header.type = static_cast<SimMessageType>(raw[MSG_TYPE_OFFSET]);
+    header.position = QPointF(readBigEndianDouble(raw + POS_X_OFFSET),
+                              readBigEndianDouble(raw + POS_Y_OFFSET));
+    header.isValid = true;
+    return header;
+}
 
-    result.isValid = true;
-    return result;
+PacketView view(const QByteArray& data)
+{
+    PacketView packet;
+    static_cast<HeaderView&>(packet) = peekHeader(data);
+    if (packet.isValid) {
+        packet.payloadData = data.constData() + HEADER_SIZE;
+        packet.payloadSize = static_cast<int>(data.size()) - HEADER_SIZE;
+    }
+    return packet;
+}
+
+ProtocolMsgType peekProtocolType(const QByteArray& data)
+{
+    if (data.size() <= PROTOCOL_TYPE_OFFSET ||
+        static_cast<SimMessageType>(data[MSG_TYPE_OFFSET]) !=
+            SimMessageType::Data) {
+        return ProtocolMsgType::Unknown;
+    }
+    return static_cast<ProtocolMsgType>(data[PROTOCOL_TYPE_OFFSET]);
+}
+
+bool PacketView::isForMe(uint32_t myId, uint32_t broadcast_id) const
+{
+    return isValid && (dstId == myId || dstId == broadcast_id);
+}
+
+QByteArray PacketView::payload() const
+{
+    return QByteArray::fromRawData(payloadData, payloadSize);
+}
+
+ProtocolMsgType PacketView::protocolType() const
+{
+    if (type != SimMessageType::Data || payloadSize < 1) {
+        return ProtocolMsgType::Unknown;
+    }
+    return static_cast<ProtocolMsgType>(payloadData[0]);
+}
+
+QByteArray PacketView::protocolPayload() const
+{
+    if (payloadSize < 1) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(payloadData + 1, payloadSize - 1);
+}
+
+bool HeaderView::isForHub(const uint32_t hub_id) const
+{
+    return isValid && (dstId == hub_id);
+}
+
+bool HeaderView::isBroadcast(const uint32_t broadcast_id) const
+{
+    return isValid && (dstId == broadcast_id);
 }
 
 bool DecodedPacket::isForMe(uint32_t myId, uint32_t broadcast_id) const
@@ -101,4 +302,175 @@ double parseRadius(const QByteArray& data)
     return radius;
 }
 
+GnbRegistrationInfo parseGnbRegistration(const QByteArray& data)
+{
+    GnbRegistrationInfo info;
+    info.radius = parseRadius(data);
+
+    const int full_size = 2 * sizeof(double) + sizeof(int16_t);
+    if (data.size() < full_size) {
+        return info;
+    }
+
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    double radius = 0.0;
+    stream >> radius >> info.tx_power_dbm >> info.min_rx_level;
+
+    return info;
+}
+
+QByteArray buildHubRedirectPayload(const QHostAddress& address, quint16 port,
+                                   bool must_register)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::BigEndian);
+    stream << address.toIPv4Address() << port
+           << static_cast<quint8>(must_register ? 1 : 0);
+    return payload;
+}
+
+HubRedirect parseHubRedirect(const QByteArray& data)
+{
+    HubRedirect redirect;
+    const int full_size = sizeof(quint32) + sizeof(quint16) + sizeof(quint8);
+    if (data.size() < full_size) {
+        return redirect;
+    }
+
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    quint32 ipv4 = 0;
+    quint8 must_register = 0;
+    stream >> ipv4 >> redirect.port >> must_register;
+
+    redirect.address = QHostAddress(ipv4);
+    redirect.mustRegister = must_register != 0;
+    redirect.isValid = redirect.port != 0;
+    return redirect;
+}
+
+namespace {
+
+// SinrReport and RsrpReport: u16 count, then a u32 id and an i16 in 0.1 dB
+// steps per sample.
+template <typename Sample, uint32_t Sample::*Id, double Sample::*Db>
+QByteArray buildDbReport(const std::vector<Sample>& samples)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    stream << static_cast<quint16>(samples.size());
+    for (const Sample& sample : samples) {
+        const double tenths =
+            std::clamp(std::round(sample.*Db * 10.0), -32768.0, 32767.0);
+        stream << sample.*Id << static_cast<qint16>(tenths);
+    }
+    return payload;
+}
+
+template <typename Sample, uint32_t Sample::*Id, double Sample::*Db>
+std::vector<Sample> parseDbReport(const QByteArray& data)
+{
+    std::vector<Sample> samples;
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    quint16 count = 0;
+    stream >> count;
+    samples.reserve(count);
+    for (quint16 i = 0; i < count; ++i) {
+        Sample sample;
+        qint16 tenths = 0;
+        stream >> sample.*Id >> tenths;
+        if (stream.status() != QDataStream::Ok) {
+            break;
+        }
+        sample.*Db = tenths / 10.0;
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+}  // namespace
+
+QByteArray buildSinrReportPayload(const std::vector<SinrSample>& samples)
+{
+    return buildDbReport<SinrSample, &SinrSample::ueId, &SinrSample::sinrDb>(
+        samples);
+}
+
+std::vector<SinrSample> parseSinrReport(const QByteArray& data)
+{
+    return parseDbReport<SinrSample, &SinrSample::ueId, &SinrSample::sinrDb>(
+        data);
+}
+
+QByteArray buildRsrpReportPayload(const std::vector<RsrpSample>& samples)
+{
+    return buildDbReport<RsrpSample, &RsrpSample::gnbId,
+                         &RsrpSample::rsrpDbm>(samples);
+}
+
+std::vector<RsrpSample> parseRsrpReport(const QByteArray& data)
+{
+    return parseDbReport<RsrpSample, &RsrpSample::gnbId,
+                         &RsrpSample::rsrpDbm>(data);
+}
+
+namespace {
+
+constexpr int BATCH_COUNT_SIZE = sizeof(quint16);
+constexpr int BATCHED_NODE_SIZE = sizeof(quint32) + 2 * sizeof(double);
+
+}  // namespace
+
+QByteArray buildRegistrationBatchPayload(
+    const std::vector<BatchedNode>& nodes)
+{
+    const int count = static_cast<int>(
+        std::min<size_t>(nodes.size(), MAX_REGISTRATION_BATCH));
+    QByteArray& payload = PacketPool::local().acquire(
+        BATCH_COUNT_SIZE + count * BATCHED_NODE_SIZE);
+
+    char* out = payload.data();
+    qToBigEndian<quint16>(static_cast<quint16>(count), out);
+    out += BATCH_COUNT_SIZE;
+    for (int i = 0; i < count; ++i) {
+        qToBigEndian<quint32>(nodes[i].id, out);
+        writeBigEndianDouble(nodes[i].position.x(), out + 4);
+        writeBigEndianDouble(nodes[i].position.y(), out + 12);
+        out += BATCHED_NODE_SIZE;
+    }
+    return payload;
+}
+
+std::vector<BatchedNode> parseRegistrationBatch(const QByteArray& data)
+{
+    std::vector<BatchedNode> nodes;
+    if (data.size() < BATCH_COUNT_SIZE) {
+        return nodes;
+    }
+
+    const char* pos = data.constData();
+    const int count = qFromBigEndian<quint16>(pos);
+    pos += BATCH_COUNT_SIZE;
+    const int available =
+        (static_cast<int>(data.size()) - BATCH_COUNT_SIZE) / BATCHED_NODE_SIZE;
+    nodes.reserve(std::min(count, available));
+    for (int i = 0; i < count && i < available; ++i) {
+        BatchedNode node;
+        node.id = qFromBigEndian<quint32>(pos);
+        node.position = QPointF(readBigEndianDouble(pos + 4),
+                                readBigEndianDouble(pos + 12));
+        nodes.push_back(node);
+        pos += BATCHED_NODE_SIZE;
+    }
+    return nodes;
+}
+
 }  // namespace SimProtocol
@@ -0,0 +1,134 @@
+#include "timer_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <QTimer>
+
+TimerScheduler::TimerScheduler(QObject* parent, Clock clock)
+    : QObject(parent)
+    , clock_(std::move(clock))
+{
+    if (clock_) {
+        return;
+    }
+    elapsed_.start();
+    timer_ = new QTimer(this);
+    timer_->setSingleShot(true);
+    timer_->setTimerType(Qt::PreciseTimer);
+    connect(timer_, &QTimer::timeout, this, &TimerScheduler::onTimer);
+}
+
+TimerScheduler& TimerScheduler::local()
+{
+    thread_local TimerScheduler scheduler;
+    return scheduler;
+}
+
+TimerScheduler::TimerId TimerScheduler::schedule(uint32_t delay_ms,
+                                                 Callback callback)
+{
+    const uint64_t now = nowMs();
+    // The wheel only moves when timers fire; catch it up after idle time
+    // so the deadline is placed from the present. Nothing is due before
+    // next_due_ms_, so this runs no callbacks.
+    if (!is_firing_ && next_due_ms_ > now) {
+        wheel_.advance(now, [](Callback&&) {});
+    }
+
+    const TimerId id = wheel_.schedule(now + delay_ms, std::move(callback));
+    // Due deadlines fire on the wheel's next tick.
+    const uint64_t deadline = std::max(now + delay_ms, wheel_.now() + 1);
+    if (deadline < next_due_ms_) {
+        next_due_ms_ = deadline;
+        if (!is_firing_) {
+            armTimer();
+        }
+    }
+    return id;
+}
+
+bool TimerScheduler::cancel(TimerId id)
+{
+    return wheel_.cancel(id);
+}
+
+size_t TimerScheduler::fireDue()
+{
+    is_firing_ = true;
+    const size_t fired =
+        wheel_.advance(nowMs(), [](Callback&& callback) { callback(); });
+    is_firing_ = false;
+    next_due_ms_ = wheel_.nextWakeup();
+    return fired;
+}
+
+size_t TimerScheduler::pending() const
+{
+    return wheel_.size();
+}
+
+uint64_t TimerScheduler::wakeups() const
+{
+    return wakeups_;
+}
+
+uint64_t TimerScheduler::nowMs() const
+{
+    return clock_ ? clock_() : static_cast<uint64_t>(elapsed_.elapsed());
+}
+
+void TimerScheduler::onTimer()
+{
+    ++wakeups_;
+    fireDue();
+    armTimer();
+}
+
+void TimerScheduler::armTimer()
+{
+    if (!timer_) {
+        return;
+    }
+    if (next_due_ms_ == TimingWheel<Callback>::NEVER) {
+        timer_->stop();
+        return;
+    }
+
+    const uint64_t now = nowMs();
+    timer_->start(next_due_ms_ > now ? static_cast<int>(next_due_ms_ - now)
+                                     : 0);
+}
+
+Deadline::Deadline(TimerScheduler& scheduler)
+    : scheduler_(scheduler)
+{
+}
+
+Deadline::~Deadline()
+{
+    stop();
+}
+
+void Deadline::start(uint32_t delay_ms, TimerScheduler::Callback on_expire)
+{
+    stop();
+    timer_ = scheduler_.schedule(
+        delay_ms, [this, on_expire = std::move(on_expire)]() {
+            timer_ = TimerScheduler::INVALID_TIMER;
+            on_expire();
+        });
+}
+
+void Deadline::stop()
+{
+    if (timer_ != TimerScheduler::INVALID_TIMER) {
+        scheduler_.cancel(timer_);
+        timer_ = TimerScheduler::INVALID_TIMER;
+    }
+}
+
+bool Deadline::isActive() const
+{
+    return timer_ != TimerScheduler::INVALID_TIMER;
+}
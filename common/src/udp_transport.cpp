@@ -2,6 +2,15 @@
 
 #include <QNetworkDatagram>
 
+#include "batched_udp_socket.hpp"
+#include "in_process_bus.hpp"
+
+#ifdef Q_OS_LINUX
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 bool sendingResult::sendingResult::ok() const
 {
     return is_socket_error_;
@@ -15,9 +24,17 @@ QString sendingResult::sendingResult::toString() const
     return QString("Error %1").arg(socket_error_);
 }
 
-UdpTransport::UdpTransport(QObject* parent)
+UdpTransport::UdpTransport(QObject* parent, UdpBackend backend)
     : QObject(parent)
+    , backend_(backend)
+{
+}
+
+UdpTransport::~UdpTransport()
 {
+    if (in_process_port_ != 0) {
+        InProcessBus::instance().unbind(this);
+    }
 }
 
 sendingResult UdpTransport::sendData(const QByteArray& data,
@@ -26,6 +43,37 @@ sendingResult UdpTransport::sendData(const QByteArray& data,
 {
     sendingResult sending_result;
 
+    if (in_process_port_ != 0) {
+        // The bus matches on port alone: it only stands in for loopback.
+        if (!receiver_ip.isLoopback()) {
+            sending_result.bytes_ = -1;
+            sending_result.is_socket_error_ = true;
+            sending_result.socket_error_ =
+                "in-process transport cannot reach " + receiver_ip.toString();
+            return sending_result;
+        }
+        if (InProcessBus::instance().deliver(data, in_process_port_,
+                                             receiver_port)) {
+            sending_result.bytes_ = data.size();
+        } else {
+            sending_result.bytes_ = -1;
+            sending_result.is_socket_error_ = true;
+            sending_result.socket_error_ = "no in-process receiver";
+        }
+        return sending_result;
+    }
+
+    if (batched_) {
+        if (batched_->queue(data, receiver_ip, receiver_port)) {
+            sending_result.bytes_ = data.size();
+        } else {
+            sending_result.bytes_ = -1;
+            sending_result.is_socket_error_ = true;
+            sending_result.socket_error_ = "unsupported receiver address";
+        }
+        return sending_result;
+    }
+
     sending_result.bytes_ =
         socket_->writeDatagram(data, receiver_ip, receiver_port);
     if (sending_result.bytes_ < 0) {
@@ -36,15 +84,56 @@ sendingResult UdpTransport::sendData(const QByteArray& data,
     return sending_result;
 }
 
-bool UdpTransport::init(quint16 listen_port)
+bool UdpTransport::init(quint16 listen_port, bool reuse_port)
+{
+    qRegisterMetaType<QHostAddress>("QHostAddress");
+
+    if (backend_ == UdpBackend::InProcess) {
+        if (in_process_port_ == 0) {
+            in_process_port_ = InProcessBus::instance().bind(
+                this, listen_port, reuse_port);
+        }
+        if (in_process_port_ == 0) {
+            qWarning() << "UdpTransport: in-process port" << listen_port
+                       << "is already bound";
+            return false;
+        }
+        qDebug() << "UdpTransport: in-process endpoint on port"
+                 << in_process_port_;
+        return true;
+    }
+
+    if (backend_ == UdpBackend::Batched && !batched_) {
+        auto* batched = new BatchedUdpSocket(this);
+        if (batched->bind(listen_port, reuse_port)) {
+            batched_ = batched;
+            connect(batched_, &BatchedUdpSocket::datagramReceived, this,
+                    &UdpTransport::dataReceived);
+            connect(batched_, &BatchedUdpSocket::sendFailed, this,
+                    &UdpTransport::sendFailed);
+            qDebug() << "UdpTransport: batched I/O listening on port"
+                     << batched_->localPort();
+            return true;
+        }
+        delete batched;
+        qWarning() << "UdpTransport: batched backend unavailable on port"
+                   << listen_port << "- falling back to QUdpSocket";
+    }
+
+    return initDatagram(listen_port, reuse_port);
+}
+
+bool UdpTransport::initDatagram(quint16 listen_port, bool reuse_port)
 {
     if (!socket_) {
         socket_ = new QUdpSocket(this);
     }
 
-    qRegisterMetaType<QHostAddress>("QHostAddress");
+    const bool is_bound = reuse_port
+                              ? bindSharedPort(listen_port)
+                              : socket_->bind(QHostAddress::Any, listen_port);
 
-    if (socket_->bind(QHostAddress::Any, listen_port)) {
+    if (is_bound) {
         connect(socket_, &QUdpSocket::readyRead, this,
                 &UdpTransport::readPendingDatagrams);
         qDebug() << "UdpTransport: successfully listening on port"
@@ -57,6 +146,37 @@ bool UdpTransport::init(quint16 listen_port)
     }
 }
 
+bool UdpTransport::bindSharedPort(quint16 listen_port)
+{
+#ifdef Q_OS_LINUX
+    const int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    const int enable = 1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(listen_port);
+
+    if (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) <
+            0 ||
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) <
+            0 ||
+        ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return false;
+    }
+
+    return socket_->setSocketDescriptor(fd, QAbstractSocket::BoundState);
+#else
+    return socket_->bind(
+        QHostAddress::Any, listen_port,
+        QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint);
+#endif
+}
+
 void UdpTransport::readPendingDatagrams()
 {
     while (socket_->hasPendingDatagrams()) {
@@ -68,7 +188,30 @@ void UdpTransport::readPendingDatagrams()
     }
 }
 
+void UdpTransport::receiveInProcess(const QByteArray& data,
+                                    quint16 sender_port)
+{
+    emit dataReceived(data, QHostAddress(QHostAddress::LocalHost),
+                      sender_port);
+}
+
 quint16 UdpTransport::localPort() const
 {
+    if (in_process_port_ != 0) {
+        return in_process_port_;
+    }
+    if (batched_) {
+        return batched_->localPort();
+    }
     return socket_ ? socket_->localPort() : 0;
 }
+
+bool UdpTransport::isBatched() const
+{
+    return batched_ != nullptr;
+}
+
+bool UdpTransport::isInProcess() const
+{
+    return in_process_port_ != 0;
+}
@@ -0,0 +1,82 @@
+#include "message_codec.hpp"
+
+#include <gtest/gtest.h>
+
+#include <QDataStream>
+#include <QIODevice>
+
+#include "message_fields.hpp"
+
+namespace {
+
+template <typename... Values>
+QByteArray streamed(const Values&... values)
+{
+    QByteArray data;
+    QDataStream ds(&data, QIODevice::WriteOnly);
+    ds.setByteOrder(QDataStream::BigEndian);
+    (ds << ... << values);
+    return data;
+}
+
+}  // namespace
+
+TEST(MessageCodecTest, FixedSizeMessagesMatchQDataStream)
+{
+    const RarInfo rar{17, 9001, 10};
+    EXPECT_EQ(MessageCodec::encode(rar),
+              streamed(rar.ra_rnti, rar.temp_c_rnti, rar.timing_advance));
+
+    const MeasurementReportInfo report{102, -87.25};
+    EXPECT_EQ(MessageCodec::encode(report),
+              streamed(report.reported_gnb_id, report.rsrp));
+
+    const RrcSetupRequest request{0x0102030405060708, 3};
+    EXPECT_EQ(MessageCodec::encode(request),
+              streamed(static_cast<quint64>(request.ue_identity),
+                       request.cause));
+}
+
+TEST(MessageCodecTest, VariableSizeMessagesMatchQDataStream)
+{
+    const ChatMessageInfo chat{501, 502, QString("hello, n78")};
+    EXPECT_EQ(MessageCodec::encode(chat),
+              streamed(chat.receiver_ue_id, chat.sender_ue_id, chat.text));
+
+    SIB1Info sib1{7, GnbCellConfig({{250, 1}, {262, 99}}, 2)};
+    sib1.cell_config.tac = 4321;
+    EXPECT_EQ(MessageCodec::encode(sib1),
+              streamed(sib1.gnb_id, sib1.cell_config.tac,
+                       sib1.cell_config.minRxLevel,
+                       sib1.cell_config.plmns_size, 250u, 1u, 262u, 99u));
+}
+
+TEST(MessageCodecTest, RoundTripAndRejectsTruncated)
+{
+    const ChatMessageInfo chat{501, 502, QString("hello")};
+    const QByteArray encoded = MessageCodec::encode(chat);
+
+    const auto decoded = MessageCodec::decode<ChatMessageInfo>(encoded);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->text, chat.text);
+    EXPECT_FALSE(MessageCodec::decode<ChatMessageInfo>(
+                     encoded.left(encoded.size() - 1))
+                     .has_value());
+    EXPECT_FALSE(MessageCodec::decode<RarInfo>(QByteArray(5, '\0')));
+}
+
+TEST(MessageCodecTest, OptionalTrailingField)
+{
+    const RegistrationAnswerInfo rejected{RegistrationStatus::Rejected,
+                                          QString("PLMN not allowed")};
+    const auto decoded = MessageCodec::decode<RegistrationAnswerInfo>(
+        MessageCodec::encode(rejected));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->reject_reason, rejected.reject_reason);
+
+    const auto accepted = MessageCodec::decode<RegistrationAnswerInfo>(
+        MessageCodec::encode(
+            RegistrationAnswerInfo{RegistrationStatus::Accepted}));
+    ASSERT_TRUE(accepted.has_value());
+    EXPECT_FALSE(accepted->reject_reason.has_value());
+}
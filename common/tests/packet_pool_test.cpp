@@ -0,0 +1,67 @@
+#include "packet_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <QByteArray>
+
+TEST(PacketPoolTest, ReusesBufferOnceEveryCopyIsGone)
+{
+    PacketPool pool;
+    const char* first = nullptr;
+    {
+        const QByteArray packet = pool.acquire(100);
+        first = packet.constData();
+        EXPECT_EQ(packet.size(), 100);
+    }
+
+    const QByteArray packet = pool.acquire(40);
+    EXPECT_EQ(packet.constData(), first);
+    EXPECT_EQ(packet.size(), 40);
+    EXPECT_EQ(pool.bufferCount(), 1u);
+    EXPECT_EQ(pool.misses(), 1u);
+}
+
+TEST(PacketPoolTest, SharedBufferIsNotHandedOutAgain)
+{
+    PacketPool pool;
+    const QByteArray queued = pool.acquire(64);
+    const QByteArray next = pool.acquire(64);
+
+    EXPECT_NE(queued.constData(), next.constData());
+    EXPECT_EQ(pool.bufferCount(), 2u);
+    EXPECT_EQ(pool.misses(), 2u);
+}
+
+TEST(PacketPoolTest, WritingBeforeCopyDoesNotDetach)
+{
+    PacketPool pool;
+    QByteArray& buffer = pool.acquire(4);
+    const char* data = buffer.constData();
+    buffer.data()[0] = 'x';
+
+    const QByteArray packet = buffer;
+    EXPECT_EQ(packet.constData(), data);
+    EXPECT_EQ(packet.at(0), 'x');
+}
+
+TEST(PacketPoolTest, OversizedRequestIsUnpooledMiss)
+{
+    PacketPool pool;
+    const QByteArray packet = pool.acquire(PacketPool::BUFFER_SIZE + 1);
+
+    EXPECT_EQ(packet.size(), PacketPool::BUFFER_SIZE + 1);
+    EXPECT_EQ(pool.bufferCount(), 0u);
+    EXPECT_EQ(pool.misses(), 1u);
+}
+
+TEST(PacketPoolTest, EachThreadHasItsOwnPool)
+{
+    PacketPool* main_pool = &PacketPool::local();
+    PacketPool* other_pool = nullptr;
+    std::thread([&other_pool] { other_pool = &PacketPool::local(); }).join();
+
+    EXPECT_EQ(&PacketPool::local(), main_pool);
+    EXPECT_NE(other_pool, main_pool);
+}
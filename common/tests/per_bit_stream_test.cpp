@@ -0,0 +1,92 @@
+#include "per_bit_stream.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace {
+
+PerBitReader readerFor(const PerBitWriter& writer, PerVariant variant)
+{
+    return PerBitReader(writer.bytes().data(), writer.bytes().size(),
+                        variant);
+}
+
+}  // namespace
+
+TEST(PerBitStreamTest, UnalignedPacksConstrainedFieldsBackToBack)
+{
+    PerBitWriter writer(PerVariant::Unaligned);
+    writer.writeConstrained(5, 0, 7);          // 3 bits
+    writer.writeConstrained(-100, -156, -31);  // 7 bits
+    writer.writeConstrained(999, 0, 999);      // 10 bits
+    writer.writeBool(true);
+
+    EXPECT_EQ(writer.bytes().size(), 3u);
+
+    PerBitReader reader = readerFor(writer, PerVariant::Unaligned);
+    EXPECT_EQ(reader.readConstrained(0, 7), 5);
+    EXPECT_EQ(reader.readConstrained(-156, -31), -100);
+    EXPECT_EQ(reader.readConstrained(0, 999), 999);
+    EXPECT_TRUE(reader.readBool());
+    EXPECT_TRUE(reader.ok());
+}
+
+TEST(PerBitStreamTest, AlignedPadsWideFieldsToOctets)
+{
+    PerBitWriter writer(PerVariant::Aligned);
+    writer.writeConstrained(1, 0, 3);            // 2 bits
+    writer.writeConstrained(0xBEEF, 0, 0xFFFF);  // aligned, 16 bits
+
+    ASSERT_EQ(writer.bytes().size(), 3u);
+    EXPECT_EQ(writer.bytes()[0], 0x40);
+    EXPECT_EQ(writer.bytes()[1], 0xBE);
+    EXPECT_EQ(writer.bytes()[2], 0xEF);
+
+    PerBitReader reader = readerFor(writer, PerVariant::Aligned);
+    EXPECT_EQ(reader.readConstrained(0, 3), 1);
+    EXPECT_EQ(reader.readConstrained(0, 0xFFFF), 0xBEEF);
+    EXPECT_TRUE(reader.ok());
+}
+
+TEST(PerBitStreamTest, OctetStringsRoundTripInBothVariants)
+{
+    const std::string short_text = "5G";
+    const std::string long_text(300, 'x');
+
+    for (const PerVariant variant :
+         {PerVariant::Aligned, PerVariant::Unaligned}) {
+        PerBitWriter writer(variant);
+        writer.writeBool(true);
+        writer.writeOctetString(short_text.data(), short_text.size());
+        writer.writeOctetString(long_text.data(), long_text.size());
+
+        PerBitReader reader = readerFor(writer, variant);
+        EXPECT_TRUE(reader.readBool());
+        EXPECT_EQ(reader.readOctetString(), short_text);
+        EXPECT_EQ(reader.readOctetString(), long_text);
+        EXPECT_TRUE(reader.ok());
+    }
+}
+
+TEST(PerBitStreamTest, ClampsOnWriteAndRejectsOnRead)
+{
+    PerBitWriter writer(PerVariant::Unaligned);
+    writer.writeConstrained(20, 0, 9);  // clamped to 9
+    writer.writeBits(15, 4);            // 15 is above 0..9
+
+    PerBitReader reader = readerFor(writer, PerVariant::Unaligned);
+    EXPECT_EQ(reader.readConstrained(0, 9), 9);
+    reader.readConstrained(0, 9);
+    EXPECT_FALSE(reader.ok());
+}
+
+TEST(PerBitStreamTest, TruncatedInputFails)
+{
+    PerBitWriter writer(PerVariant::Unaligned);
+    writer.writeConstrained(0xFFFFFFFF, 0, 0xFFFFFFFF);
+
+    PerBitReader reader(writer.bytes().data(), 3, PerVariant::Unaligned);
+    reader.readConstrained(0, 0xFFFFFFFF);
+    EXPECT_FALSE(reader.ok());
+}
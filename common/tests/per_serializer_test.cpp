@@ -0,0 +1,127 @@
+#include "per_serializer.hpp"
+
+#include <gtest/gtest.h>
+
+#include "qdatastream_serializer.hpp"
+
+class PerSerializerTest : public ::testing::TestWithParam<PerVariant>
+{
+protected:
+    PerSerializer per{GetParam()};
+    QDataStreamSerializer qds;
+};
+
+TEST_P(PerSerializerTest, Sib1RoundTrip)
+{
+    SIB1Info sib1{7, GnbCellConfig({{250, 1}, {262, 99}}, 2)};
+    sib1.cell_config.tac = 4321;
+    sib1.cell_config.minRxLevel = -115;
+
+    const QByteArray encoded = per.serializeSB1Info(sib1);
+    const auto decoded = per.deserializeSB1Info(encoded);
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->gnb_id, 7u);
+    EXPECT_EQ(decoded->cell_config.tac, 4321);
+    EXPECT_EQ(decoded->cell_config.minRxLevel, -115);
+    EXPECT_EQ(decoded->cell_config.plmns_size, 2);
+    EXPECT_EQ(decoded->cell_config.plmns, sib1.cell_config.plmns);
+    EXPECT_LT(encoded.size(), qds.serializeSB1Info(sib1).size());
+}
+
+TEST_P(PerSerializerTest, RachProcedureRoundTrip)
+{
+    const RarInfo rar{17, 9001, 10};
+    const auto rar_decoded = per.deserializeRar(per.serializeRar(rar));
+    ASSERT_TRUE(rar_decoded.has_value());
+    EXPECT_EQ(rar_decoded->ra_rnti, 17);
+    EXPECT_EQ(rar_decoded->temp_c_rnti, 9001);
+    EXPECT_EQ(rar_decoded->timing_advance, 10);
+
+    const RrcSetupRequest request{0x12345678, 3};
+    const auto request_decoded =
+        per.deserializeRrcSetupRequest(per.serializeRrcSetupRequest(request));
+    ASSERT_TRUE(request_decoded.has_value());
+    EXPECT_EQ(request_decoded->ue_identity, 0x12345678u);
+    EXPECT_EQ(request_decoded->cause, 3);
+
+    const RrcSetupInfo setup{0x12345678, 1};
+    const auto setup_decoded =
+        per.deserializeRrcSetup(per.serializeRrcSetup(setup));
+    ASSERT_TRUE(setup_decoded.has_value());
+    EXPECT_EQ(setup_decoded->received_identity, 0x12345678u);
+    EXPECT_EQ(setup_decoded->config_status, 1);
+
+    const RrcSetupCompleteInfo complete{{310, 260}};
+    const auto complete_decoded = per.deserializeRrcSetupComplete(
+        per.serializeRrcSetupComplete(complete));
+    ASSERT_TRUE(complete_decoded.has_value());
+    EXPECT_EQ(complete_decoded->plmn, complete.plmn);
+
+    const auto release = per.deserializeRrcRelease(
+        per.serializeRrcRelease(RrcReleaseCause::LoadBalancing));
+    ASSERT_TRUE(release.has_value());
+    EXPECT_EQ(*release, RrcReleaseCause::LoadBalancing);
+}
+
+TEST_P(PerSerializerTest, RegistrationRoundTrip)
+{
+    const RegistrationRequestInfo request{501, "NR-SA;n78"};
+    const auto request_decoded = per.deserializeRegistrationRequest(
+        per.serializeRegistrationRequest(request));
+    ASSERT_TRUE(request_decoded.has_value());
+    EXPECT_EQ(request_decoded->ue_id, 501u);
+    EXPECT_EQ(request_decoded->ue_cap, "NR-SA;n78");
+
+    const RegistrationAnswerInfo accepted{RegistrationStatus::Accepted};
+    const auto accepted_decoded = per.deserializeRegistrationAnswer(
+        per.serializeRegistrationAnswer(accepted));
+    ASSERT_TRUE(accepted_decoded.has_value());
+    EXPECT_EQ(accepted_decoded->status, RegistrationStatus::Accepted);
+    EXPECT_FALSE(accepted_decoded->reject_reason.has_value());
+
+    const RegistrationAnswerInfo rejected{RegistrationStatus::Rejected,
+                                          QString("PLMN not allowed")};
+    const auto rejected_decoded = per.deserializeRegistrationAnswer(
+        per.serializeRegistrationAnswer(rejected));
+    ASSERT_TRUE(rejected_decoded.has_value());
+    EXPECT_EQ(rejected_decoded->reject_reason, rejected.reject_reason);
+}
+
+TEST_P(PerSerializerTest, MeasurementReportKeepsTenthsOfDb)
+{
+    const MeasurementReportInfo report{102, -87.34};
+    const QByteArray encoded = per.serializeMeasurementReport(report);
+    const auto decoded = per.deserializeMeasurementReport(encoded);
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->reported_gnb_id, 102u);
+    EXPECT_DOUBLE_EQ(decoded->rsrp, -87.3);
+    EXPECT_LT(encoded.size(), qds.serializeMeasurementReport(report).size());
+}
+
+TEST_P(PerSerializerTest, HandoverRoundTrip)
+{
+    const QByteArray encoded = per.serializeTriggerHandover(HandoverInfo{103});
+
+    const auto handover = per.deserializeTriggerHandover(encoded);
+    const auto reconfiguration = per.deserializeRrcReconfiguration(encoded);
+    ASSERT_TRUE(handover.has_value());
+    ASSERT_TRUE(reconfiguration.has_value());
+    EXPECT_EQ(handover->gnb_id, 103u);
+    EXPECT_EQ(reconfiguration->gnb_id, 103u);
+}
+
+TEST_P(PerSerializerTest, RejectsTruncatedPayloads)
+{
+    const QByteArray rar = per.serializeRar({17, 9001, 10});
+
+    EXPECT_FALSE(per.deserializeRar(rar.left(rar.size() - 1)).has_value());
+    EXPECT_FALSE(per.deserializeSB1Info(QByteArray()).has_value());
+    EXPECT_FALSE(per.deserializeTriggerHandover(QByteArray(2, '\0'))
+                     .has_value());
+}
+
+INSTANTIATE_TEST_SUITE_P(Variants, PerSerializerTest,
+                         ::testing::Values(PerVariant::Aligned,
+                                           PerVariant::Unaligned));
@@ -0,0 +1,110 @@
+#include "shm_ring.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+class ShmRingTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t CAPACITY = 256;
+
+    std::vector<std::string> drainAll(ShmRing& ring)
+    {
+        std::vector<std::string> out;
+        ring.drain([&out](const char* data, size_t size) {
+            out.emplace_back(data, size);
+        });
+        return out;
+    }
+
+    ShmRingControl control;
+    std::vector<char> memory = std::vector<char>(CAPACITY);
+    ShmRing ring{&control, memory.data(), CAPACITY};
+};
+
+TEST_F(ShmRingTest, KeepsDatagramBoundariesAndOrder)
+{
+    EXPECT_TRUE(ring.push("a", 1));
+    EXPECT_TRUE(ring.push("hello", 5));
+    EXPECT_TRUE(ring.push("", 0));
+
+    EXPECT_EQ(drainAll(ring), (std::vector<std::string>{"a", "hello", ""}));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(ShmRingTest, RejectsOversizedAndOverflowingDatagrams)
+{
+    const std::string big(ring.maxRecordSize() + 1, 'x');
+    EXPECT_FALSE(ring.push(big.data(), big.size()));
+
+    const std::string half(ring.maxRecordSize(), 'y');
+    EXPECT_TRUE(ring.push(half.data(), half.size()));
+    EXPECT_TRUE(ring.push(half.data(), half.size()));
+    EXPECT_FALSE(ring.push("z", 1));
+
+    EXPECT_EQ(drainAll(ring).size(), 2u);
+    EXPECT_TRUE(ring.push("z", 1));
+}
+
+TEST_F(ShmRingTest, WrapsWithPaddingRecord)
+{
+    const std::string record(100, 'r');
+    for (int round = 0; round < 10; ++round) {
+        ASSERT_TRUE(ring.push(record.data(), record.size()));
+        ASSERT_TRUE(ring.push(record.data(), record.size()));
+        const auto drained = drainAll(ring);
+        ASSERT_EQ(drained.size(), 2u);
+        EXPECT_EQ(drained[0], record);
+        EXPECT_EQ(drained[1], record);
+    }
+}
+
+TEST_F(ShmRingTest, WakeupIsRequestedOncePerSleep)
+{
+    EXPECT_FALSE(ring.needsWakeup());
+
+    EXPECT_TRUE(ring.prepareToSleep());
+    EXPECT_TRUE(ring.push("a", 1));
+    EXPECT_TRUE(ring.needsWakeup());
+    EXPECT_TRUE(ring.push("b", 1));
+    EXPECT_FALSE(ring.needsWakeup());
+
+    // Data is pending, so the consumer must not go to sleep.
+    EXPECT_FALSE(ring.prepareToSleep());
+    EXPECT_FALSE(ring.needsWakeup());
+}
+
+TEST_F(ShmRingTest, ConcurrentProducerAndConsumerLoseNothing)
+{
+    constexpr uint32_t COUNT = 50000;
+
+    std::thread producer([this] {
+        for (uint32_t i = 0; i < COUNT; ++i) {
+            const std::string record(i % 40, static_cast<char>('a' + i % 26));
+            while (!ring.push(record.data(), record.size())) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool intact = true;
+    while (expected < COUNT) {
+        const size_t drained = ring.drain([&](const char* data, size_t size) {
+            const char fill = static_cast<char>('a' + expected % 26);
+            intact = intact && size == expected % 40 &&
+                     (size == 0 || data[size - 1] == fill);
+            ++expected;
+        });
+        if (drained == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(intact);
+    EXPECT_EQ(expected, COUNT);
+}
@@ -94,3 +94,210 @@ TEST_F(SimProtocolTest, IdentifiesHubMessages)
     EXPECT_TRUE(decoded.isFromHub(HUB_ID));
     EXPECT_EQ(decoded.srcId, HUB_ID);
 }
+
+TEST_F(SimProtocolTest, PeekHeaderMatchesFullParse)
+{
+    QByteArray raw_data =
+        buildPacket(TEST_UE_ID, TEST_UE_TYPE, TEST_GNB_ID,
+                    SimMessageType::Data, TEST_POS, TEST_PAYLOAD);
+    const HeaderView header = peekHeader(raw_data);
+    const DecodedPacket decoded = parse(raw_data);
+
+    ASSERT_TRUE(header.isValid);
+    EXPECT_EQ(raw_data.size(), HEADER_SIZE + TEST_PAYLOAD.size());
+    EXPECT_EQ(header.srcId, decoded.srcId);
+    EXPECT_EQ(header.dstId, decoded.dstId);
+    EXPECT_EQ(header.nodeType, decoded.nodeType);
+    EXPECT_EQ(header.type, decoded.type);
+    EXPECT_DOUBLE_EQ(header.position.x(), TEST_POS.x());
+    EXPECT_DOUBLE_EQ(header.position.y(), TEST_POS.y());
+}
+
+TEST_F(SimProtocolTest, PeekHeaderRejectsTruncatedHeader)
+{
+    QByteArray raw_data =
+        buildPacket(TEST_UE_ID, TEST_UE_TYPE, BROADCAST_ID,
+                    SimMessageType::Data, TEST_POS);
+
+    EXPECT_TRUE(peekHeader(raw_data).isBroadcast(BROADCAST_ID));
+    EXPECT_FALSE(peekHeader(raw_data.left(HEADER_SIZE - 1)).isValid);
+}
+
+TEST_F(SimProtocolTest, RejectsForeignVersion)
+{
+    QByteArray raw_data =
+        buildPacket(TEST_UE_ID, TEST_UE_TYPE, TEST_GNB_ID,
+                    SimMessageType::Data, TEST_POS, TEST_PAYLOAD);
+    ASSERT_EQ(static_cast<uint8_t>(raw_data[VERSION_OFFSET]), VERSION);
+
+    raw_data[VERSION_OFFSET] = static_cast<char>(VERSION + 1);
+    EXPECT_FALSE(peekHeader(raw_data).isValid);
+    EXPECT_FALSE(view(raw_data).isValid);
+    EXPECT_FALSE(parse(raw_data).isValid);
+}
+
+TEST_F(SimProtocolTest, PacketViewPointsIntoBuffer)
+{
+    const QByteArray raw_data =
+        buildDataPacket(TEST_UE_ID, TEST_UE_TYPE, TEST_GNB_ID, TEST_POS,
+                        ProtocolMsgType::MeasurementReport, TEST_PAYLOAD);
+    const PacketView packet = view(raw_data);
+
+    ASSERT_TRUE(packet.isValid);
+    EXPECT_TRUE(packet.isForMe(TEST_GNB_ID, BROADCAST_ID));
+    EXPECT_EQ(packet.protocolType(), ProtocolMsgType::MeasurementReport);
+    EXPECT_EQ(packet.payloadData, raw_data.constData() + HEADER_SIZE);
+
+    const QByteArray payload = packet.protocolPayload();
+    EXPECT_EQ(payload, TEST_PAYLOAD);
+    EXPECT_EQ(payload.constData(), raw_data.constData() + HEADER_SIZE + 1);
+}
+
+TEST_F(SimProtocolTest, DataPacketMatchesPrefixedPayload)
+{
+    QByteArray prefixed;
+    prefixed.append(static_cast<char>(ProtocolMsgType::RrcSetup));
+    prefixed.append(TEST_PAYLOAD);
+
+    EXPECT_EQ(buildDataPacket(TEST_GNB_ID, EntityType::GNB, TEST_UE_ID,
+                              TEST_POS, ProtocolMsgType::RrcSetup,
+                              TEST_PAYLOAD),
+              buildPacket(TEST_GNB_ID, EntityType::GNB, TEST_UE_ID,
+                          SimMessageType::Data, TEST_POS, prefixed));
+    EXPECT_EQ(peekProtocolType(buildDataPacket(
+                  TEST_GNB_ID, EntityType::GNB, TEST_UE_ID, TEST_POS,
+                  ProtocolMsgType::RrcSetup, QByteArray())),
+              ProtocolMsgType::RrcSetup);
+}
+
+TEST_F(SimProtocolTest, HubRedirectRoundTrip)
+{
+    const HubRedirect redirect = parseHubRedirect(
+        buildHubRedirectPayload(QHostAddress("127.0.0.2"), 5556, true));
+
+    EXPECT_TRUE(redirect.isValid);
+    EXPECT_EQ(redirect.address, QHostAddress("127.0.0.2"));
+    EXPECT_EQ(redirect.port, 5556);
+    EXPECT_TRUE(redirect.mustRegister);
+    EXPECT_FALSE(parseHubRedirect(QByteArray(3, '\0')).isValid);
+}
+
+TEST_F(SimProtocolTest, PeekProtocolTypeReadsDataPayloadOnly)
+{
+    const QByteArray protocol_payload(
+        1, static_cast<char>(ProtocolMsgType::MeasurementReport));
+
+    EXPECT_EQ(peekProtocolType(buildPacket(TEST_UE_ID, TEST_UE_TYPE,
+                                           TEST_GNB_ID, SimMessageType::Data,
+                                           TEST_POS, protocol_payload)),
+              ProtocolMsgType::MeasurementReport);
+    EXPECT_EQ(peekProtocolType(buildPacket(TEST_UE_ID, TEST_UE_TYPE, HUB_ID,
+                                           SimMessageType::Registration,
+                                           TEST_POS, protocol_payload)),
+              ProtocolMsgType::Unknown);
+    EXPECT_EQ(peekProtocolType(buildPacket(TEST_UE_ID, TEST_UE_TYPE,
+                                           TEST_GNB_ID, SimMessageType::Data,
+                                           TEST_POS)),
+              ProtocolMsgType::Unknown);
+}
+
+TEST_F(SimProtocolTest, SinrReportRoundTripInTenthsOfDb)
+{
+    const auto samples = parseSinrReport(
+        buildSinrReportPayload({{TEST_UE_ID, 12.34}, {TEST_UE_ID + 1, -5.0}}));
+
+    ASSERT_EQ(samples.size(), 2u);
+    EXPECT_EQ(samples[0].ueId, TEST_UE_ID);
+    EXPECT_DOUBLE_EQ(samples[0].sinrDb, 12.3);
+    EXPECT_DOUBLE_EQ(samples[1].sinrDb, -5.0);
+    // A truncated sample is dropped.
+    EXPECT_EQ(parseSinrReport(buildSinrReportPayload({{TEST_UE_ID, 1.0}})
+                                  .chopped(1))
+                  .size(),
+              0u);
+}
+
+TEST_F(SimProtocolTest, RsrpReportRoundTripInTenthsOfDb)
+{
+    const auto samples = parseRsrpReport(buildRsrpReportPayload(
+        {{TEST_GNB_ID, -87.66}, {TEST_GNB_ID + 1, -120.0}}));
+
+    ASSERT_EQ(samples.size(), 2u);
+    EXPECT_EQ(samples[0].gnbId, TEST_GNB_ID);
+    EXPECT_DOUBLE_EQ(samples[0].rsrpDbm, -87.7);
+    EXPECT_DOUBLE_EQ(samples[1].rsrpDbm, -120.0);
+    EXPECT_TRUE(parseRsrpReport(buildRsrpReportPayload({})).empty());
+}
+
+TEST_F(SimProtocolTest, BundleRoundTripKeepsPduOrder)
+{
+    const QByteArray setup("setup");
+    const std::vector<BundlePdu> sent = {
+        {TEST_UE_ID, ProtocolMsgType::RrcSetup, setup.constData(),
+         static_cast<int>(setup.size())},
+        {TEST_UE_ID + 1, ProtocolMsgType::Rar, nullptr, 0},
+    };
+
+    const QByteArray packet = buildBundlePacket(
+        TEST_GNB_ID, EntityType::GNB, HUB_ID, TEST_POS, sent);
+    EXPECT_EQ(packet.size(), bundlePacketSize(sent));
+
+    std::vector<BundlePdu> received;
+    ASSERT_TRUE(parseBundle(view(packet), received));
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0].dstId, TEST_UE_ID);
+    EXPECT_EQ(received[0].type, ProtocolMsgType::RrcSetup);
+    EXPECT_EQ(received[0].payload(), setup);
+    EXPECT_EQ(received[1].dstId, TEST_UE_ID + 1);
+    EXPECT_EQ(received[1].type, ProtocolMsgType::Rar);
+    EXPECT_TRUE(received[1].payload().isEmpty());
+}
+
+TEST_F(SimProtocolTest, MalformedBundleIsRejected)
+{
+    const QByteArray setup("setup");
+    const QByteArray packet = buildBundlePacket(
+        TEST_GNB_ID, EntityType::GNB, HUB_ID, TEST_POS,
+        {{TEST_UE_ID, ProtocolMsgType::RrcSetup, setup.constData(),
+          static_cast<int>(setup.size())}});
+
+    std::vector<BundlePdu> pdus;
+    EXPECT_FALSE(parseBundle(view(packet.chopped(1)), pdus));
+    EXPECT_FALSE(parseBundle(view(packet + '\0'), pdus));
+    EXPECT_TRUE(pdus.empty());
+    EXPECT_FALSE(parseBundle(
+        view(buildDataPacket(TEST_GNB_ID, EntityType::GNB, TEST_UE_ID,
+                             TEST_POS, ProtocolMsgType::RrcSetup, setup)),
+        pdus));
+}
+
+TEST_F(SimProtocolTest, RegistrationBatchRoundTrip)
+{
+    const auto nodes = parseRegistrationBatch(buildRegistrationBatchPayload(
+        {{TEST_UE_ID, TEST_POS}, {TEST_UE_ID + 1, QPointF(1.5, 2.5)}}));
+
+    ASSERT_EQ(nodes.size(), 2u);
+    EXPECT_EQ(nodes[0].id, TEST_UE_ID);
+    EXPECT_EQ(nodes[0].position, TEST_POS);
+    EXPECT_EQ(nodes[1].id, TEST_UE_ID + 1);
+    EXPECT_EQ(nodes[1].position, QPointF(1.5, 2.5));
+    // A truncated entry is dropped.
+    EXPECT_EQ(parseRegistrationBatch(buildRegistrationBatchPayload(
+                                         {{TEST_UE_ID, TEST_POS}})
+                                         .chopped(1))
+                  .size(),
+              0u);
+}
+
+TEST_F(SimProtocolTest, ReaddressChangesOnlyDestination)
+{
+    const QByteArray broadcast =
+        buildPacket(TEST_GNB_ID, EntityType::GNB, 0xFFFFFFFF,
+                    SimMessageType::Data, TEST_POS, TEST_PAYLOAD);
+    const QByteArray unicast = readdress(broadcast, TEST_UE_ID);
+
+    EXPECT_EQ(unicast, buildPacket(TEST_GNB_ID, EntityType::GNB, TEST_UE_ID,
+                                   SimMessageType::Data, TEST_POS,
+                                   TEST_PAYLOAD));
+    EXPECT_EQ(peekHeader(broadcast).dstId, 0xFFFFFFFFu);
+}
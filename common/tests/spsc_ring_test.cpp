@@ -0,0 +1,60 @@
+#include "spsc_ring.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+TEST(SpscRingTest, CapacityIsRoundedUpToPowerOfTwo)
+{
+    SpscRing<int> ring(100);
+    EXPECT_EQ(ring.capacity(), 128u);
+}
+
+TEST(SpscRingTest, RejectsPushWhenFullAndKeepsFifoOrder)
+{
+    SpscRing<int> ring(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.tryPush([i](int& slot) { slot = i; }));
+    }
+    EXPECT_FALSE(ring.tryPush([](int& slot) { slot = 99; }));
+
+    std::vector<int> drained;
+    EXPECT_EQ(ring.drain([&drained](int value) { drained.push_back(value); },
+                         2),
+              2u);
+    EXPECT_TRUE(ring.tryPush([](int& slot) { slot = 4; }));
+    ring.drain([&drained](int value) { drained.push_back(value); });
+
+    EXPECT_EQ(drained, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(SpscRingTest, ConcurrentProducerAndConsumerLoseNothing)
+{
+    constexpr int COUNT = 50000;
+    SpscRing<int> ring(256);
+
+    std::thread producer([&ring] {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!ring.tryPush([i](int& slot) { slot = i; })) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool in_order = true;
+    while (expected < COUNT) {
+        const size_t drained = ring.drain([&](int value) {
+            in_order = in_order && value == expected;
+            ++expected;
+        });
+        if (drained == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(expected, COUNT);
+}
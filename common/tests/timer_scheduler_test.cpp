@@ -0,0 +1,104 @@
+#include "timer_scheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+class TimerSchedulerTest : public ::testing::Test
+{
+protected:
+    uint64_t now_ms = 0;
+    // Driven by hand, so no QTimer or event loop is involved.
+    TimerScheduler scheduler{nullptr, [this] { return now_ms; }};
+};
+
+TEST_F(TimerSchedulerTest, FiresOnlyDueCallbacksInDeadlineOrder)
+{
+    std::vector<int> fired;
+    scheduler.schedule(200, [&fired] { fired.push_back(3); });
+    scheduler.schedule(5, [&fired] { fired.push_back(2); });
+    scheduler.schedule(0, [&fired] { fired.push_back(1); });
+
+    now_ms = 20;
+    EXPECT_EQ(scheduler.fireDue(), 2u);
+    EXPECT_EQ(fired, (std::vector<int>{1, 2}));
+    EXPECT_EQ(scheduler.pending(), 1u);
+
+    now_ms = 199;
+    EXPECT_EQ(scheduler.fireDue(), 0u);
+    now_ms = 200;
+    EXPECT_EQ(scheduler.fireDue(), 1u);
+    EXPECT_EQ(fired, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(TimerSchedulerTest, DelayCountsFromScheduleAfterIdleTime)
+{
+    now_ms = 10000;
+    int fired = 0;
+    scheduler.schedule(5, [&fired] { ++fired; });
+
+    now_ms = 10004;
+    EXPECT_EQ(scheduler.fireDue(), 0u);
+    now_ms = 10005;
+    EXPECT_EQ(scheduler.fireDue(), 1u);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(TimerSchedulerTest, CancelledCallbackNeverRuns)
+{
+    bool fired = false;
+    const auto id = scheduler.schedule(0, [&fired] { fired = true; });
+
+    EXPECT_TRUE(scheduler.cancel(id));
+    EXPECT_FALSE(scheduler.cancel(id));
+    now_ms = 5;
+    EXPECT_EQ(scheduler.fireDue(), 0u);
+    EXPECT_FALSE(fired);
+}
+
+TEST_F(TimerSchedulerTest, RestartedDeadlineFiresOnce)
+{
+    int fired = 0;
+    Deadline deadline(scheduler);
+    deadline.start(0, [&fired] { ++fired; });
+    deadline.start(0, [&fired] { fired += 10; });
+    EXPECT_TRUE(deadline.isActive());
+
+    now_ms = 5;
+    scheduler.fireDue();
+    EXPECT_EQ(fired, 10);
+    EXPECT_FALSE(deadline.isActive());
+}
+
+TEST_F(TimerSchedulerTest, DeadlineCanRearmFromItsCallback)
+{
+    int fired = 0;
+    Deadline deadline(scheduler);
+    std::function<void()> tick = [&] {
+        if (++fired < 3) {
+            deadline.start(0, tick);
+        }
+    };
+    deadline.start(0, tick);
+
+    for (int i = 0; i < 3; ++i) {
+        now_ms += 5;
+        scheduler.fireDue();
+    }
+    EXPECT_EQ(fired, 3);
+    EXPECT_FALSE(deadline.isActive());
+}
+
+TEST_F(TimerSchedulerTest, DestroyedDeadlineIsCancelled)
+{
+    bool fired = false;
+    {
+        Deadline deadline(scheduler);
+        deadline.start(0, [&fired] { fired = true; });
+    }
+
+    EXPECT_EQ(scheduler.pending(), 0u);
+    now_ms = 5;
+    scheduler.fireDue();
+    EXPECT_FALSE(fired);
+}
@@ -0,0 +1,123 @@
+#include "timing_wheel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+class TimingWheelTest : public ::testing::Test
+{
+protected:
+    TimingWheel<int> wheel;
+    std::vector<std::pair<uint64_t, int>> fired;
+
+    void advanceTo(uint64_t tick)
+    {
+        wheel.advance(tick, [this](int&& value) {
+            fired.emplace_back(wheel.now(), value);
+        });
+    }
+};
+
+TEST_F(TimingWheelTest, FiresAtDeadline)
+{
+    wheel.schedule(5, 1);
+    wheel.schedule(3, 2);
+
+    advanceTo(4);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0], std::make_pair(uint64_t{3}, 2));
+
+    advanceTo(10);
+    ASSERT_EQ(fired.size(), 2u);
+    EXPECT_EQ(fired[1], std::make_pair(uint64_t{5}, 1));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST_F(TimingWheelTest, PastDeadlineFiresOnNextTick)
+{
+    advanceTo(100);
+    wheel.schedule(50, 7);
+
+    advanceTo(101);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].first, 101u);
+}
+
+TEST_F(TimingWheelTest, CancelledTimerNeverFires)
+{
+    const auto id = wheel.schedule(300, 1);
+    wheel.schedule(300, 2);
+
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.cancel(id));
+    EXPECT_EQ(wheel.size(), 1u);
+
+    advanceTo(1000);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].second, 2);
+}
+
+TEST_F(TimingWheelTest, CascadesAcrossAllLevels)
+{
+    const std::vector<uint64_t> deadlines{
+        1, 255, 256, 257, 65535, 65536, 65537, 70000, 1u << 24, (1u << 24) + 3};
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        wheel.schedule(deadlines[i], static_cast<int>(i));
+    }
+
+    advanceTo((1u << 24) + 10);
+
+    ASSERT_EQ(fired.size(), deadlines.size());
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        EXPECT_EQ(fired[i].first, deadlines[i]);
+        EXPECT_EQ(fired[i].second, static_cast<int>(i));
+    }
+}
+
+TEST_F(TimingWheelTest, NextWakeupIsEarliestDeadlineOnAnyLevel)
+{
+    EXPECT_EQ(wheel.nextWakeup(), TimingWheel<int>::NEVER);
+
+    // Only a far timer: no wakeup at the cascade boundaries before it.
+    wheel.schedule(1000, 1);
+    EXPECT_EQ(wheel.nextWakeup(), 1000u);
+    wheel.schedule(70000, 2);
+    EXPECT_EQ(wheel.nextWakeup(), 1000u);
+
+    const auto id = wheel.schedule(40, 3);
+    EXPECT_EQ(wheel.nextWakeup(), 40u);
+    wheel.cancel(id);
+    EXPECT_EQ(wheel.nextWakeup(), 1000u);
+
+    advanceTo(600);
+    EXPECT_EQ(wheel.nextWakeup(), 1000u);
+    advanceTo(1000);
+    EXPECT_EQ(wheel.nextWakeup(), 70000u);
+}
+
+TEST_F(TimingWheelTest, MatchesReferenceOrderingUnderRandomLoad)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<uint64_t> delay(0, 70000);
+    std::multimap<uint64_t, int> expected;
+
+    for (int i = 0; i < 5000; ++i) {
+        const uint64_t deadline = wheel.now() + 1 + delay(rng);
+        wheel.schedule(deadline, i);
+        expected.emplace(deadline, i);
+        if (i % 10 == 0) {
+            advanceTo(wheel.now() + delay(rng) / 100);
+        }
+    }
+    EXPECT_EQ(wheel.nextWakeup(), expected.lower_bound(wheel.now() + 1)->first);
+    advanceTo(wheel.now() + 80000);
+
+    ASSERT_EQ(fired.size(), expected.size());
+    size_t index = 0;
+    for (const auto& [deadline, value] : expected) {
+        EXPECT_EQ(fired[index].first, deadline);
+        ++index;
+    }
+}
@@ -10,9 +10,25 @@ SimulationController::SimulationController(SettingsPack pack, QObject* parent)
     : QObject(parent)
     , set_pack_(std::move(pack))
 {
+    // Internal nodes share the process with the hub: skip the sockets.
+    // A federated hub still talks to its peers, and an explicitly chosen
+    // batched backend is kept as configured.
+    if (set_pack_.getMode() == DeployMode::Monolithic &&
+        !set_pack_.hub.federation.enabled &&
+        set_pack_.hub.udp_backend == UdpBackend::Datagram) {
+        set_pack_.hub.udp_backend = UdpBackend::InProcess;
+        set_pack_.gnb.hub.udp_backend = UdpBackend::InProcess;
+        set_pack_.ue.hub.udp_backend = UdpBackend::InProcess;
+    }
+
     hub_ = new RadioHub(set_pack_.hub, this);
 }
 
+const SettingsPack& SimulationController::settings() const
+{
+    return set_pack_;
+}
+
 void SimulationController::startSimulation()
 {
     if (!hub_ || !hub_->run()) {
@@ -50,10 +66,14 @@ QVector<GnbGuiSnapshot> SimulationController::getGnbSnapshots() const
 QVector<UeGuiSnapshot> SimulationController::getUeSnapshots() const
 {
     QVector<UeGuiSnapshot> result;
+    const QHash<uint32_t, double> sinr_db = hub_->ueSinrSnapshot();
     for (const auto& item : ues_) {
         {
             const auto node_info = item->getNodeInfo();
-            result.push_back(snapshots::getUeSnapshot(node_info));
+            UeGuiSnapshot snapshot = snapshots::getUeSnapshot(node_info);
+            snapshot.data.sinr_db =
+                sinr_db.value(snapshot.id, snapshot.data.sinr_db);
+            result.push_back(snapshot);
         }
     }
     return result;
@@ -66,9 +86,7 @@ void SimulationController::setupGnbStations()
         gnb->setPosition({pos.X, pos.Y});
         gnb->setTxPower(set_pack_.gnb.radio.tx_power_db);
 
-        GnbCellConfig config({{255, 1}, {255, 2}}, 2);
-        config.tac = set_pack_.gnb.cell.tracking_area_code;
-        gnb->setCellConfig(config);
+        gnb->setCellConfig(GnbLogic::cellConfig(set_pack_.gnb));
 
         if (gnb->setupNetwork(NetworkParam::EPHEMERAL_PORT)) {
             gnb->registerAtHub();
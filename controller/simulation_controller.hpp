@@ -17,6 +17,8 @@ public:
     void startSimulation();
     QVector<GnbGuiSnapshot> getGnbSnapshots() const;
     QVector<UeGuiSnapshot> getUeSnapshots() const;
+    // Settings in effect, after the deploy mode picked the transports.
+    const SettingsPack& settings() const;
 
 signals:
     void dataUpdated();
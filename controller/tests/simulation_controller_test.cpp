@@ -0,0 +1,49 @@
+#include "simulation_controller.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+SettingsPack monolithicPack(UdpBackend backend, bool is_federated)
+{
+    HubSettings hub(5555, 0, 0xFFFFFFFF, Point2D{0.0, 0.0}, "127.0.0.1");
+    hub.udp_backend = backend;
+    hub.federation.enabled = is_federated;
+    const RadioSettings radio{5.0};
+    const Cell cell{100};
+    SimulationSettings sim{DeployMode::Monolithic, 0, 0, 1, 100};
+    return SettingsPack(hub, UeSettings(hub, radio, cell),
+                        GnbSettings(hub, radio, cell, 1200.0), sim,
+                        Positions{}, Paths{});
+}
+
+}  // namespace
+
+TEST(SimulationControllerTest, MonolithicNodesUseTheInProcessBus)
+{
+    SimulationController controller(
+        monolithicPack(UdpBackend::Datagram, false));
+
+    EXPECT_EQ(controller.settings().hub.udp_backend, UdpBackend::InProcess);
+    EXPECT_EQ(controller.settings().gnb.hub.udp_backend,
+              UdpBackend::InProcess);
+    EXPECT_EQ(controller.settings().ue.hub.udp_backend, UdpBackend::InProcess);
+}
+
+TEST(SimulationControllerTest, FederatedMonolithicHubKeepsItsSockets)
+{
+    SimulationController controller(monolithicPack(UdpBackend::Datagram, true));
+
+    EXPECT_EQ(controller.settings().hub.udp_backend, UdpBackend::Datagram);
+    EXPECT_EQ(controller.settings().gnb.hub.udp_backend, UdpBackend::Datagram);
+    EXPECT_EQ(controller.settings().ue.hub.udp_backend, UdpBackend::Datagram);
+}
+
+TEST(SimulationControllerTest, MonolithicBatchedBackendIsKept)
+{
+    SimulationController controller(monolithicPack(UdpBackend::Batched, false));
+
+    EXPECT_EQ(controller.settings().hub.udp_backend, UdpBackend::Batched);
+    EXPECT_EQ(controller.settings().gnb.hub.udp_backend, UdpBackend::Batched);
+    EXPECT_EQ(controller.settings().ue.hub.udp_backend, UdpBackend::Batched);
+}
@@ -0,0 +1,56 @@
+#ifndef GNB_HOST_HPP
+#define GNB_HOST_HPP
+
+#include <memory>
+#include <vector>
+
+#include <QObject>
+
+#include "gnb_logic.hpp"
+#include "settings.hpp"
+#include "timer_scheduler.hpp"
+#include "udp_transport.hpp"
+
+/**
+ * @brief Runs a range of cells in one process.
+ *
+ * Every cell keeps its own GnbCellConfig, position and UE contexts; they
+ * share one UdpTransport, and their deadlines share the thread's
+ * TimerScheduler. The hub only sends unicast datagrams to gNBs, so the
+ * host hands each one to its cell by destination id. Periodic SIB1
+ * broadcasts are spread evenly over the broadcast interval instead of all
+ * falling due in the same millisecond.
+ */
+class GnbHost : public QObject
+{
+    Q_OBJECT
+public:
+    GnbHost(HostRange range, const GnbSettings& set,
+            QObject* parent = nullptr);
+
+    bool setupNetwork(quint16 port);
+    // Lays the cells out on a square grid of spacing around center.
+    void layOut(QPointF center, double spacing);
+    void registerAtHub();
+    void run();
+
+    // nullptr when id is outside the hosted range.
+    GnbLogic* cell(uint32_t id) const;
+    size_t size() const;
+
+private slots:
+    void onDatagram(const QByteArray& data, const QHostAddress& addr,
+                    quint16 port);
+    void registerNextCells();
+
+private:
+    HostRange range_;
+    GnbSettings set_;
+    std::vector<std::unique_ptr<GnbLogic>> cells_;
+
+    UdpTransport* transport_ = nullptr;
+    Deadline registration_deadline_;
+    size_t next_to_register_ = 0;
+};
+
+#endif  // GNB_HOST_HPP
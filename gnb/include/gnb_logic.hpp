@@ -1,10 +1,15 @@
 #ifndef GNB_LOGIC_HPP
 #define GNB_LOGIC_HPP
 
-#include <QTimer>
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+#include <QHash>
 
 #include "base_entity.hpp"
 #include "settings.hpp"
+#include "timer_scheduler.hpp"
 #include "types.hpp"
 
 #ifdef UNIT_TESTS
@@ -16,25 +21,41 @@ class GnbLogic : public BaseEntity
     Q_OBJECT
 public:
     GnbLogic(const uint32_t id, const GnbSettings set,
-             QObject* parent = nullptr);
+             QObject* parent = nullptr,
+             TimerScheduler& scheduler = TimerScheduler::local());
+    /**
+     * @brief Cell of a gNB with set: the simulated network's PLMNs, the
+     * tracking area and transmit power from the settings.
+     */
+    static GnbCellConfig cellConfig(const GnbSettings& set);
     void setCellConfig(const GnbCellConfig& config);
     void run() override;
     uint32_t getConnectedUeCount() const;
     double getRadius() const;
     EntityType getType() const override;
     NodeInfo getNodeInfo() const override;
-
-protected slots:
-    void onTick();
+    // Last SINR reported by the hub, for MCS selection.
+    std::optional<double> ueSinrDb(uint32_t ue_id) const;
+    std::chrono::milliseconds broadcastInterval() const;
+    // Delays the first periodic SIB1 by offset, within one interval.
+    void setBroadcastOffset(std::chrono::milliseconds offset);
 
 protected:
     void onProtocolMessageReceived(uint32_t ue_id, ProtocolMsgType type,
                                    const QByteArray& payload) override;
 
     void sendBroadcastInfo();
+    /**
+     * @brief Releases the UE if it was idle for the inactivity timeout,
+     * otherwise waits for the rest of it. Activity only stores the time,
+     * so a chatty UE costs one deadline per timeout, not one per message.
+     */
+    void onInactivityDeadline(uint32_t ue_id);
     void handleRegistrationRequest(uint32_t ue_id, const QByteArray& payload);
 
     QByteArray getRegistrationPayload() const override;
+    void onSinrReport(
+        const std::vector<SimProtocol::SinrSample>& samples) override;
 
 private:
     void handleRachPreamble(uint32_t ue_id, const QByteArray& payload);
@@ -48,12 +69,18 @@ private:
 
     void updateUeContext(uint32_t ue_id, uint16_t crnti);
     GnbData getData() const;
+    void scheduleBroadcast(std::chrono::milliseconds delay);
+    void watchInactivity(uint32_t ue_id, std::chrono::milliseconds delay);
 
-    QTimer* main_timer_ = nullptr;
-    std::chrono::steady_clock::time_point last_broadcast_;
+    TimerScheduler& scheduler_;
+    Deadline sib1_deadline_;
     const std::chrono::milliseconds broadcast_interval_{200};
+    std::chrono::milliseconds first_broadcast_delay_ = broadcast_interval_;
+    const std::chrono::seconds inactivity_timeout_{30};
+    std::unordered_map<uint32_t, Deadline> inactivity_deadlines_;
     uint16_t next_crnti_counter_ = 1000;
     double radius_;
+    QHash<uint32_t, double> ue_sinr_db_;
 
 protected:
     QMap<uint32_t, UeContext> ue_contexts_;
@@ -0,0 +1,138 @@
+#include "gnb_host.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDebug>
+
+#include "sim_protocol.hpp"
+
+GnbHost::GnbHost(HostRange range, const GnbSettings& set, QObject* parent)
+    : QObject(parent)
+    , range_(range)
+    , set_(set)
+{
+    // A shared-memory ring per hosted cell would undo the shared socket.
+    set_.hub.shm_transport.enabled = false;
+
+    cells_.reserve(range_.count);
+    for (uint32_t i = 0; i < range_.count; ++i) {
+        auto cell = std::make_unique<GnbLogic>(range_.id_start + i, set_);
+        cell->setCellConfig(GnbLogic::cellConfig(set_));
+        cells_.push_back(std::move(cell));
+    }
+}
+
+bool GnbHost::setupNetwork(quint16 port)
+{
+    if (!transport_) {
+        transport_ = new UdpTransport(this, set_.hub.udp_backend);
+        transport_->setObjectName(
+            QString("transport-gNB-host-%1").arg(range_.id_start));
+    }
+
+    if (!transport_->init(port)) {
+        qCritical() << QString("[gNB host %1+%2] Network setup failed on "
+                               "port %3")
+                           .arg(range_.id_start)
+                           .arg(range_.count)
+                           .arg(port);
+        return false;
+    }
+
+    for (const auto& cell : cells_) {
+        cell->attachTransport(transport_);
+        cell->setPort(transport_->localPort());
+    }
+    connect(transport_, &UdpTransport::dataReceived, this,
+            &GnbHost::onDatagram, Qt::DirectConnection);
+
+    qDebug() << QString("[gNB host %1+%2] Network is UP on port %3")
+                    .arg(range_.id_start)
+                    .arg(range_.count)
+                    .arg(transport_->localPort());
+    return true;
+}
+
+void GnbHost::layOut(QPointF center, double spacing)
+{
+    const auto side = static_cast<size_t>(
+        std::ceil(std::sqrt(static_cast<double>(cells_.size()))));
+    const double origin = -0.5 * spacing * static_cast<double>(side - 1);
+    for (size_t i = 0; i < cells_.size(); ++i) {
+        const double x = origin + spacing * static_cast<double>(i % side);
+        const double y = origin + spacing * static_cast<double>(i / side);
+        cells_[i]->setPosition(center + QPointF(x, y));
+    }
+}
+
+void GnbHost::registerAtHub()
+{
+    next_to_register_ = 0;
+    registerNextCells();
+}
+
+void GnbHost::registerNextCells()
+{
+    const size_t per_interval =
+        std::max<size_t>(set_.host.registrations_per_interval, 1);
+    const size_t end =
+        std::min(cells_.size(), next_to_register_ + per_interval);
+    for (size_t i = next_to_register_; i < end; ++i) {
+        cells_[i]->registerAtHub();
+    }
+
+    next_to_register_ = end;
+    if (next_to_register_ < cells_.size()) {
+        registration_deadline_.start(set_.host.registration_interval_ms,
+                                     [this]() { registerNextCells(); });
+    }
+}
+
+void GnbHost::run()
+{
+    for (size_t i = 0; i < cells_.size(); ++i) {
+        const auto interval = cells_[i]->broadcastInterval();
+        cells_[i]->setBroadcastOffset(
+            interval * static_cast<int64_t>(i) /
+            static_cast<int64_t>(cells_.size()));
+        cells_[i]->run();
+    }
+
+    qDebug() << QString("gNB host %1+%2 started")
+                    .arg(range_.id_start)
+                    .arg(range_.count);
+}
+
+GnbLogic* GnbHost::cell(uint32_t id) const
+{
+    if (id < range_.id_start || id - range_.id_start >= cells_.size()) {
+        return nullptr;
+    }
+    return cells_[id - range_.id_start].get();
+}
+
+size_t GnbHost::size() const
+{
+    return cells_.size();
+}
+
+void GnbHost::onDatagram(const QByteArray& data, const QHostAddress& addr,
+                         quint16 port)
+{
+    const SimProtocol::HeaderView header = SimProtocol::peekHeader(data);
+    if (!header.isValid) {
+        return;
+    }
+
+    if (header.isBroadcast(set_.hub.broadcast_id)) {
+        for (const auto& cell : cells_) {
+            cell->handleIncomingRawData(data, addr, port);
+        }
+        return;
+    }
+
+    if (GnbLogic* target = cell(header.dstId)) {
+        target->handleIncomingRawData(data, addr, port);
+    }
+}
@@ -5,18 +5,26 @@
 
 #include "flow_logger.hpp"
 
-GnbLogic::GnbLogic(const uint32_t id, const GnbSettings set, QObject* parent)
+GnbLogic::GnbLogic(const uint32_t id, const GnbSettings set, QObject* parent,
+                   TimerScheduler& scheduler)
     : BaseEntity(id, EntityType::GNB, set.hub, parent)
+    , scheduler_(scheduler)
+    , sib1_deadline_(scheduler)
     , radius_(set.radius)
 {
-    main_timer_ = new QTimer(this);
-    main_timer_->setInterval(set.radio.radio_frame_duration);
-    connect(main_timer_, &QTimer::timeout, this, &GnbLogic::onTick);
-    last_broadcast_ = std::chrono::steady_clock::now();
+    setTxPower(set.radio.tx_power_db);
     connect(this, &BaseEntity::registrationAtRadioHubConfirmed, this,
             &GnbLogic::sendBroadcastInfo);
 }
 
+GnbCellConfig GnbLogic::cellConfig(const GnbSettings& set)
+{
+    GnbCellConfig config({{255, 1}, {255, 2}}, 2);
+    config.tac = set.cell.tracking_area_code;
+    config.txPowerDb = set.radio.tx_power_db;
+    return config;
+}
+
 void GnbLogic::setCellConfig(const GnbCellConfig& config)
 {
     cellConfig_ = config;
@@ -24,8 +32,16 @@ void GnbLogic::setCellConfig(const GnbCellConfig& config)
 
 void GnbLogic::run()
 {
-    qDebug() << "GNB #" << id_ << " timer starts";
-    main_timer_->start();
+    qDebug() << "GNB #" << id_ << " SIB1 schedule starts";
+    scheduleBroadcast(first_broadcast_delay_);
+}
+
+void GnbLogic::scheduleBroadcast(std::chrono::milliseconds delay)
+{
+    sib1_deadline_.start(static_cast<uint32_t>(delay.count()), [this]() {
+        sendBroadcastInfo();
+        scheduleBroadcast(broadcast_interval_);
+    });
 }
 
 uint32_t GnbLogic::getConnectedUeCount() const
@@ -38,6 +54,19 @@ double GnbLogic::getRadius() const
     return radius_;
 }
 
+std::chrono::milliseconds GnbLogic::broadcastInterval() const
+{
+    return broadcast_interval_;
+}
+
+void GnbLogic::setBroadcastOffset(std::chrono::milliseconds offset)
+{
+    first_broadcast_delay_ = offset;
+    if (sib1_deadline_.isActive()) {
+        scheduleBroadcast(offset);
+    }
+}
+
 EntityType GnbLogic::getType() const
 {
     return type_;
@@ -48,36 +77,38 @@ NodeInfo GnbLogic::getNodeInfo() const
     return {id_, type_, QHostAddress::LocalHost, port_, position_, getData()};
 }
 
-void GnbLogic::onTick()
+void GnbLogic::watchInactivity(uint32_t ue_id, std::chrono::milliseconds delay)
 {
-    auto now = std::chrono::steady_clock::now();
+    inactivity_deadlines_.try_emplace(ue_id, scheduler_).first->second.start(
+        static_cast<uint32_t>(delay.count()),
+        [this, ue_id]() { onInactivityDeadline(ue_id); });
+}
 
-    if (now - last_broadcast_ >= broadcast_interval_) {
-        sendBroadcastInfo();
-        last_broadcast_ = now;
+void GnbLogic::onInactivityDeadline(uint32_t ue_id)
+{
+    auto it = ue_contexts_.find(ue_id);
+    if (it == ue_contexts_.end() ||
+        it.value().state != UeRrcState::RRC_CONNECTED) {
+        inactivity_deadlines_.erase(ue_id);
+        ue_sinr_db_.remove(ue_id);
+        return;
     }
 
-    const std::chrono::seconds inactivity_timeout(30);
-
-    QMutableMapIterator<uint32_t, UeContext> it(ue_contexts_);
-    while (it.hasNext()) {
-        it.next();
-        UeContext& ctx = it.value();
-
-        if (it.value().state == UeRrcState::RRC_CONNECTED) {
-            auto duration_idle =
-                std::chrono::duration_cast<std::chrono::seconds>(
-                    now - ctx.last_activity);
+    UeContext& ctx = it.value();
+    const auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - ctx.last_activity);
+    if (idle < inactivity_timeout_) {
+        watchInactivity(ue_id, inactivity_timeout_ - idle);
+        return;
+    }
 
-            if (duration_idle > inactivity_timeout) {
-                qDebug() << "[gNB] Inactivity timeout for UE" << it.key();
-                sendRrcRelease(it.key(), RrcReleaseCause::UserInactivity);
+    qDebug() << "[gNB] Inactivity timeout for UE" << ue_id;
+    sendRrcRelease(ue_id, RrcReleaseCause::UserInactivity);
 
-                ctx.state = UeRrcState::RRC_IDLE;
-                ctx.is_attached = false;
-            }
-        }
-    }
+    ctx.state = UeRrcState::RRC_IDLE;
+    ctx.is_attached = false;
+    inactivity_deadlines_.erase(ue_id);
+    ue_sinr_db_.remove(ue_id);
 }
 
 void GnbLogic::onProtocolMessageReceived(uint32_t ue_id, ProtocolMsgType type,
@@ -185,6 +216,23 @@ GnbData GnbLogic::getData() const
     return {radius_, getConnectedUeCount()};
 }
 
+std::optional<double> GnbLogic::ueSinrDb(uint32_t ue_id) const
+{
+    const auto it = ue_sinr_db_.constFind(ue_id);
+    if (it == ue_sinr_db_.constEnd()) {
+        return std::nullopt;
+    }
+    return it.value();
+}
+
+void GnbLogic::onSinrReport(
+    const std::vector<SimProtocol::SinrSample>& samples)
+{
+    for (const SimProtocol::SinrSample& sample : samples) {
+        ue_sinr_db_.insert(sample.ueId, sample.sinrDb);
+    }
+}
+
 void GnbLogic::handleUeData(uint32_t sender_ue_id, const QByteArray& payload)
 {
     if (!ue_contexts_.contains(sender_ue_id)) {
@@ -287,8 +335,8 @@ void GnbLogic::handleRegistrationRequest(uint32_t ue_id,
 
 QByteArray GnbLogic::getRegistrationPayload() const
 {
-    const QByteArray payload =
-        serializer_->serializeRegistrationPayload(radius_);
+    const QByteArray payload = serializer_->serializeRegistrationPayload(
+        {radius_, txPower(), cellConfig_.minRxLevel});
 
     return payload;
 }
@@ -432,6 +480,7 @@ void GnbLogic::handleRrcSetupComplete(uint32_t ue_id, const QByteArray& payload)
     ctx.is_attached = true;
     ctx.selected_plmn = info.plmn;
     ctx.last_activity = std::chrono::steady_clock::now();
+    watchInactivity(ue_id, inactivity_timeout_);
 
     FlowLogger::log(type_, id_, ue_id, ProtocolMsgType::RrcSetupComplete, true);
 
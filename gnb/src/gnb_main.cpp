@@ -7,8 +7,43 @@
 #include <QHostAddress>
 
 #include "config_manager.hpp"
+#include "gnb_host.hpp"
 #include "gnb_logic.hpp"
 
+namespace {
+
+int runHost(QCoreApplication& app)
+{
+    const auto& config = ConfigManager::instance();
+    auto context = config.getGnbHostContext();
+
+    if (!context) {
+        return EXIT_FAILURE;
+    }
+
+    GnbHost host(context->range, context->set);
+    const Point2D hub_pos = context->set.hub.virt_pos;
+    host.layOut(QPointF{hub_pos.X, hub_pos.Y},
+                context->set.host.grid_spacing_m);
+    for (uint32_t i = 0; i < context->range.count; ++i) {
+        const uint32_t id = context->range.id_start + i;
+        if (const auto pos = config.getGnbPosition(id)) {
+            host.cell(id)->setPosition(QPointF{pos->X, pos->Y});
+        }
+    }
+
+    if (!host.setupNetwork(NetworkParam::EPHEMERAL_PORT)) {
+        return EXIT_FAILURE;
+    }
+
+    host.registerAtHub();
+    host.run();
+
+    return app.exec();
+}
+
+}  // namespace
+
 int main(int argc, char* argv[])
 {
     QCoreApplication a(argc, argv);
@@ -20,6 +55,10 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    if (ConfigManager::instance().getHostRange()) {
+        return runHost(a);
+    }
+
     auto context = ConfigManager::instance().getGnbContext();
 
     if (!context) {
@@ -0,0 +1,81 @@
+#include "gnb_host.hpp"
+
+#include <QSignalSpy>
+#include <QtTest/QTest>
+
+#include "gnb_logic_test.hpp"
+
+namespace {
+
+GnbSettings inProcessSettings()
+{
+    HubSettings hub_set = TestData::HUB_SET;
+    hub_set.udp_backend = UdpBackend::InProcess;
+    GnbSettings set(hub_set, TestData::RADIO, TestData::CELL,
+                    TestData::RADIUS);
+    set.host.registrations_per_interval = 2;
+    return set;
+}
+
+}  // namespace
+
+TEST(GnbHostTest, CellsRegisterSeparatelyAndShareOnePort)
+{
+    UdpTransport hub(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(hub.init(TestData::HUB_PORT));
+    QSignalSpy hub_spy(&hub, &UdpTransport::dataReceived);
+
+    GnbHost host(HostRange{10, 3}, inProcessSettings());
+    ASSERT_EQ(host.size(), 3u);
+    EXPECT_EQ(host.cell(13), nullptr);
+    ASSERT_TRUE(host.setupNetwork(0));
+
+    host.registerAtHub();
+    QTest::qWait(50);
+    ASSERT_EQ(hub_spy.count(), 3);
+
+    for (int i = 0; i < hub_spy.count(); ++i) {
+        const auto packet =
+            SimProtocol::parse(hub_spy.at(i).at(0).toByteArray());
+        EXPECT_EQ(packet.type, SimMessageType::Registration);
+        EXPECT_EQ(packet.srcId, 10u + static_cast<uint32_t>(i));
+        EXPECT_EQ(hub_spy.at(i).at(2).value<quint16>(),
+                  hub_spy.at(0).at(2).value<quint16>());
+    }
+}
+
+TEST(GnbHostTest, LayOutGivesEveryCellItsOwnPosition)
+{
+    GnbHost host(HostRange{10, 4}, inProcessSettings());
+    host.layOut(QPointF(100.0, 100.0), 1000.0);
+
+    EXPECT_EQ(host.cell(10)->position(), QPointF(-400.0, -400.0));
+    EXPECT_EQ(host.cell(11)->position(), QPointF(600.0, -400.0));
+    EXPECT_EQ(host.cell(12)->position(), QPointF(-400.0, 600.0));
+    EXPECT_EQ(host.cell(13)->position(), QPointF(600.0, 600.0));
+}
+
+TEST(GnbHostTest, DatagramReachesOnlyItsCell)
+{
+    UdpTransport hub(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(hub.init(TestData::HUB_PORT));
+
+    GnbHost host(HostRange{10, 2}, inProcessSettings());
+    ASSERT_TRUE(host.setupNetwork(0));
+    QSignalSpy first_spy(host.cell(10),
+                         &BaseEntity::registrationAtRadioHubConfirmed);
+    QSignalSpy second_spy(host.cell(11),
+                          &BaseEntity::registrationAtRadioHubConfirmed);
+
+    QByteArray status;
+    status.append(static_cast<char>(HubResponse::REG_ACCEPTED));
+    hub.sendData(SimProtocol::buildPacket(TestData::HUB_ID,
+                                          EntityType::RadioHub, 11,
+                                          SimMessageType::RegistrationResponse,
+                                          QPointF(), status),
+                 QHostAddress::LocalHost, host.cell(11)->port());
+    QCoreApplication::processEvents();
+
+    EXPECT_EQ(first_spy.count(), 0);
+    EXPECT_EQ(second_spy.count(), 1);
+}
@@ -1,6 +1,11 @@
 #include "gnb_logic_test.hpp"
 
+#include <QCoreApplication>
+#include <QSignalSpy>
+
 #include "qdatastream_serializer.hpp"
+#include "sim_protocol.hpp"
+#include "udp_transport.hpp"
 
 class GnbLogicTest : public Test
 {
@@ -8,7 +13,7 @@ protected:
     void SetUp() override
     {
         gnb = new StrictMock<MockGnbLogic>(TestData::GNB_ID,
-                                           TestData::GNB_SETTINGS);
+                                           TestData::GNB_SETTINGS, scheduler);
 
         serializer_ = std::make_unique<QDataStreamSerializer>();
         config.tac = 123;
@@ -25,6 +30,9 @@ protected:
         delete gnb;
     }
 
+    // Deadlines fire only when a test moves now_ms and calls fireDue().
+    uint64_t now_ms = 0;
+    TimerScheduler scheduler{nullptr, [this] { return now_ms; }};
     StrictMock<MockGnbLogic>* gnb;
     GnbCellConfig config;
     std::unique_ptr<ISerializer> serializer_;
@@ -124,11 +132,45 @@ TEST_F(GnbLogicTest, Inactivity_Timeout_Release)
     ctx.last_activity =
         std::chrono::steady_clock::now() - std::chrono::seconds(40);
     gnb->ue_contexts_[ue_id] = ctx;
+    gnb->onSinrReport({{ue_id, 12.0}});
 
     EXPECT_CALL(*gnb, sendSimData(ProtocolMsgType::RrcRelease, _, ue_id))
         .Times(1);
 
-    gnb->onTick();
+    gnb->onInactivityDeadline(ue_id);
+
+    EXPECT_FALSE(gnb->ueSinrDb(ue_id).has_value());
+}
+
+TEST_F(GnbLogicTest, Inactivity_Deadline_Waits_For_Rest_Of_Timeout)
+{
+    uint32_t ue_id = 889;
+    UeContext ctx;
+    ctx.id = ue_id;
+    ctx.state = UeRrcState::RRC_CONNECTED;
+    ctx.last_activity =
+        std::chrono::steady_clock::now() - std::chrono::seconds(10);
+    gnb->ue_contexts_[ue_id] = ctx;
+
+    gnb->onInactivityDeadline(ue_id);
+
+    EXPECT_EQ(gnb->ue_contexts_[ue_id].state, UeRrcState::RRC_CONNECTED);
+}
+
+TEST_F(GnbLogicTest, Sib1_Follows_Broadcast_Offset)
+{
+    gnb->setBroadcastOffset(std::chrono::milliseconds(30));
+    gnb->run();
+
+    // A StrictMock fails on any SIB1 sent before the offset.
+    now_ms = 29;
+    scheduler.fireDue();
+
+    EXPECT_CALL(*gnb, sendSimData(ProtocolMsgType::Sib1, _,
+                                  TestData::BROADCAST_ID))
+        .Times(1);
+    now_ms = 30;
+    scheduler.fireDue();
 }
 
 TEST_F(GnbLogicTest, Handle_Registration_Request_Success)
@@ -154,3 +196,68 @@ TEST_F(GnbLogicTest, Handle_Registration_Request_Success)
     gnb->onProtocolMessageReceived(ue_id, ProtocolMsgType::RegistrationRequest,
                                    valid_request_payload);
 }
+
+TEST(GnbInProcessLoopbackTest, Registration_Round_Trip_Without_Sockets)
+{
+    HubSettings hub_set = TestData::HUB_SET;
+    hub_set.udp_backend = UdpBackend::InProcess;
+    const GnbSettings settings(hub_set, TestData::RADIO, TestData::CELL,
+                               TestData::RADIUS);
+
+    UdpTransport hub(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(hub.init(TestData::HUB_PORT));
+    QSignalSpy hub_spy(&hub, &UdpTransport::dataReceived);
+
+    GnbLogic gnb(TestData::GNB_ID, settings);
+    ASSERT_TRUE(gnb.setupNetwork(0));
+    QSignalSpy registered_spy(&gnb,
+                              &BaseEntity::registrationAtRadioHubConfirmed);
+
+    gnb.registerAtHub();
+    // Delivery is queued, so it happens on the next event-loop turn only.
+    EXPECT_EQ(hub_spy.count(), 0);
+    QCoreApplication::processEvents();
+    ASSERT_EQ(hub_spy.count(), 1);
+
+    const QByteArray request = hub_spy.at(0).at(0).toByteArray();
+    const quint16 gnb_port = hub_spy.at(0).at(2).value<quint16>();
+    EXPECT_EQ(gnb_port, gnb.port());
+    EXPECT_EQ(SimProtocol::parse(request).type, SimMessageType::Registration);
+
+    QByteArray status;
+    status.append(static_cast<char>(HubResponse::REG_ACCEPTED));
+    ASSERT_FALSE(hub.sendData(SimProtocol::buildPacket(
+                                  TestData::HUB_ID, EntityType::RadioHub,
+                                  TestData::GNB_ID,
+                                  SimMessageType::RegistrationResponse,
+                                  QPointF(), status),
+                              QHostAddress::LocalHost, gnb_port)
+                     .is_socket_error_);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(registered_spy.count(), 1);
+
+    // Only loopback is stood in for; a remote peer is never reachable.
+    EXPECT_TRUE(hub.sendData(status, QHostAddress("10.0.0.2"), gnb_port)
+                    .is_socket_error_);
+}
+
+TEST(GnbBundlingTest, Pdu_Queued_While_Flushing_Is_Sent)
+{
+    HubSettings hub_set = TestData::HUB_SET;
+    hub_set.bundling.enabled = true;
+    const GnbSettings settings(hub_set, TestData::RADIO, TestData::CELL,
+                               TestData::RADIUS);
+    ReplyingGnbLogic gnb(TestData::GNB_ID, settings);
+
+    gnb.sendSimData(ProtocolMsgType::Paging, "first", 5);
+    gnb.sendSimData(ProtocolMsgType::Paging, "second", 6);
+    // The reply queued during the first flush goes out with the next one.
+    QCoreApplication::processEvents();
+    QCoreApplication::processEvents();
+    ASSERT_EQ(gnb.sent.size(), 2u);
+    EXPECT_EQ(SimProtocol::view(gnb.sent[0]).type, SimMessageType::Bundle);
+    const auto reply = SimProtocol::view(gnb.sent[1]);
+    EXPECT_EQ(reply.protocolType(), ProtocolMsgType::RrcRelease);
+    EXPECT_EQ(reply.dstId, 7u);
+    EXPECT_EQ(reply.protocolPayload(), QByteArray("reply"));
+}
@@ -16,14 +16,13 @@ using namespace ::testing;
 namespace TestData {
 constexpr uint32_t GNB_ID = 1;
 constexpr double RADIUS = 1200.0;
-constexpr int RADIO_FRAME_DURATION = 10;
 constexpr double TXP = 43.0;
 constexpr uint32_t HUB_ID = 0;
 constexpr uint16_t HUB_PORT = 5555;
 constexpr uint32_t BROADCAST_ID = 0xFFFFFFFF;
 constexpr Point2D VIRT_POS{0.0, 0.0};
 const std::string ADDRESS("127.0.0.1");
-const RadioSettings RADIO{RADIO_FRAME_DURATION, TXP};
+const RadioSettings RADIO{TXP};
 constexpr Cell CELL{100};
 const HubSettings HUB_SET{HUB_PORT, HUB_ID, BROADCAST_ID, VIRT_POS, ADDRESS};
 const GnbSettings GNB_SETTINGS(HUB_SET, RADIO, CELL, RADIUS);
@@ -75,8 +74,9 @@ MATCHER_P2(HasRegistrationResponse, expected_status, expected_reasone, "")
 class MockGnbLogic : public GnbLogic
 {
 public:
-    MockGnbLogic(uint32_t id, GnbSettings set)
-        : GnbLogic(id, set)
+    MockGnbLogic(uint32_t id, GnbSettings set,
+                 TimerScheduler& scheduler = TimerScheduler::local())
+        : GnbLogic(id, set, nullptr, scheduler)
     {
     }
 
@@ -89,9 +89,33 @@ public:
     using GnbLogic::cellConfig_;
     using GnbLogic::handleRegistrationRequest;
     using GnbLogic::onProtocolMessageReceived;
-    using GnbLogic::onTick;
+    using GnbLogic::onInactivityDeadline;
+    using GnbLogic::onSinrReport;
     using GnbLogic::sendBroadcastInfo;
     using GnbLogic::ue_contexts_;
 };
 
+// Captures what it sends to the hub; the first send queues a reply PDU,
+// as a reply delivered straight back would.
+class ReplyingGnbLogic : public GnbLogic
+{
+public:
+    using GnbLogic::GnbLogic;
+    using GnbLogic::sendSimData;
+
+    std::vector<QByteArray> sent;
+
+protected:
+    sendingResult sendToHub(const QByteArray& packet) override
+    {
+        sent.push_back(packet);
+        if (sent.size() == 1) {
+            sendSimData(ProtocolMsgType::RrcRelease, "reply", 7);
+        }
+        sendingResult result;
+        result.bytes_ = packet.size();
+        return result;
+    }
+};
+
 #endif  // GNB_LOGIC_TEST_HPP
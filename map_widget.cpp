@@ -52,7 +52,8 @@ void MapWidget::paintEvent(QPaintEvent*)
     }
 
     for (auto ue_info : controller_->getUeSnapshots()) {
-        drawUe(p, ue_info.id, ue_info.position, ue_info.data.is_connected);
+        drawUe(p, ue_info.id, ue_info.position, ue_info.data.is_connected,
+               ue_info.data.sinr_db);
     }
 }
 
@@ -101,12 +102,23 @@ void MapWidget::drawGnb(QPainter& p, uint32_t id, const QPointF& pos,
 }
 
 void MapWidget::drawUe(QPainter& p, uint32_t id, const QPointF& pos,
-                       bool connected)
+                       bool connected, double sinr_db)
 {
     double r = 6.0 / scale_;
     p.setBrush(connected ? Qt::green : Qt::red);
     p.setPen(Qt::black);
     p.drawEllipse(pos, r, r);
+
+    if (std::isnan(sinr_db)) {
+        return;
+    }
+    p.save();
+    p.resetTransform();
+    const QPointF screen_pos = (pos + camera_offset_) * scale_ +
+                               QPointF(width() / 2.0, height() / 2.0);
+    p.drawText(screen_pos + QPointF(10, 4),
+               QString("%1 dB").arg(sinr_db, 0, 'f', 1));
+    p.restore();
 }
 
 void MapWidget::wheelEvent(QWheelEvent* event)
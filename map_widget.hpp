@@ -24,7 +24,8 @@ protected:
 
     void drawGrid(QPainter& p);
     void drawGnb(QPainter& p, uint32_t id, const QPointF& pos, double radius);
-    void drawUe(QPainter& p, uint32_t id, const QPointF& pos, bool connected);
+    void drawUe(QPainter& p, uint32_t id, const QPointF& pos, bool connected,
+                double sinr_db);
 
 private:
     std::shared_ptr<SimulationController> controller_;
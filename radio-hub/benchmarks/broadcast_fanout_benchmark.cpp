@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+
+#include <QHash>
+#include <QLineF>
+#include <QPointF>
+
+#include "spatial_grid.hpp"
+
+namespace {
+
+constexpr double MAP_HALF_SIZE = 50000.0;
+constexpr double GNB_RADIUS = 1200.0;
+constexpr double CELL_SIZE = 500.0;
+constexpr size_t GNB_SAMPLES = 64;
+
+std::vector<QPointF> makePositions(size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(-MAP_HALF_SIZE,
+                                                 MAP_HALF_SIZE);
+    std::vector<QPointF> positions;
+    positions.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        positions.emplace_back(coord(rng), coord(rng));
+    }
+    return positions;
+}
+
+// Mirrors the former RadioHub::broadcastFromGbn loop: every UE is visited
+// and its distance to the gNB is computed.
+void BM_BroadcastLinearScan(benchmark::State& state)
+{
+    const size_t ue_count = static_cast<size_t>(state.range(0));
+    const auto ue_positions = makePositions(ue_count, 1);
+    const auto gnb_positions = makePositions(GNB_SAMPLES, 2);
+
+    QHash<uint32_t, QPointF> ues;
+    for (size_t i = 0; i < ue_count; ++i) {
+        ues.insert(static_cast<uint32_t>(i), ue_positions[i]);
+    }
+
+    size_t gnb_index = 0;
+    for (auto _ : state) {
+        const QPointF& gnb_pos = gnb_positions[gnb_index++ % GNB_SAMPLES];
+        size_t delivered = 0;
+        for (auto it = ues.cbegin(); it != ues.cend(); ++it) {
+            if (QLineF(gnb_pos, it.value()).length() <= GNB_RADIUS) {
+                ++delivered;
+            }
+        }
+        benchmark::DoNotOptimize(delivered);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_BroadcastSpatialGrid(benchmark::State& state)
+{
+    const size_t ue_count = static_cast<size_t>(state.range(0));
+    const auto ue_positions = makePositions(ue_count, 1);
+    const auto gnb_positions = makePositions(GNB_SAMPLES, 2);
+
+    SpatialGrid grid(CELL_SIZE);
+    for (size_t i = 0; i < ue_count; ++i) {
+        grid.insert(static_cast<uint32_t>(i), ue_positions[i]);
+    }
+
+    size_t gnb_index = 0;
+    for (auto _ : state) {
+        const QPointF& gnb_pos = gnb_positions[gnb_index++ % GNB_SAMPLES];
+        size_t delivered = 0;
+        grid.forEachInRadius(gnb_pos, GNB_RADIUS,
+                             [&delivered](uint32_t, const QPointF&) {
+                                 ++delivered;
+                             });
+        benchmark::DoNotOptimize(delivered);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SpatialGridMove(benchmark::State& state)
+{
+    const size_t ue_count = static_cast<size_t>(state.range(0));
+    const auto ue_positions = makePositions(ue_count, 1);
+    const auto moves = makePositions(ue_count, 3);
+
+    SpatialGrid grid(CELL_SIZE);
+    for (size_t i = 0; i < ue_count; ++i) {
+        grid.insert(static_cast<uint32_t>(i), ue_positions[i]);
+    }
+
+    size_t index = 0;
+    for (auto _ : state) {
+        const size_t ue = index++ % ue_count;
+        grid.move(static_cast<uint32_t>(ue), moves[ue]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_BroadcastLinearScan)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_BroadcastSpatialGrid)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_SpatialGridMove)->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "shm_ring.hpp"
+
+namespace {
+
+constexpr size_t RING_BYTES = 1 << 20;
+constexpr size_t BATCH = 32;
+
+// Per-datagram cost of the node <-> hub path for a burst of BATCH messages
+// of state.range(0) bytes: write them all, then read them all back.
+void BM_ShmRingBurst(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    const std::vector<char> message(size, 'x');
+
+    ShmRingControl control;
+    std::vector<char> memory(RING_BYTES);
+    ShmRing ring(&control, memory.data(), RING_BYTES);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < BATCH; ++i) {
+            ring.push(message.data(), message.size());
+            benchmark::DoNotOptimize(ring.needsWakeup());
+        }
+        size_t received = 0;
+        ring.drain([&received](const char* data, size_t length) {
+            benchmark::DoNotOptimize(data);
+            received += length;
+        });
+        benchmark::DoNotOptimize(received);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+}
+BENCHMARK(BM_ShmRingBurst)->Arg(64)->Arg(512);
+
+void BM_LoopbackUdpBurst(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    const std::vector<char> message(size, 'x');
+    std::vector<char> buffer(2048);
+
+    const int rx = ::socket(AF_INET, SOCK_DGRAM, 0);
+    const int tx = ::socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (::bind(rx, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::getsockname(rx, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+        state.SkipWithError("loopback socket unavailable");
+        return;
+    }
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < BATCH; ++i) {
+            ::sendto(tx, message.data(), message.size(), 0,
+                     reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        }
+        size_t received = 0;
+        for (size_t i = 0; i < BATCH; ++i) {
+            const ssize_t length =
+                ::recv(rx, buffer.data(), buffer.size(), 0);
+            received += length > 0 ? static_cast<size_t>(length) : 0;
+        }
+        benchmark::DoNotOptimize(received);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+
+    ::close(tx);
+    ::close(rx);
+}
+BENCHMARK(BM_LoopbackUdpBurst)->Arg(64)->Arg(512);
+
+}  // namespace
@@ -0,0 +1,60 @@
+#ifndef COVERAGE_TABLE_HPP
+#define COVERAGE_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QHash>
+#include <QSet>
+
+/**
+ * @brief UEs covered by one gNB as dense columns for broadcast fan-out.
+ * Each UE keeps its NodeRegistry slot next to its id, so the fan-out never
+ * goes through the id index.
+ */
+struct CoveredUes {
+    std::vector<uint32_t> ids;
+    std::vector<uint32_t> slots;
+    QHash<uint32_t, uint32_t> positions;  // UE id -> index in the columns
+
+    size_t size() const
+    {
+        return ids.size();
+    }
+    bool isEmpty() const
+    {
+        return ids.empty();
+    }
+};
+
+/**
+ * @brief Cached gNB <-> UE coverage membership.
+ * Both directions are kept in sync so that broadcast fan-out and unicast
+ * coverage checks are plain lookups. The table is only rewritten when
+ * a node moves, registers or deregisters; UE slots follow the registry
+ * through renumberUe().
+ */
+class CoverageTable
+{
+public:
+    void assignUe(uint32_t ue_id, uint32_t ue_slot,
+                  const QSet<uint32_t>& gnb_ids);
+    // ue_slots maps every covered UE id to its registry slot.
+    void assignGnb(uint32_t gnb_id, const QHash<uint32_t, uint32_t>& ue_slots);
+    // The registry moved a UE to another slot.
+    void renumberUe(uint32_t ue_id, uint32_t ue_slot);
+
+    void removeUe(uint32_t ue_id);
+    void removeGnb(uint32_t gnb_id);
+
+    bool covers(uint32_t gnb_id, uint32_t ue_id) const;
+    const CoveredUes& uesOf(uint32_t gnb_id) const;
+    const QSet<uint32_t>& gnbsOf(uint32_t ue_id) const;
+
+private:
+    QHash<uint32_t, CoveredUes> gnb_to_ues_;
+    QHash<uint32_t, QSet<uint32_t>> ue_to_gnbs_;
+};
+
+#endif  // COVERAGE_TABLE_HPP
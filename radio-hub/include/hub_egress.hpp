@@ -0,0 +1,99 @@
+#ifndef HUB_EGRESS_HPP
+#define HUB_EGRESS_HPP
+
+#include <cstdint>
+#include <functional>
+#include <random>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QObject>
+
+#include "liveness_tracker.hpp"
+#include "timing_wheel.hpp"
+
+struct HubThreadMetrics;
+class QTimer;
+class ShmRouter;
+class UdpTransport;
+
+/**
+ * @brief Outbound path of one RadioHub routing thread.
+ * Immediate packets go straight to the thread's UdpTransport, or into the
+ * node's shared-memory ring when it has one. Delayed
+ * packets wait in a millisecond timing wheel driven by one single-shot
+ * timer, so any number of in-flight packets costs O(1) per insert/expiry.
+ * With a quarantine enabled, endpoints that keep failing are skipped,
+ * counting both failed sends and errors the transport reports later. The
+ * quarantine is the hub's, so a datagram from an endpoint on any thread
+ * makes it reachable again for all of them.
+ * With a send sink set, nothing leaves the process.
+ */
+class HubEgress : public QObject
+{
+    Q_OBJECT
+public:
+    using SendSink = std::function<void(
+        const QByteArray& data, const QHostAddress& address, quint16 port)>;
+
+    HubEgress(UdpTransport* transport, uint32_t lane,
+              const ShmRouter* shm = nullptr, QObject* parent = nullptr);
+
+    void send(const QByteArray& data, const QHostAddress& address,
+              quint16 port, uint32_t delay_ms = 0);
+
+    UdpTransport* transport() const;
+    /**
+     * @brief Index of the owning routing thread, used for per-thread state
+     * such as the signaling capture ring.
+     */
+    uint32_t lane() const;
+    std::mt19937& rng();
+    size_t inFlight() const;
+
+    /**
+     * @brief Counts send errors into stats and into quarantine, and skips
+     * the endpoints quarantine blocks. quarantine must outlive the egress.
+     */
+    void enableQuarantine(SendQuarantine* quarantine, HubThreadMetrics* stats);
+    // A datagram arrived from the endpoint: it is reachable again.
+    void noteHeardFrom(const QHostAddress& address, quint16 port);
+
+    /**
+     * @brief Hands every outgoing datagram to sink instead of sending it,
+     * e.g. while replaying recorded traffic.
+     */
+    void setSendSink(SendSink sink);
+
+private:
+    struct DelayedPacket {
+        QByteArray data;
+        QHostAddress address;
+        quint16 port = 0;
+    };
+
+    uint64_t nowMs() const;
+    void onTimer();
+    void releaseDue();
+    void armTimer();
+    void transmit(const QByteArray& data, const QHostAddress& address,
+                  quint16 port);
+    void recordSendError(const QHostAddress& address, quint16 port);
+
+    UdpTransport* transport_;
+    const ShmRouter* shm_;
+    const uint32_t lane_;
+    QTimer* timer_;
+    QElapsedTimer clock_;
+    TimingWheel<DelayedPacket> delayed_;
+    // Due time the timer is armed for; may be earlier than the next
+    // packet, never later.
+    uint64_t next_due_ms_ = TimingWheel<DelayedPacket>::NEVER;
+    SendQuarantine* quarantine_ = nullptr;
+    HubThreadMetrics* stats_ = nullptr;
+    SendSink sink_;
+    std::mt19937 rng_;
+};
+
+#endif  // HUB_EGRESS_HPP
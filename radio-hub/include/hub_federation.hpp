@@ -0,0 +1,75 @@
+#ifndef HUB_FEDERATION_HPP
+#define HUB_FEDERATION_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QPointF>
+
+#include "region_map.hpp"
+#include "settings.hpp"
+#include "types.hpp"
+
+/**
+ * @brief Hub-to-hub node record carried in SimMessageType::HubSync.
+ * Sync and Remove maintain mirrors of border nodes, Handoff moves the
+ * ownership of a node (with its own endpoint) to the receiving hub.
+ */
+struct PeerNodeRecord {
+    enum class Op : uint8_t {
+        Sync = 0,
+        Remove = 1,
+        Handoff = 2
+    };
+
+    Op op = Op::Sync;
+    uint32_t id = 0;
+    EntityType type = EntityType::UNKNOWN;
+    QPointF position;
+    GnbRegistrationInfo radio;
+    QHostAddress address;
+    quint16 port = 0;
+    bool isValid = false;
+};
+
+/**
+ * @brief Region ownership and peer bookkeeping of one federated RadioHub.
+ * Not thread-safe: RadioHub calls it under its registry write lock.
+ */
+class HubFederation
+{
+public:
+    explicit HubFederation(const FederationSettings& settings);
+
+    bool isEnabled() const;
+    quint16 ownPort() const;
+
+    /**
+     * @brief Index of the peer region that owns position, NONE when this
+     * hub owns it (including positions outside every region).
+     */
+    uint32_t ownerIndex(const QPointF& position) const;
+    uint32_t peerIndex(const QHostAddress& address, quint16 port) const;
+    const QHostAddress& peerAddress(uint32_t index) const;
+    quint16 peerPort(uint32_t index) const;
+
+    // Peers that must hold a mirror of a local node at position.
+    uint64_t mirrorTargets(const QPointF& position) const;
+    // Stores the peers now mirroring node_id and returns the previous set.
+    uint64_t exchangeMirrors(uint32_t node_id, uint64_t peers);
+
+    static QByteArray encode(const PeerNodeRecord& record);
+    static PeerNodeRecord decode(const QByteArray& data);
+
+private:
+    RegionMap regions_;
+    uint32_t own_index_;
+    double border_margin_m_;
+    std::vector<QHostAddress> peer_addresses_;
+    std::unordered_map<uint32_t, uint64_t> mirrors_;
+};
+
+#endif  // HUB_FEDERATION_HPP
@@ -0,0 +1,88 @@
+#ifndef HUB_METRICS_HPP
+#define HUB_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Adds n to a counter that only one thread writes.
+ * A relaxed load and store, no locked read-modify-write.
+ */
+inline void bump(std::atomic<uint64_t>& counter, uint64_t n = 1)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+}
+
+/**
+ * @brief HDR-style log-linear histogram with a single writer.
+ * Every power of two is split into SUB_BUCKETS linear buckets, so the
+ * relative bucket width stays under 1 / SUB_BUCKETS for the whole range.
+ */
+class LogHistogram
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 3;
+    static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_VALUE_BITS = 36;
+    static constexpr size_t BUCKET_COUNT =
+        (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    void record(uint64_t value);
+
+    static size_t bucketOf(uint64_t value);
+    // Largest value that falls into the bucket.
+    static uint64_t bucketUpperBound(size_t bucket);
+
+    uint64_t bucketCount(size_t bucket) const;
+    uint64_t count() const;
+    uint64_t sum() const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+};
+
+/**
+ * @brief Counters of one RadioHub routing thread.
+ * Only the owning thread writes, the metrics endpoint reads.
+ */
+struct alignas(64) HubThreadMetrics {
+    std::atomic<uint64_t> packets_in{0};
+    std::atomic<uint64_t> packets_out{0};
+    std::atomic<uint64_t> dropped_invalid{0};
+    std::atomic<uint64_t> dropped_not_registered{0};
+    std::atomic<uint64_t> dropped_out_of_coverage{0};
+    std::atomic<uint64_t> dropped_link_loss{0};
+    std::atomic<uint64_t> dropped_quarantined{0};
+    std::atomic<uint64_t> send_errors{0};
+    std::atomic<uint64_t> nodes_expired{0};
+    std::atomic<uint64_t> bundled_pdus{0};
+    std::array<std::atomic<uint64_t>, 256> sim_msg_types{};
+    std::array<std::atomic<uint64_t>, 256> protocol_msg_types{};
+    LogHistogram processing_ns;
+    LogHistogram broadcast_fanout;
+};
+
+/**
+ * @brief Per-thread hub metrics and their Prometheus text rendering.
+ */
+class HubMetrics
+{
+public:
+    explicit HubMetrics(uint32_t lane_count);
+
+    HubThreadMetrics& lane(uint32_t index);
+    std::string renderPrometheus() const;
+
+private:
+    std::vector<std::unique_ptr<HubThreadMetrics>> lanes_;
+};
+
+#endif  // HUB_METRICS_HPP
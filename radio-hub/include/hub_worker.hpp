@@ -0,0 +1,41 @@
+#ifndef HUB_WORKER_HPP
+#define HUB_WORKER_HPP
+
+#include <QObject>
+
+#include "hub_egress.hpp"
+#include "shm_router.hpp"
+#include "udp_transport.hpp"
+
+class RadioHub;
+
+/**
+ * @brief One RadioHub routing shard.
+ * Lives in its own QThread and owns a UdpTransport bound to the shared hub
+ * port with SO_REUSEPORT. The kernel spreads senders across the workers,
+ * every worker routes through the shared RadioHub registry.
+ */
+class HubWorker : public QObject
+{
+    Q_OBJECT
+public:
+    HubWorker(uint32_t index, quint16 port, UdpBackend backend,
+              const ShmRouter* shm, RadioHub* hub);
+
+    bool init();
+
+private slots:
+    void onDataReceived(const QByteArray& data, const QHostAddress& sender_ip,
+                        quint16 sender_port);
+
+private:
+    const uint32_t index_;
+    const quint16 port_;
+    const UdpBackend backend_;
+    const ShmRouter* shm_;
+    RadioHub* hub_;
+    UdpTransport* transport_ = nullptr;
+    HubEgress* egress_ = nullptr;
+};
+
+#endif  // HUB_WORKER_HPP
@@ -0,0 +1,41 @@
+#ifndef ID_SLOT_MAP_HPP
+#define ID_SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Open-addressing id -> slot index map.
+ * Linear probing over one flat array kept at most half full; erase shifts
+ * the following entries back instead of leaving tombstones, so lookups
+ * never degrade after churn.
+ */
+class IdSlotMap
+{
+public:
+    static constexpr uint32_t NPOS = UINT32_MAX;
+
+    explicit IdSlotMap(size_t initial_capacity = 16);
+
+    uint32_t find(uint32_t id) const;
+    void assign(uint32_t id, uint32_t slot);
+    bool erase(uint32_t id);
+    size_t size() const;
+
+private:
+    struct Entry {
+        uint32_t id = 0;
+        uint32_t slot = NPOS;
+    };
+
+    static uint32_t hash(uint32_t id);
+    size_t probe(uint32_t id) const;
+    void grow();
+
+    std::vector<Entry> entries_;
+    size_t mask_;
+    size_t size_ = 0;
+};
+
+#endif  // ID_SLOT_MAP_HPP
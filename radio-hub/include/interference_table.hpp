@@ -0,0 +1,78 @@
+#ifndef INTERFERENCE_TABLE_HPP
+#define INTERFERENCE_TABLE_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Received power of one gNB at one UE.
+ */
+struct RxSample {
+    uint32_t id;
+    double rx_dbm;
+};
+
+/**
+ * @brief Per-UE SINR from the received power of every gNB in range.
+ * SINR towards gNB g is S_g / (sum of the other gNBs + noise), in linear
+ * power. Rows are rewritten only for the UE that moved, or for the UEs in
+ * range of the gNB that moved; the sums are rebuilt from a UE's few links,
+ * so they do not drift.
+ */
+class InterferenceTable
+{
+public:
+    explicit InterferenceTable(double noise_floor_dbm = -94.0);
+
+    // Replaces every link of a UE, e.g. after the UE moved.
+    void assignUe(uint32_t ue_id, const std::vector<RxSample>& gnbs);
+    /**
+     * @brief Replaces every link of a gNB and appends the UEs whose SINR
+     * may have changed (in range before or after) to affected_ues.
+     */
+    void assignGnb(uint32_t gnb_id, const std::vector<RxSample>& ues,
+                   std::vector<uint32_t>& affected_ues);
+
+    void removeUe(uint32_t ue_id);
+    void removeGnb(uint32_t gnb_id, std::vector<uint32_t>& affected_ues);
+
+    // NaN when gnb_id is not heard at ue_id.
+    double sinrDb(uint32_t ue_id, uint32_t gnb_id) const;
+    // SINR towards the strongest gNB, NaN for a UE without links.
+    double bestSinrDb(uint32_t ue_id) const;
+
+    /**
+     * @brief True (and remembered) when the SINR towards gnb_id moved by
+     * at least threshold_db since it was last reported.
+     */
+    bool shouldReport(uint32_t ue_id, uint32_t gnb_id, double sinr_db,
+                      double threshold_db);
+
+    template <typename Visitor>
+    void forEachUe(Visitor&& visit) const
+    {
+        for (const auto& [ue_id, links] : ue_links_) {
+            if (!links.empty()) {
+                visit(ue_id, bestSinrDb(ue_id));
+            }
+        }
+    }
+
+private:
+    struct Link {
+        uint32_t gnb_id;
+        double rx_mw;
+        double reported_sinr_db;
+    };
+
+    void setLink(uint32_t ue_id, uint32_t gnb_id, double rx_mw);
+    void eraseLink(uint32_t ue_id, uint32_t gnb_id);
+    double sinrDb(const std::vector<Link>& links, const Link& link) const;
+
+    const double noise_mw_;
+    std::unordered_map<uint32_t, std::vector<Link>> ue_links_;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> gnb_ues_;
+};
+
+#endif  // INTERFERENCE_TABLE_HPP
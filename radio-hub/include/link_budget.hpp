@@ -0,0 +1,125 @@
+#ifndef LINK_BUDGET_HPP
+#define LINK_BUDGET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "id_slot_map.hpp"
+#include "settings.hpp"
+
+/**
+ * @brief Distance based path loss and RSRP.
+ * Every model is reduced to PL = A + B * log10(d) + C * log10(fc), so the
+ * batch kernel is one branch-free loop over structure-of-arrays columns.
+ * Models follow 3GPP TR 38.901 (UMa/UMi NLOS, h_UT = 1.5 m).
+ */
+class LinkBudget
+{
+public:
+    static constexpr double MIN_DISTANCE_M = 1.0;
+
+    explicit LinkBudget(PathLossModel model = PathLossModel::None,
+                        double carrier_frequency_ghz = 3.5);
+
+    bool isEnabled() const;
+    double pathLossDb(double distance_m) const;
+    bool isAudible(double rsrp_dbm, double min_rx_level_dbm) const;
+
+    /**
+     * @brief Path loss from (x, y) to count points given as SoA columns.
+     * Kept free of branches and aliasing so the compiler vectorizes it.
+     */
+    void pathLossBatch(const double* __restrict xs,
+                       const double* __restrict ys, size_t count, double x,
+                       double y, double* __restrict out_db) const;
+
+private:
+    PathLossModel model_;
+    double intercept_db_;
+    double slope_per_log10_d2_;
+};
+
+/**
+ * @brief gNB radio parameters in dense columns for the batch kernel.
+ * Removal swaps the last row into the freed slot.
+ */
+class GnbRadioTable
+{
+public:
+    void upsert(uint32_t id, double x, double y, double radius,
+                double tx_power_dbm, double min_rx_level_dbm);
+    void move(uint32_t id, double x, double y);
+    bool remove(uint32_t id);
+    size_t size() const;
+
+    /**
+     * @brief Calls visit(gnb_id, rsrp_dbm) for every gNB whose radius
+     * contains (x, y) and whose RSRP there passes its min RX level.
+     */
+    template <typename Visitor>
+    void forEachAudible(double x, double y, const LinkBudget& budget,
+                        Visitor&& visit)
+    {
+        const size_t count = ids_.size();
+        path_loss_.resize(count);
+        budget.pathLossBatch(xs_.data(), ys_.data(), count, x, y,
+                             path_loss_.data());
+
+        for (size_t i = 0; i < count; ++i) {
+            const double dx = xs_[i] - x;
+            const double dy = ys_[i] - y;
+            const double rsrp = tx_power_dbm_[i] - path_loss_[i];
+            if (dx * dx + dy * dy <= radius_[i] * radius_[i] &&
+                budget.isAudible(rsrp, min_rx_level_dbm_[i])) {
+                visit(ids_[i], rsrp);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls visit(gnb_id, rx_dbm) for every gNB within range_m of
+     * (x, y), audible or not: interferers count below the min RX level.
+     */
+    template <typename Visitor>
+    void forEachInRange(double x, double y, double range_m,
+                        const LinkBudget& budget, Visitor&& visit)
+    {
+        const size_t count = ids_.size();
+        path_loss_.resize(count);
+        budget.pathLossBatch(xs_.data(), ys_.data(), count, x, y,
+                             path_loss_.data());
+
+        const double range2 = range_m * range_m;
+        for (size_t i = 0; i < count; ++i) {
+            const double dx = xs_[i] - x;
+            const double dy = ys_[i] - y;
+            if (dx * dx + dy * dy <= range2) {
+                visit(ids_[i], tx_power_dbm_[i] - path_loss_[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief TX power of a gNB, or NaN when it is not in the table.
+     */
+    double txPowerDbm(uint32_t id) const
+    {
+        const uint32_t i = index_.find(id);
+        return i == IdSlotMap::NPOS ? std::numeric_limits<double>::quiet_NaN()
+                                    : tx_power_dbm_[i];
+    }
+
+private:
+    std::vector<uint32_t> ids_;
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<double> radius_;
+    std::vector<double> tx_power_dbm_;
+    std::vector<double> min_rx_level_dbm_;
+    std::vector<double> path_loss_;
+    IdSlotMap index_;
+};
+
+#endif  // LINK_BUDGET_HPP
@@ -0,0 +1,39 @@
+#ifndef LINK_IMPAIRMENT_HPP
+#define LINK_IMPAIRMENT_HPP
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+#include "settings.hpp"
+
+struct LinkDecision {
+    bool is_lost = false;
+    uint32_t delay_ms = 0;
+};
+
+/**
+ * @brief Per-link delay, jitter and loss for routed RadioHub traffic.
+ * A configured src -> dst override wins over the base profile; the base
+ * delay grows with the link distance by delay_per_km_ms.
+ * decide() is const, callers pass their own (per-thread) generator.
+ */
+class LinkImpairment
+{
+public:
+    explicit LinkImpairment(const LinkImpairmentSettings& settings = {});
+
+    bool isEnabled() const;
+    LinkDecision decide(uint32_t src_id, uint32_t dst_id, double distance_m,
+                        std::mt19937& rng) const;
+
+private:
+    static uint64_t linkKey(uint32_t src_id, uint32_t dst_id);
+
+    LinkProfile base_;
+    double delay_per_km_ms_;
+    std::unordered_map<uint64_t, LinkProfile> overrides_;
+    bool is_enabled_;
+};
+
+#endif  // LINK_IMPAIRMENT_HPP
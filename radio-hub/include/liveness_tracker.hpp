@@ -0,0 +1,118 @@
+#ifndef LIVENESS_TRACKER_HPP
+#define LIVENESS_TRACKER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "timing_wheel.hpp"
+
+/**
+ * @brief Last-seen time of every local node and expiry of silent ones.
+ * Every node has one timer in a millisecond timing wheel, due timeout_ms
+ * after it was tracked. touch() only stores the time; a due timer whose
+ * node was seen meanwhile is rescheduled from the last-seen time, so the
+ * wheel sees one operation per node and timeout, not one per datagram.
+ */
+class LivenessTracker
+{
+public:
+    explicit LivenessTracker(uint32_t timeout_ms);
+
+    // Starts or refreshes tracking. Not concurrent with any other call.
+    void track(uint32_t id, uint64_t now_ms);
+    // Not concurrent with any other call.
+    void forget(uint32_t id);
+
+    /**
+     * @brief Marks a node as seen; untracked ids are ignored. Safe to call
+     * from several threads at once, as long as no other method runs.
+     */
+    void touch(uint32_t id, uint64_t now_ms);
+
+    bool isTracked(uint32_t id) const;
+    size_t size() const;
+
+    /**
+     * @brief Stops tracking every node not seen for timeout_ms and calls
+     * on_expired(id) for each of them. Returns the number expired.
+     */
+    template <typename Fn>
+    size_t expire(uint64_t now_ms, Fn&& on_expired)
+    {
+        due_.clear();
+        wheel_.advance(now_ms, [this](uint32_t id) { due_.push_back(id); });
+
+        size_t expired = 0;
+        for (const uint32_t id : due_) {
+            const auto it = entries_.find(id);
+            if (it == entries_.end()) {
+                continue;
+            }
+            const uint64_t deadline =
+                it->second.last_seen_ms.load(std::memory_order_relaxed) +
+                timeout_ms_;
+            if (deadline > now_ms) {
+                it->second.timer = wheel_.schedule(deadline, id);
+                continue;
+            }
+            entries_.erase(it);
+            on_expired(id);
+            ++expired;
+        }
+        return expired;
+    }
+
+private:
+    struct Entry {
+        std::atomic<uint64_t> last_seen_ms{0};
+        TimingWheel<uint32_t>::TimerId timer =
+            TimingWheel<uint32_t>::INVALID_TIMER;
+    };
+
+    const uint64_t timeout_ms_;
+    std::unordered_map<uint32_t, Entry> entries_;
+    TimingWheel<uint32_t> wheel_;
+    std::vector<uint32_t> due_;
+};
+
+/**
+ * @brief Endpoints the hub stopped sending to.
+ * After max_errors consecutive send errors an endpoint is skipped for
+ * quarantine_ms; the first send after that is a probe, and a single
+ * further error quarantines it again. Errors count whether the send call
+ * failed or the kernel reported them later (ICMP); since a queued send
+ * proves nothing, only hearing from the endpoint clears it.
+ * One instance is shared by all routing threads: an endpoint's datagrams
+ * arrive on one of them, its sends may leave from any. Every call is
+ * thread-safe and lock-free while nothing is recorded.
+ */
+class SendQuarantine
+{
+public:
+    SendQuarantine(uint32_t max_errors, uint32_t quarantine_ms);
+
+    bool isBlocked(uint64_t endpoint, uint64_t now_ms);
+    // True when this error put the endpoint into quarantine.
+    bool recordFailure(uint64_t endpoint, uint64_t now_ms);
+    void clear(uint64_t endpoint);
+    size_t size() const;
+
+private:
+    struct Entry {
+        uint32_t errors = 0;
+        uint64_t blocked_until_ms = 0;
+    };
+
+    const uint32_t max_errors_;
+    const uint64_t quarantine_ms_;
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    // entries_.size(), readable without the lock.
+    std::atomic<size_t> size_{0};
+};
+
+#endif  // LIVENESS_TRACKER_HPP
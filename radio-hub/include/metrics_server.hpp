@@ -0,0 +1,37 @@
+#ifndef METRICS_SERVER_HPP
+#define METRICS_SERVER_HPP
+
+#include <QHash>
+#include <QObject>
+
+class HubMetrics;
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @brief Minimal HTTP endpoint serving GET /metrics in Prometheus text
+ * format on the loopback interface. Scrapes only read relaxed counters,
+ * so the routing threads are never stopped.
+ */
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+public:
+    MetricsServer(const HubMetrics& metrics, QObject* parent = nullptr);
+
+    bool listen(quint16 port);
+
+private:
+    void onNewConnection();
+    void onReadyRead(QTcpSocket* socket);
+    void reply(QTcpSocket* socket, const QByteArray& status,
+               const QByteArray& body);
+
+    static constexpr int MAX_REQUEST_SIZE = 8192;
+
+    const HubMetrics& metrics_;
+    QTcpServer* server_;
+    QHash<QTcpSocket*, QByteArray> requests_;
+};
+
+#endif  // METRICS_SERVER_HPP
@@ -0,0 +1,65 @@
+#ifndef NODE_REGISTRY_HPP
+#define NODE_REGISTRY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include <QHostAddress>
+#include <QPointF>
+
+#include "id_slot_map.hpp"
+#include "network_node.hpp"
+
+/**
+ * @brief Registered hub nodes as dense structure-of-arrays columns.
+ * Hot routing data (position, endpoint, coverage radius) lives in its own
+ * contiguous column; the GUI-facing GnbData/UeData is kept apart.
+ * Removal swaps the last slot into the freed one, so the columns stay
+ * compact and slot indices are only stable between modifications.
+ * Remote nodes are mirrors owned by a federated peer hub; their endpoint
+ * is that hub. Nodes with a shared endpoint sit behind one socket of a
+ * host process together with other nodes.
+ */
+class NodeRegistry
+{
+public:
+    static constexpr uint32_t NPOS = IdSlotMap::NPOS;
+
+    uint32_t insert(const NodeInfo& node, bool is_remote = false,
+                    bool shared_endpoint = false);
+    bool remove(uint32_t id);
+
+    uint32_t find(uint32_t id) const;
+    size_t size() const;
+
+    uint32_t id(uint32_t slot) const;
+    EntityType type(uint32_t slot) const;
+    QPointF position(uint32_t slot) const;
+    void setPosition(uint32_t slot, const QPointF& position);
+    const QHostAddress& address(uint32_t slot) const;
+    quint16 port(uint32_t slot) const;
+    // Coverage radius of a gNB, 0 for UEs.
+    double radius(uint32_t slot) const;
+    const GnbData* gnbData(uint32_t slot) const;
+    bool isRemote(uint32_t slot) const;
+    bool hasSharedEndpoint(uint32_t slot) const;
+
+    NodeInfo nodeInfo(uint32_t slot) const;
+
+private:
+    IdSlotMap index_;
+    std::vector<uint32_t> ids_;
+    std::vector<EntityType> types_;
+    std::vector<double> xs_;
+    std::vector<double> ys_;
+    std::vector<double> radii_;
+    std::vector<QHostAddress> addresses_;
+    std::vector<quint16> ports_;
+    std::vector<uint8_t> remote_;
+    std::vector<uint8_t> shared_;
+    std::vector<std::variant<GnbData, UeData>> details_;
+};
+
+#endif  // NODE_REGISTRY_HPP
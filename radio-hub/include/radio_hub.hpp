@@ -1,12 +1,37 @@
 #ifndef RADIOHUB_HPP
 #define RADIOHUB_HPP
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
 #include <QMap>
 #include <QObject>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QThread>
 
+#include "coverage_table.hpp"
+#include "hub_egress.hpp"
+#include "hub_federation.hpp"
+#include "hub_metrics.hpp"
+#include "interference_table.hpp"
+#include "link_budget.hpp"
+#include "link_impairment.hpp"
+#include "liveness_tracker.hpp"
+#include "metrics_server.hpp"
 #include "network_node.hpp"
+#include "node_registry.hpp"
 #include "settings.hpp"
+#include "shm_router.hpp"
+#include "signaling_capture.hpp"
 #include "sim_protocol.hpp"
+#include "spatial_grid.hpp"
+#include "traffic_recording.hpp"
+#include "traffic_replayer.hpp"
 #include "udp_transport.hpp"
 
 /**
@@ -14,6 +39,31 @@
  * for the 5G RAN simulation environment.
  * * It manages network entity registration (UEs and gNBs)
  * and performs packet routing via UDP.
+ * * With hub_settings.worker_threads > 1 every worker thread owns its own
+ * socket bound to the hub port with SO_REUSEPORT. The node registry is
+ * shared between workers and guarded by a read-write lock.
+ * * Routed packets pass through hub_settings.link_impairment: each thread's
+ * HubEgress holds delayed packets in a timing wheel and drops lost ones.
+ * * With hub_settings.capture enabled every routed datagram is traced to a
+ * pcapng file without blocking the routing threads.
+ * * Every routing thread keeps its own counters in HubMetrics; with
+ * hub_settings.metrics enabled they are served in Prometheus format.
+ * * With hub_settings.federation enabled the hub owns one region of the map:
+ * nodes near a border are mirrored to the neighbouring hubs, packets for a
+ * mirror go to its owner as HubForward, and nodes crossing a border are
+ * handed off and redirected to the new owner.
+ * * With hub_settings.shm_transport enabled, nodes on the same host may
+ * attach a shared-memory channel after registering; the hub then talks to
+ * them through its rings instead of loopback UDP.
+ * * With hub_settings.interference enabled the hub keeps the SINR of every
+ * UE towards every gNB in range, updated for the node that moved only, and
+ * reports changes to the serving gNBs as SinrReport.
+ * * With hub_settings.liveness enabled, nodes not heard from for the node
+ * timeout are dropped as if they had deregistered, and endpoints the sends
+ * of any routing thread keep failing to are quarantined for all of them.
+ * * hub_settings.recording either records every inbound datagram to a file
+ * or, instead of listening, replays such a file into the hub with all
+ * outbound sends captured: a repeatable routing benchmark.
  */
 class RadioHub : public QObject
 {
@@ -21,44 +71,162 @@ class RadioHub : public QObject
 
 public:
     explicit RadioHub(const HubSettings set, QObject* parent = nullptr);
+    ~RadioHub();
     bool run();
 
+    void processDatagram(const QByteArray& raw_data,
+                         const QHostAddress& sender_ip, quint16 sender_port,
+                         HubEgress* egress);
+
+    /**
+     * @brief Best SINR of every UE with a gNB in range, in dB. Empty when
+     * the interference engine is disabled.
+     */
+    QHash<uint32_t, double> ueSinrSnapshot() const;
+
+    /**
+     * @brief Applies the per-thread send policies to a routing thread's
+     * egress; called from that thread. Lane 0 also runs the node expiry.
+     */
+    void attachEgress(HubEgress* egress);
+
 private slots:
     void onDataReceived(const QByteArray& data, const QHostAddress& sender_ip,
                         quint16 sender_port);
 signals:
     void nodeRegistered(NodeInfo node_info);
+    void replayFinished();
 
 private:
+    bool startWorkers();
+    void startCapture();
+    void startMetricsServer();
+    void startRecording();
+    bool startReplay();
+    void onReplayFinished();
+    void stopWorkers();
+
+    void routeDatagram(const QByteArray& raw_data,
+                       const SimProtocol::HeaderView& header,
+                       const QHostAddress& sender_ip, quint16 sender_port,
+                       HubEgress* egress);
     void handleHubMessage(const SimProtocol::DecodedPacket& packet,
-                          const QHostAddress& sender_ip, quint16 sender_port);
-    void broadcastFromGbn(const QByteArray& raw_data, uint32_t src_id);
+                          const QHostAddress& sender_ip, quint16 sender_port,
+                          HubEgress* egress);
+    void broadcastFromGbn(const QByteArray& raw_data, uint32_t src_id,
+                          HubEgress* egress);
     void forwardToNode(const QByteArray& raw_data, const uint32_t dst_id,
-                       const uint32_t src_id);
+                       const uint32_t src_id, HubEgress* egress);
+    void handleBundle(const QByteArray& raw_data,
+                      const SimProtocol::HeaderView& header,
+                      HubEgress* egress);
 
     void handleRegistration(const uint32_t node_id,
                             const QHostAddress& sender_ip, quint16 sender_port,
                             const EntityType type, const QPointF& coordinates,
-                            const double& radius);
-    const NodeInfo* findNode(uint32_t id) const;
+                            const GnbRegistrationInfo& gnb_info,
+                            bool shared_endpoint, HubEgress* egress);
     double calculateDistance(const QPointF& position_1,
                              const QPointF& position_2);
-    void handleDeregistration(uint32_t src_id, EntityType type);
+    void handleDeregistration(uint32_t src_id, EntityType type,
+                              HubEgress* egress);
+    void handleShmAttach(uint32_t node_id, const QHostAddress& sender_ip,
+                         quint16 sender_port, HubEgress* egress);
+    void handleHeartbeat(uint32_t node_id, const QHostAddress& sender_ip,
+                         quint16 sender_port, HubEgress* egress);
+    void expireSilentNodes(HubEgress* egress);
+    uint64_t nowMs() const;
+    uint64_t nowUs() const;
     void sendRegistrationResponse(uint32_t node_id, uint8_t status,
-                                  const QHostAddress& ip, quint16 port);
-    bool areWithinCoverageArea(const NodeInfo* first, const NodeInfo* second);
+                                  const QHostAddress& ip, quint16 port,
+                                  HubEgress* egress);
+    bool areWithinCoverageArea(uint32_t source_slot, uint32_t target_slot);
+    void deliver(const QByteArray& raw_data, uint32_t source_slot,
+                 uint32_t target_slot, HubEgress* egress);
     void updatePosition(const uint32_t& id, const EntityType& type,
-                        const QPointF& position);
+                        const QPointF& position, HubEgress* egress);
+    void refreshUeCoverage(uint32_t ue_slot);
+    void refreshGnbCoverage(uint32_t gnb_slot);
+    void refreshUeInterference(uint32_t ue_slot);
+    void refreshGnbInterference(uint32_t gnb_slot);
+    void queueSinrReports(uint32_t ue_id);
+    void flushSinrReports(HubEgress* egress);
+    void queueRsrpReport(uint32_t ue_slot);
+    void flushRsrpReports(HubEgress* egress);
+    void flushLinkReports(HubEgress* egress);
+    uint32_t insertNode(const NodeInfo& node, bool is_remote,
+                        bool shared_endpoint = false);
+    bool removeNode(uint32_t id);
+
+    PeerNodeRecord peerRecord(uint32_t slot, PeerNodeRecord::Op op) const;
+    void sendToPeer(uint32_t region_index, const PeerNodeRecord& record,
+                    HubEgress* egress);
+    void sendRedirect(uint32_t node_id, uint32_t region_index,
+                      bool must_register, const QHostAddress& ip,
+                      quint16 port, HubEgress* egress);
+    void syncMirrors(uint32_t slot, HubEgress* egress);
+    void dropMirrors(uint32_t id, uint32_t except_index, HubEgress* egress);
+    void dropMirrorsIn(uint32_t id, uint64_t peers, HubEgress* egress);
+    void handOff(uint32_t slot, uint32_t region_index, const QPointF& position,
+                 HubEgress* egress);
+    void handlePeerSync(const SimProtocol::DecodedPacket& packet,
+                        const QHostAddress& sender_ip, quint16 sender_port,
+                        HubEgress* egress);
+    void handleHubForward(const QByteArray& raw_data, uint32_t dst_id,
+                          const QHostAddress& sender_ip, quint16 sender_port,
+                          HubEgress* egress);
 
     UdpTransport* transport_ = nullptr;
-    QHash<uint32_t, NodeInfo> gnbs_;
-    QHash<uint32_t, NodeInfo> ues_;
+    HubEgress* egress_ = nullptr;
+    NodeRegistry nodes_;
+    SpatialGrid ue_grid_;
+    CoverageTable coverage_;
+    LinkBudget link_budget_;
+    const LinkImpairment link_impairment_;
+    std::unique_ptr<SignalingCapture> capture_;
+    HubMetrics metrics_;
+    MetricsServer* metrics_server_ = nullptr;
+    const MetricsSettings metrics_settings_;
+    HubFederation federation_;
+    ShmRouter shm_router_;
+    GnbRadioTable gnb_radio_;
+    std::vector<uint32_t> candidate_ids_;
+    std::vector<double> candidate_xs_;
+    std::vector<double> candidate_ys_;
+    std::vector<double> candidate_path_loss_;
+    const InterferenceSettings interference_settings_;
+    bool is_interference_enabled_;
+    InterferenceTable interference_;
+    std::vector<RxSample> rx_samples_;
+    std::vector<uint32_t> affected_ues_;
+    // SINR changes per local gNB, sent once the registry update is done.
+    std::unordered_map<uint32_t, std::vector<SimProtocol::SinrSample>>
+        pending_sinr_;
+    // UEs whose audible gNBs or their RSRP changed; each gets a full
+    // RsrpReport once the registry update is done.
+    QSet<uint32_t> pending_rsrp_;
+    std::vector<SimProtocol::RsrpSample> rsrp_samples_;
+    const LivenessSettings liveness_settings_;
+    LivenessTracker liveness_;
+    // Shared by every routing thread's egress.
+    SendQuarantine send_quarantine_;
+    QElapsedTimer clock_;
+    const TrafficRecordingSettings recording_settings_;
+    std::unique_ptr<TrafficRecorder> recorder_;
+    TrafficReplayer* replayer_ = nullptr;
+    std::unique_ptr<TrafficRecorder> replay_output_;
+    uint64_t replay_sends_ = 0;
+    mutable QReadWriteLock registry_lock_;
 
     uint16_t port_;
     const uint32_t hub_id_;
     const uint32_t broadcast_id_;
     const QPointF position_;
     std::string address_;
+
+    const uint32_t worker_count_;
+    const UdpBackend udp_backend_;
+    QList<QThread*> worker_threads_;
 };
 
 #endif  // RADIOHUB_HPP
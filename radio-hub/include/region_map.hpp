@@ -0,0 +1,40 @@
+#ifndef REGION_MAP_HPP
+#define REGION_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "settings.hpp"
+
+/**
+ * @brief Point -> region lookup for a federated RadioHub deployment.
+ * Regions are few, so plain linear scans over the rectangles are used.
+ */
+class RegionMap
+{
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr size_t MAX_REGIONS = 64;
+
+    explicit RegionMap(std::vector<HubRegion> regions = {});
+
+    size_t size() const;
+    const HubRegion& region(uint32_t index) const;
+    uint32_t indexOf(uint32_t region_id) const;
+
+    // Index of the region containing (x, y), NONE outside all regions.
+    uint32_t indexAt(double x, double y) const;
+
+    /**
+     * @brief Bit i is set when region i is not except_index and lies
+     * within margin of (x, y).
+     */
+    uint64_t regionsNear(double x, double y, double margin,
+                         uint32_t except_index) const;
+
+private:
+    std::vector<HubRegion> regions_;
+};
+
+#endif  // REGION_MAP_HPP
@@ -0,0 +1,49 @@
+#ifndef SHM_ROUTER_HPP
+#define SHM_ROUTER_HPP
+
+#include <cstddef>
+#include <unordered_map>
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QReadWriteLock>
+
+#include "settings.hpp"
+#include "shm_channel.hpp"
+
+/**
+ * @brief Shared-memory channels of the nodes on the RadioHub's host,
+ * keyed by the node's UDP port on the loopback address.
+ * Every routing thread sends through it; a channel is read by the thread
+ * that attached it, which is the thread the node's UDP traffic maps to.
+ */
+class ShmRouter
+{
+public:
+    explicit ShmRouter(const ShmTransportSettings& settings);
+
+    bool isEnabled() const;
+
+    /**
+     * @brief Maps the node's segment. The channel is owned by owner and
+     * must be listened to from owner's thread. Returns nullptr on failure.
+     */
+    ShmChannel* attach(quint16 node_port, const QString& name,
+                       QObject* owner);
+    void detach(quint16 node_port);
+
+    /**
+     * @brief Puts data into the node's ring. False when the node has no
+     * channel or its ring is full, so the caller sends over UDP.
+     */
+    bool send(const QHostAddress& address, quint16 port,
+              const QByteArray& data) const;
+    size_t size() const;
+
+private:
+    const bool is_enabled_;
+    mutable QReadWriteLock lock_;
+    std::unordered_map<quint16, ShmChannel*> channels_;
+};
+
+#endif  // SHM_ROUTER_HPP
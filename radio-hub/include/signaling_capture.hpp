@@ -0,0 +1,91 @@
+#ifndef SIGNALING_CAPTURE_HPP
+#define SIGNALING_CAPTURE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "settings.hpp"
+#include "spsc_ring.hpp"
+
+struct CaptureRecord {
+    static constexpr size_t SNAP_LENGTH = 2048;
+
+    uint64_t timestamp_ns = 0;
+    uint32_t src_id = 0;
+    uint32_t dst_id = 0;
+    uint32_t original_length = 0;
+    uint32_t captured_length = 0;
+    uint8_t msg_type = 0;
+    std::array<char, SNAP_LENGTH> data;
+};
+
+/**
+ * @brief Signaling trace of the RadioHub (ROADMAP 007).
+ * Every routing thread owns one lane: a lock-free SPSC ring it copies
+ * datagrams into. A background writer drains all lanes into a pcapng file
+ * with one interface per lane and LINKTYPE_USER0 frames holding the raw
+ * SimProtocol datagram. A full ring drops the record and counts it, the
+ * drop counts end up in the Interface Statistics Blocks on stop().
+ */
+class SignalingCapture
+{
+public:
+    static constexpr uint16_t LINKTYPE_USER0 = 147;
+
+    SignalingCapture(const CaptureSettings& settings, uint32_t lane_count);
+    ~SignalingCapture();
+
+    SignalingCapture(const SignalingCapture&) = delete;
+    SignalingCapture& operator=(const SignalingCapture&) = delete;
+
+    bool start();
+    void stop();
+
+    /**
+     * @brief Routing thread side, never blocks. Each lane must only be
+     * used by one thread.
+     */
+    void record(uint32_t lane, const char* data, size_t size, uint32_t src_id,
+                uint32_t dst_id, uint8_t msg_type);
+
+    const std::string& path() const;
+    uint64_t written() const;
+    uint64_t dropped() const;
+
+private:
+    struct Lane {
+        explicit Lane(size_t capacity)
+            : ring(capacity)
+        {
+        }
+
+        SpscRing<CaptureRecord> ring;
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    void writerLoop();
+    size_t drainLanes();
+
+    void writeBlock(uint32_t type, const std::vector<char>& body);
+    void writeSectionHeader();
+    void writeInterfaceDescription(uint32_t lane);
+    void writePacket(uint32_t lane, const CaptureRecord& record);
+    void writeInterfaceStatistics(uint32_t lane);
+
+    const std::string path_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::FILE* file_ = nullptr;
+    std::thread writer_;
+    std::atomic<bool> is_running_{false};
+    std::atomic<uint64_t> written_{0};
+    std::vector<char> block_;
+};
+
+#endif  // SIGNALING_CAPTURE_HPP
@@ -0,0 +1,85 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <QPointF>
+
+/**
+ * @brief Uniform grid over node positions.
+ * Radius queries only visit the cells overlapping the query circle, so
+ * the cost depends on the local node density instead of the total count.
+ */
+class SpatialGrid
+{
+public:
+    static constexpr double DEFAULT_CELL_SIZE = 500.0;
+
+    explicit SpatialGrid(double cell_size = DEFAULT_CELL_SIZE);
+
+    void insert(uint32_t id, const QPointF& position);
+    void move(uint32_t id, const QPointF& position);
+    bool remove(uint32_t id);
+    bool contains(uint32_t id) const;
+    size_t size() const;
+    double cellSize() const;
+
+    /**
+     * @brief Calls visit(id, position) for every node whose distance to
+     * center is not greater than radius.
+     */
+    template <typename Visitor>
+    void forEachInRadius(const QPointF& center, double radius,
+                         Visitor&& visit) const
+    {
+        const int32_t min_x = cellCoord(center.x() - radius);
+        const int32_t max_x = cellCoord(center.x() + radius);
+        const int32_t min_y = cellCoord(center.y() - radius);
+        const int32_t max_y = cellCoord(center.y() + radius);
+        const double radius_sq = radius * radius;
+
+        for (int32_t cx = min_x; cx <= max_x; ++cx) {
+            for (int32_t cy = min_y; cy <= max_y; ++cy) {
+                const auto cell = cells_.find(makeKey(cx, cy));
+                if (cell == cells_.end()) {
+                    continue;
+                }
+                for (const Item& item : cell->second) {
+                    const double dx = item.x - center.x();
+                    const double dy = item.y - center.y();
+                    if (dx * dx + dy * dy <= radius_sq) {
+                        visit(item.id, QPointF(item.x, item.y));
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    using CellKey = uint64_t;
+
+    struct Item {
+        uint32_t id;
+        double x;
+        double y;
+    };
+
+    struct Slot {
+        CellKey cell;
+        size_t index;
+    };
+
+    int32_t cellCoord(double value) const;
+    CellKey keyFor(const QPointF& position) const;
+    static CellKey makeKey(int32_t cx, int32_t cy);
+    void detach(const Slot& slot);
+
+    double cell_size_;
+    std::unordered_map<CellKey, std::vector<Item>> cells_;
+    std::unordered_map<uint32_t, Slot> slots_;
+};
+
+#endif  // SPATIAL_GRID_HPP
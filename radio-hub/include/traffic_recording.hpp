@@ -0,0 +1,99 @@
+#ifndef TRAFFIC_RECORDING_HPP
+#define TRAFFIC_RECORDING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One datagram of a traffic recording.
+ * arrival_us counts from the start of the recording.
+ */
+struct TrafficRecord {
+    uint64_t arrival_us = 0;
+    uint32_t ipv4 = 0;
+    uint16_t port = 0;
+    std::vector<char> data;
+};
+
+/**
+ * @brief File format shared by TrafficRecorder and TrafficReader.
+ * A header (u32 MAGIC, u16 VERSION, u16 reserved) is followed by records:
+ * varint arrival delta in microseconds, u32 IPv4 sender, u16 port, varint
+ * length and the datagram bytes. Fixed-width fields are little-endian.
+ */
+namespace TrafficFormat {
+
+constexpr uint32_t MAGIC = 0x52544852;  // "RHTR"
+constexpr uint16_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 8;
+constexpr size_t MAX_DATAGRAM = 65535;
+
+}  // namespace TrafficFormat
+
+/**
+ * @brief Appends datagrams to a recording; record() is thread-safe.
+ * Arrival times that go backwards (threads racing to the lock) are
+ * clamped to the previous record, so deltas never underflow.
+ */
+class TrafficRecorder
+{
+public:
+    explicit TrafficRecorder(std::string path);
+    ~TrafficRecorder();
+
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+    bool open();
+    void close();
+
+    void record(uint64_t arrival_us, uint32_t ipv4, uint16_t port,
+                const char* data, size_t size);
+
+    const std::string& path() const;
+    uint64_t recorded() const;
+
+private:
+    const std::string path_;
+    std::FILE* file_ = nullptr;
+    std::mutex mutex_;
+    uint64_t last_arrival_us_ = 0;
+    std::atomic<uint64_t> recorded_{0};
+    std::vector<char> buffer_;
+};
+
+/**
+ * @brief Sequential reader of a recording.
+ */
+class TrafficReader
+{
+public:
+    explicit TrafficReader(std::string path);
+    ~TrafficReader();
+
+    TrafficReader(const TrafficReader&) = delete;
+    TrafficReader& operator=(const TrafficReader&) = delete;
+
+    // False when the file is missing or not a recording.
+    bool open();
+
+    /**
+     * @brief Reads the next record, reusing record.data. False at the end
+     * of the file or on a truncated last record.
+     */
+    bool next(TrafficRecord& record);
+
+private:
+    bool readVarint(uint64_t& value);
+
+    const std::string path_;
+    std::FILE* file_ = nullptr;
+    uint64_t arrival_us_ = 0;
+};
+
+#endif  // TRAFFIC_RECORDING_HPP
@@ -0,0 +1,62 @@
+#ifndef TRAFFIC_REPLAYER_HPP
+#define TRAFFIC_REPLAYER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QObject>
+
+#include "traffic_recording.hpp"
+
+class QTimer;
+
+/**
+ * @brief Feeds a traffic recording back in, paced by its arrival times.
+ * speed scales the recorded time (2 replays twice as fast); speed 0
+ * replays as fast as possible, yielding to the event loop between batches
+ * so delayed sends and timers keep running.
+ */
+class TrafficReplayer : public QObject
+{
+    Q_OBJECT
+public:
+    using Deliver = std::function<void(
+        const QByteArray& data, const QHostAddress& sender_ip,
+        quint16 sender_port)>;
+
+    TrafficReplayer(std::string path, double speed, Deliver deliver,
+                    QObject* parent = nullptr);
+
+    // False when the recording cannot be opened.
+    bool start();
+
+    uint64_t replayed() const;
+    // Wall time since start() in milliseconds.
+    qint64 elapsedMs() const;
+
+signals:
+    void finished();
+
+private:
+    static constexpr uint32_t MAX_BATCH = 1024;
+
+    void onTimer();
+    void scheduleNext();
+
+    TrafficReader reader_;
+    const double speed_;
+    Deliver deliver_;
+    QTimer* timer_;
+    QElapsedTimer clock_;
+    TrafficRecord next_;
+    bool has_next_ = false;
+    // Replay starts with the first record, not with the recording.
+    uint64_t first_arrival_us_ = 0;
+    uint64_t replayed_ = 0;
+};
+
+#endif  // TRAFFIC_REPLAYER_HPP
@@ -0,0 +1,113 @@
+#include "coverage_table.hpp"
+
+namespace {
+const QSet<uint32_t> EMPTY_SET;
+const CoveredUes EMPTY_UES;
+
+void addUe(CoveredUes& ues, uint32_t ue_id, uint32_t ue_slot)
+{
+    const auto it = ues.positions.constFind(ue_id);
+    if (it != ues.positions.constEnd()) {
+        ues.slots[it.value()] = ue_slot;
+        return;
+    }
+    ues.positions.insert(ue_id, static_cast<uint32_t>(ues.ids.size()));
+    ues.ids.push_back(ue_id);
+    ues.slots.push_back(ue_slot);
+}
+
+void dropUe(CoveredUes& ues, uint32_t ue_id)
+{
+    const auto it = ues.positions.constFind(ue_id);
+    if (it == ues.positions.constEnd()) {
+        return;
+    }
+    const uint32_t position = it.value();
+    const uint32_t last = static_cast<uint32_t>(ues.ids.size() - 1);
+    if (position != last) {
+        ues.ids[position] = ues.ids[last];
+        ues.slots[position] = ues.slots[last];
+        ues.positions[ues.ids[position]] = position;
+    }
+    ues.ids.pop_back();
+    ues.slots.pop_back();
+    ues.positions.remove(ue_id);
+}
+}  // namespace
+
+void CoverageTable::assignUe(uint32_t ue_id, uint32_t ue_slot,
+                             const QSet<uint32_t>& gnb_ids)
+{
+    QSet<uint32_t>& current = ue_to_gnbs_[ue_id];
+
+    for (const uint32_t gnb_id : current) {
+        if (!gnb_ids.contains(gnb_id)) {
+            dropUe(gnb_to_ues_[gnb_id], ue_id);
+        }
+    }
+    for (const uint32_t gnb_id : gnb_ids) {
+        addUe(gnb_to_ues_[gnb_id], ue_id, ue_slot);
+    }
+
+    current = gnb_ids;
+}
+
+void CoverageTable::assignGnb(uint32_t gnb_id,
+                              const QHash<uint32_t, uint32_t>& ue_slots)
+{
+    CoveredUes& current = gnb_to_ues_[gnb_id];
+
+    for (const uint32_t ue_id : current.ids) {
+        if (!ue_slots.contains(ue_id)) {
+            ue_to_gnbs_[ue_id].remove(gnb_id);
+        }
+    }
+
+    current.ids.clear();
+    current.slots.clear();
+    current.positions.clear();
+    for (auto it = ue_slots.constBegin(); it != ue_slots.constEnd(); ++it) {
+        ue_to_gnbs_[it.key()].insert(gnb_id);
+        addUe(current, it.key(), it.value());
+    }
+}
+
+void CoverageTable::renumberUe(uint32_t ue_id, uint32_t ue_slot)
+{
+    for (const uint32_t gnb_id : gnbsOf(ue_id)) {
+        addUe(gnb_to_ues_[gnb_id], ue_id, ue_slot);
+    }
+}
+
+void CoverageTable::removeUe(uint32_t ue_id)
+{
+    const QSet<uint32_t> gnb_ids = ue_to_gnbs_.take(ue_id);
+    for (const uint32_t gnb_id : gnb_ids) {
+        dropUe(gnb_to_ues_[gnb_id], ue_id);
+    }
+}
+
+void CoverageTable::removeGnb(uint32_t gnb_id)
+{
+    const CoveredUes ues = gnb_to_ues_.take(gnb_id);
+    for (const uint32_t ue_id : ues.ids) {
+        ue_to_gnbs_[ue_id].remove(gnb_id);
+    }
+}
+
+bool CoverageTable::covers(uint32_t gnb_id, uint32_t ue_id) const
+{
+    return gnbsOf(ue_id).contains(gnb_id);
+}
+
+const CoveredUes& CoverageTable::uesOf(uint32_t gnb_id) const
+{
+    auto it = gnb_to_ues_.constFind(gnb_id);
+    return it != gnb_to_ues_.constEnd() ? it.value() : EMPTY_UES;
+}
+
+const QSet<uint32_t>& CoverageTable::gnbsOf(uint32_t ue_id) const
+{
+    auto it = ue_to_gnbs_.constFind(ue_id);
+    return it != ue_to_gnbs_.constEnd() ? it.value() : EMPTY_SET;
+}
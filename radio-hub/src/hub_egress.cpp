@@ -0,0 +1,174 @@
+#include "hub_egress.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include <QDebug>
+#include <QTimer>
+
+#include "hub_metrics.hpp"
+#include "shm_router.hpp"
+#include "udp_transport.hpp"
+
+namespace {
+
+uint64_t endpointKey(const QHostAddress& address, quint16 port)
+{
+    bool is_ipv4 = false;
+    const uint64_t host = address.toIPv4Address(&is_ipv4);
+    return ((is_ipv4 ? host : uint64_t{qHash(address)}) << 16) | port;
+}
+
+// Time scale of the quarantine, which all routing threads share.
+uint64_t quarantineNowMs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+}  // namespace
+
+HubEgress::HubEgress(UdpTransport* transport, uint32_t lane,
+                     const ShmRouter* shm, QObject* parent)
+    : QObject(parent)
+    , transport_(transport)
+    , shm_(shm)
+    , lane_(lane)
+    , timer_(new QTimer(this))
+    , rng_(std::random_device{}())
+{
+    clock_.start();
+    timer_->setSingleShot(true);
+    timer_->setTimerType(Qt::PreciseTimer);
+    connect(timer_, &QTimer::timeout, this, &HubEgress::onTimer);
+}
+
+void HubEgress::send(const QByteArray& data, const QHostAddress& address,
+                     quint16 port, uint32_t delay_ms)
+{
+    if (delay_ms == 0) {
+        transmit(data, address, port);
+        return;
+    }
+
+    releaseDue();
+    const uint64_t now = nowMs();
+    delayed_.schedule(now + delay_ms, DelayedPacket{data, address, port});
+    // Only an earlier deadline re-arms, so no send scans the wheel.
+    const uint64_t deadline = std::max(now + delay_ms, delayed_.now() + 1);
+    if (deadline < next_due_ms_) {
+        next_due_ms_ = deadline;
+        armTimer();
+    }
+}
+
+UdpTransport* HubEgress::transport() const
+{
+    return transport_;
+}
+
+uint32_t HubEgress::lane() const
+{
+    return lane_;
+}
+
+std::mt19937& HubEgress::rng()
+{
+    return rng_;
+}
+
+size_t HubEgress::inFlight() const
+{
+    return delayed_.size();
+}
+
+void HubEgress::enableQuarantine(SendQuarantine* quarantine,
+                                 HubThreadMetrics* stats)
+{
+    quarantine_ = quarantine;
+    stats_ = stats;
+    if (transport_) {
+        connect(transport_, &UdpTransport::sendFailed, this,
+                &HubEgress::recordSendError);
+    }
+}
+
+void HubEgress::noteHeardFrom(const QHostAddress& address, quint16 port)
+{
+    if (quarantine_ && quarantine_->size() > 0) {
+        quarantine_->clear(endpointKey(address, port));
+    }
+}
+
+void HubEgress::setSendSink(SendSink sink)
+{
+    sink_ = std::move(sink);
+}
+
+uint64_t HubEgress::nowMs() const
+{
+    return static_cast<uint64_t>(clock_.elapsed());
+}
+
+void HubEgress::onTimer()
+{
+    releaseDue();
+    next_due_ms_ = delayed_.nextWakeup();
+    armTimer();
+}
+
+void HubEgress::releaseDue()
+{
+    delayed_.advance(nowMs(), [this](DelayedPacket&& packet) {
+        transmit(packet.data, packet.address, packet.port);
+    });
+}
+
+void HubEgress::transmit(const QByteArray& data, const QHostAddress& address,
+                         quint16 port)
+{
+    if (sink_) {
+        sink_(data, address, port);
+        return;
+    }
+    if (shm_ && shm_->send(address, port, data)) {
+        return;
+    }
+    if (!quarantine_) {
+        transport_->sendData(data, address, port);
+        return;
+    }
+
+    if (quarantine_->isBlocked(endpointKey(address, port), quarantineNowMs())) {
+        bump(stats_->dropped_quarantined);
+        return;
+    }
+    if (transport_->sendData(data, address, port).is_socket_error_) {
+        recordSendError(address, port);
+    }
+}
+
+void HubEgress::recordSendError(const QHostAddress& address, quint16 port)
+{
+    bump(stats_->send_errors);
+    if (quarantine_->recordFailure(endpointKey(address, port),
+                                   quarantineNowMs())) {
+        qWarning() << "[RadioHub] Sends to" << address << port
+                   << "keep failing, endpoint quarantined";
+    }
+}
+
+void HubEgress::armTimer()
+{
+    if (next_due_ms_ == TimingWheel<DelayedPacket>::NEVER) {
+        timer_->stop();
+        return;
+    }
+
+    const uint64_t now = nowMs();
+    timer_->start(next_due_ms_ > now ? static_cast<int>(next_due_ms_ - now)
+                                     : 0);
+}
@@ -0,0 +1,131 @@
+#include "hub_federation.hpp"
+
+#include <QDataStream>
+#include <QDebug>
+
+HubFederation::HubFederation(const FederationSettings& settings)
+    : regions_(settings.regions)
+    , own_index_(RegionMap::NONE)
+    , border_margin_m_(settings.border_margin_m)
+{
+    if (!settings.enabled) {
+        return;
+    }
+
+    own_index_ = regions_.indexOf(settings.region_id);
+    if (own_index_ == RegionMap::NONE) {
+        qWarning() << "[RadioHub] Federation disabled: region"
+                   << settings.region_id << "is not configured";
+        return;
+    }
+
+    for (uint32_t i = 0; i < regions_.size(); ++i) {
+        peer_addresses_.emplace_back(
+            QString::fromStdString(regions_.region(i).address));
+    }
+}
+
+bool HubFederation::isEnabled() const
+{
+    return own_index_ != RegionMap::NONE;
+}
+
+quint16 HubFederation::ownPort() const
+{
+    return regions_.region(own_index_).port;
+}
+
+uint32_t HubFederation::ownerIndex(const QPointF& position) const
+{
+    const uint32_t index = regions_.indexAt(position.x(), position.y());
+    return index == own_index_ ? RegionMap::NONE : index;
+}
+
+uint32_t HubFederation::peerIndex(const QHostAddress& address,
+                                  quint16 port) const
+{
+    for (uint32_t i = 0; i < peer_addresses_.size(); ++i) {
+        if (i != own_index_ && regions_.region(i).port == port &&
+            peer_addresses_[i].isEqual(address,
+                                       QHostAddress::TolerantConversion)) {
+            return i;
+        }
+    }
+    return RegionMap::NONE;
+}
+
+const QHostAddress& HubFederation::peerAddress(uint32_t index) const
+{
+    return peer_addresses_[index];
+}
+
+quint16 HubFederation::peerPort(uint32_t index) const
+{
+    return regions_.region(index).port;
+}
+
+uint64_t HubFederation::mirrorTargets(const QPointF& position) const
+{
+    return regions_.regionsNear(position.x(), position.y(), border_margin_m_,
+                                own_index_);
+}
+
+uint64_t HubFederation::exchangeMirrors(uint32_t node_id, uint64_t peers)
+{
+    if (peers == 0) {
+        auto it = mirrors_.find(node_id);
+        if (it == mirrors_.end()) {
+            return 0;
+        }
+        const uint64_t previous = it->second;
+        mirrors_.erase(it);
+        return previous;
+    }
+
+    uint64_t& current = mirrors_[node_id];
+    const uint64_t previous = current;
+    current = peers;
+    return previous;
+}
+
+QByteArray HubFederation::encode(const PeerNodeRecord& record)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    stream << static_cast<quint8>(record.op) << record.id
+           << static_cast<quint8>(record.type) << record.position.x()
+           << record.position.y() << record.radio.radius
+           << record.radio.tx_power_dbm << record.radio.min_rx_level
+           << record.address.toIPv4Address() << record.port;
+    return payload;
+}
+
+PeerNodeRecord HubFederation::decode(const QByteArray& data)
+{
+    PeerNodeRecord record;
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    quint8 op = 0;
+    quint8 type = 0;
+    double x = 0.0;
+    double y = 0.0;
+    quint32 ipv4 = 0;
+    stream >> op >> record.id >> type >> x >> y >> record.radio.radius >>
+        record.radio.tx_power_dbm >> record.radio.min_rx_level >> ipv4 >>
+        record.port;
+
+    if (stream.status() != QDataStream::Ok ||
+        op > static_cast<quint8>(PeerNodeRecord::Op::Handoff)) {
+        return record;
+    }
+
+    record.op = static_cast<PeerNodeRecord::Op>(op);
+    record.type = static_cast<EntityType>(type);
+    record.position = QPointF(x, y);
+    record.address = QHostAddress(ipv4);
+    record.isValid = true;
+    return record;
+}
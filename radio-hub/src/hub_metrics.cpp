@@ -0,0 +1,285 @@
+#include "hub_metrics.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#include "batched_udp_socket.hpp"
+#include "packet_pool.hpp"
+#include "types.hpp"
+
+namespace {
+
+const char* simTypeName(uint8_t type)
+{
+    switch (static_cast<SimMessageType>(type)) {
+        case SimMessageType::Registration:
+            return "registration";
+        case SimMessageType::RegistrationResponse:
+            return "registration_response";
+        case SimMessageType::Deregistration:
+            return "deregistration";
+        case SimMessageType::Data:
+            return "data";
+        case SimMessageType::HubRedirect:
+            return "hub_redirect";
+        case SimMessageType::HubSync:
+            return "hub_sync";
+        case SimMessageType::HubForward:
+            return "hub_forward";
+        case SimMessageType::ShmAttach:
+            return "shm_attach";
+        case SimMessageType::SinrReport:
+            return "sinr_report";
+        case SimMessageType::Heartbeat:
+            return "heartbeat";
+        case SimMessageType::Bundle:
+            return "bundle";
+        case SimMessageType::RegistrationBatch:
+            return "registration_batch";
+        case SimMessageType::RsrpReport:
+            return "rsrp_report";
+        default:
+            return nullptr;
+    }
+}
+
+const char* protocolTypeName(uint8_t type)
+{
+    switch (static_cast<ProtocolMsgType>(type)) {
+        case ProtocolMsgType::Sib1:
+            return "sib1";
+        case ProtocolMsgType::RachPreamble:
+            return "rach_preamble";
+        case ProtocolMsgType::Rar:
+            return "rar";
+        case ProtocolMsgType::RrcSetup:
+            return "rrc_setup";
+        case ProtocolMsgType::RrcSetupRequest:
+            return "rrc_setup_request";
+        case ProtocolMsgType::RrcSetupComplete:
+            return "rrc_setup_complete";
+        case ProtocolMsgType::RrcRelease:
+            return "rrc_release";
+        case ProtocolMsgType::RegistrationRequest:
+            return "registration_request";
+        case ProtocolMsgType::RegistrationAccept:
+            return "registration_accept";
+        case ProtocolMsgType::DeregistrationRequest:
+            return "deregistration_request";
+        case ProtocolMsgType::ServiceRequest:
+            return "service_request";
+        case ProtocolMsgType::Paging:
+            return "paging";
+        case ProtocolMsgType::MeasurementReport:
+            return "measurement_report";
+        case ProtocolMsgType::RrcReconfiguration:
+            return "rrc_reconfiguration";
+        case ProtocolMsgType::RrcReconfigurationComplete:
+            return "rrc_reconfiguration_complete";
+        case ProtocolMsgType::UserPlaneData:
+            return "user_plane_data";
+        default:
+            return nullptr;
+    }
+}
+
+uint64_t load(const std::atomic<uint64_t>& counter)
+{
+    return counter.load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+void LogHistogram::record(uint64_t value)
+{
+    bump(buckets_[bucketOf(value)]);
+    bump(count_);
+    bump(sum_, value);
+}
+
+size_t LogHistogram::bucketOf(uint64_t value)
+{
+    value = std::min(value, (uint64_t{1} << MAX_VALUE_BITS) - 1);
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+
+    const uint32_t msb = 63 - static_cast<uint32_t>(__builtin_clzll(value));
+    const uint32_t shift = msb - SUB_BUCKET_BITS;
+    const uint64_t mantissa = (value >> shift) & (SUB_BUCKETS - 1);
+    return (shift + 1) * SUB_BUCKETS + static_cast<size_t>(mantissa);
+}
+
+uint64_t LogHistogram::bucketUpperBound(size_t bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+
+    const uint32_t shift = static_cast<uint32_t>(bucket / SUB_BUCKETS) - 1;
+    const uint64_t mantissa = bucket % SUB_BUCKETS;
+    const uint64_t lower = (SUB_BUCKETS + mantissa) << shift;
+    return lower + (uint64_t{1} << shift) - 1;
+}
+
+uint64_t LogHistogram::bucketCount(size_t bucket) const
+{
+    return load(buckets_[bucket]);
+}
+
+uint64_t LogHistogram::count() const
+{
+    return load(count_);
+}
+
+uint64_t LogHistogram::sum() const
+{
+    return load(sum_);
+}
+
+HubMetrics::HubMetrics(uint32_t lane_count)
+{
+    for (uint32_t i = 0; i < std::max(lane_count, 1u); ++i) {
+        lanes_.push_back(std::make_unique<HubThreadMetrics>());
+    }
+}
+
+HubThreadMetrics& HubMetrics::lane(uint32_t index)
+{
+    return *lanes_[index % lanes_.size()];
+}
+
+std::string HubMetrics::renderPrometheus() const
+{
+    std::ostringstream out;
+
+    auto counter = [&](const char* name, const char* help,
+                       std::atomic<uint64_t> HubThreadMetrics::*field) {
+        uint64_t total = 0;
+        for (const auto& lane : lanes_) {
+            total += load((*lane).*field);
+        }
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << " counter\n"
+            << name << ' ' << total << '\n';
+    };
+
+    counter("radiohub_packets_in_total", "Datagrams received by the hub.",
+            &HubThreadMetrics::packets_in);
+    counter("radiohub_packets_out_total", "Datagrams sent by the hub.",
+            &HubThreadMetrics::packets_out);
+    counter("radiohub_send_errors_total", "Datagrams the hub failed to send.",
+            &HubThreadMetrics::send_errors);
+    counter("radiohub_nodes_expired_total",
+            "Nodes dropped after going silent.",
+            &HubThreadMetrics::nodes_expired);
+    counter("radiohub_bundled_pdus_total",
+            "Protocol messages received inside Bundle datagrams.",
+            &HubThreadMetrics::bundled_pdus);
+
+    out << "# HELP radiohub_packet_pool_misses_total Packet buffers allocated"
+           " because the thread's pool had none free.\n"
+        << "# TYPE radiohub_packet_pool_misses_total counter\n"
+        << "radiohub_packet_pool_misses_total " << PacketPool::totalMisses()
+        << '\n';
+
+    out << "# HELP radiohub_udp_send_errors_total Batched sends that failed"
+           " when the send queue was flushed.\n"
+        << "# TYPE radiohub_udp_send_errors_total counter\n"
+        << "radiohub_udp_send_errors_total "
+        << BatchedUdpSocket::totalSendErrors() << '\n';
+
+    out << "# HELP radiohub_udp_truncated_datagrams_total Received datagrams"
+           " dropped because they did not fit a receive slot.\n"
+        << "# TYPE radiohub_udp_truncated_datagrams_total counter\n"
+        << "radiohub_udp_truncated_datagrams_total "
+        << BatchedUdpSocket::totalTruncatedDatagrams() << '\n';
+
+    out << "# HELP radiohub_dropped_total Datagrams dropped by the hub.\n"
+        << "# TYPE radiohub_dropped_total counter\n";
+    const std::pair<const char*, std::atomic<uint64_t> HubThreadMetrics::*>
+        drops[] = {
+            {"invalid", &HubThreadMetrics::dropped_invalid},
+            {"not_registered", &HubThreadMetrics::dropped_not_registered},
+            {"out_of_coverage", &HubThreadMetrics::dropped_out_of_coverage},
+            {"link_loss", &HubThreadMetrics::dropped_link_loss},
+            {"quarantined", &HubThreadMetrics::dropped_quarantined},
+        };
+    for (const auto& [reason, field] : drops) {
+        uint64_t total = 0;
+        for (const auto& lane : lanes_) {
+            total += load((*lane).*field);
+        }
+        out << "radiohub_dropped_total{reason=\"" << reason << "\"} "
+            << total << '\n';
+    }
+
+    auto per_type = [&](const char* name, const char* help,
+                        std::array<std::atomic<uint64_t>, 256>
+                            HubThreadMetrics::*field,
+                        const char* (*type_name)(uint8_t)) {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << " counter\n";
+        for (uint32_t type = 0; type < 256; ++type) {
+            uint64_t total = 0;
+            for (const auto& lane : lanes_) {
+                total += load(((*lane).*field)[type]);
+            }
+            if (total == 0) {
+                continue;
+            }
+            const char* type_label = type_name(static_cast<uint8_t>(type));
+            out << name << "{type=\"";
+            if (type_label) {
+                out << type_label;
+            } else {
+                out << type;
+            }
+            out << "\"} " << total << '\n';
+        }
+    };
+
+    per_type("radiohub_sim_messages_total",
+             "Received datagrams by SimMessageType.",
+             &HubThreadMetrics::sim_msg_types, &simTypeName);
+    per_type("radiohub_protocol_messages_total",
+             "Received data datagrams by ProtocolMsgType.",
+             &HubThreadMetrics::protocol_msg_types, &protocolTypeName);
+
+    // Cumulative buckets are emitted at power-of-two boundaries only.
+    auto histogram = [&](const char* name, const char* help,
+                         LogHistogram HubThreadMetrics::*field,
+                         double scale) {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << " histogram\n";
+        uint64_t cumulative = 0;
+        uint64_t sum = 0;
+        for (size_t bucket = 0; bucket < LogHistogram::BUCKET_COUNT;
+             ++bucket) {
+            for (const auto& lane : lanes_) {
+                cumulative += ((*lane).*field).bucketCount(bucket);
+            }
+            if ((bucket + 1) % LogHistogram::SUB_BUCKETS == 0) {
+                out << name << "_bucket{le=\""
+                    << LogHistogram::bucketUpperBound(bucket) * scale
+                    << "\"} " << cumulative << '\n';
+            }
+        }
+        for (const auto& lane : lanes_) {
+            sum += ((*lane).*field).sum();
+        }
+        // Values past the range are clamped into the last bucket.
+        out << name << "_bucket{le=\"+Inf\"} " << cumulative << '\n'
+            << name << "_sum " << sum * scale << '\n'
+            << name << "_count " << cumulative << '\n';
+    };
+
+    histogram("radiohub_processing_seconds",
+              "Time spent routing one received datagram.",
+              &HubThreadMetrics::processing_ns, 1e-9);
+    histogram("radiohub_broadcast_fanout",
+              "UEs reached by one gNB broadcast.",
+              &HubThreadMetrics::broadcast_fanout, 1.0);
+
+    return out.str();
+}
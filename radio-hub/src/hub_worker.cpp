@@ -0,0 +1,43 @@
+#include "hub_worker.hpp"
+
+#include <QDebug>
+
+#include "radio_hub.hpp"
+
+HubWorker::HubWorker(uint32_t index, quint16 port, UdpBackend backend,
+                     const ShmRouter* shm, RadioHub* hub)
+    : index_(index)
+    , port_(port)
+    , backend_(backend)
+    , shm_(shm)
+    , hub_(hub)
+{
+}
+
+bool HubWorker::init()
+{
+    if (!transport_) {
+        transport_ = new UdpTransport(this, backend_);
+        transport_->setObjectName(QString("hub-transport-%1").arg(index_));
+        egress_ = new HubEgress(transport_, index_, shm_, this);
+        hub_->attachEgress(egress_);
+    }
+
+    if (!transport_->init(port_, true)) {
+        return false;
+    }
+
+    connect(transport_, &UdpTransport::dataReceived, this,
+            &HubWorker::onDataReceived, Qt::DirectConnection);
+
+    qDebug() << "[RadioHub] Worker" << index_ << "is listening on port"
+             << port_;
+    return true;
+}
+
+void HubWorker::onDataReceived(const QByteArray& data,
+                               const QHostAddress& sender_ip,
+                               quint16 sender_port)
+{
+    hub_->processDatagram(data, sender_ip, sender_port, egress_);
+}
@@ -0,0 +1,92 @@
+#include "id_slot_map.hpp"
+
+IdSlotMap::IdSlotMap(size_t initial_capacity)
+{
+    size_t capacity = 16;
+    while (capacity < initial_capacity) {
+        capacity <<= 1;
+    }
+    entries_.resize(capacity);
+    mask_ = capacity - 1;
+}
+
+uint32_t IdSlotMap::find(uint32_t id) const
+{
+    return entries_[probe(id)].slot;
+}
+
+void IdSlotMap::assign(uint32_t id, uint32_t slot)
+{
+    if ((size_ + 1) * 2 > entries_.size()) {
+        grow();
+    }
+
+    Entry& entry = entries_[probe(id)];
+    if (entry.slot == NPOS) {
+        entry.id = id;
+        ++size_;
+    }
+    entry.slot = slot;
+}
+
+bool IdSlotMap::erase(uint32_t id)
+{
+    size_t hole = probe(id);
+    if (entries_[hole].slot == NPOS) {
+        return false;
+    }
+    entries_[hole].slot = NPOS;
+    --size_;
+
+    // Pull back every following entry whose home is not in (hole, next].
+    for (size_t next = (hole + 1) & mask_; entries_[next].slot != NPOS;
+         next = (next + 1) & mask_) {
+        const size_t home = hash(entries_[next].id) & mask_;
+        const bool stays = hole < next ? (home > hole && home <= next)
+                                       : (home > hole || home <= next);
+        if (!stays) {
+            entries_[hole] = entries_[next];
+            entries_[next].slot = NPOS;
+            hole = next;
+        }
+    }
+    return true;
+}
+
+size_t IdSlotMap::size() const
+{
+    return size_;
+}
+
+uint32_t IdSlotMap::hash(uint32_t id)
+{
+    // MurmurHash3 finalizer: sequential ids spread over the whole table.
+    id ^= id >> 16;
+    id *= 0x85EBCA6Bu;
+    id ^= id >> 13;
+    id *= 0xC2B2AE35u;
+    id ^= id >> 16;
+    return id;
+}
+
+size_t IdSlotMap::probe(uint32_t id) const
+{
+    size_t index = hash(id) & mask_;
+    while (entries_[index].slot != NPOS && entries_[index].id != id) {
+        index = (index + 1) & mask_;
+    }
+    return index;
+}
+
+void IdSlotMap::grow()
+{
+    std::vector<Entry> old = std::move(entries_);
+    entries_.assign(old.size() * 2, Entry{});
+    mask_ = entries_.size() - 1;
+
+    for (const Entry& entry : old) {
+        if (entry.slot != NPOS) {
+            entries_[probe(entry.id)] = entry;
+        }
+    }
+}
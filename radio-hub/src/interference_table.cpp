@@ -0,0 +1,201 @@
+#include "interference_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double NOT_HEARD = std::numeric_limits<double>::quiet_NaN();
+
+double dbmToMw(double dbm)
+{
+    return std::pow(10.0, dbm / 10.0);
+}
+
+void eraseId(std::vector<uint32_t>& ids, uint32_t id)
+{
+    const auto it = std::find(ids.begin(), ids.end(), id);
+    if (it != ids.end()) {
+        *it = ids.back();
+        ids.pop_back();
+    }
+}
+
+}  // namespace
+
+InterferenceTable::InterferenceTable(double noise_floor_dbm)
+    : noise_mw_(dbmToMw(noise_floor_dbm))
+{
+}
+
+void InterferenceTable::assignUe(uint32_t ue_id,
+                                 const std::vector<RxSample>& gnbs)
+{
+    std::vector<Link>& links = ue_links_[ue_id];
+
+    for (size_t i = 0; i < links.size();) {
+        const uint32_t gnb_id = links[i].gnb_id;
+        const bool is_kept =
+            std::any_of(gnbs.begin(), gnbs.end(), [gnb_id](const RxSample& s) {
+                return s.id == gnb_id;
+            });
+        if (is_kept) {
+            ++i;
+            continue;
+        }
+        eraseId(gnb_ues_[gnb_id], ue_id);
+        links[i] = links.back();
+        links.pop_back();
+    }
+
+    for (const RxSample& sample : gnbs) {
+        setLink(ue_id, sample.id, dbmToMw(sample.rx_dbm));
+    }
+}
+
+void InterferenceTable::assignGnb(uint32_t gnb_id,
+                                  const std::vector<RxSample>& ues,
+                                  std::vector<uint32_t>& affected_ues)
+{
+    std::vector<uint32_t>& previous = gnb_ues_[gnb_id];
+    for (const uint32_t ue_id : previous) {
+        affected_ues.push_back(ue_id);
+    }
+
+    for (const uint32_t ue_id : std::vector<uint32_t>(previous)) {
+        const bool is_kept =
+            std::any_of(ues.begin(), ues.end(), [ue_id](const RxSample& s) {
+                return s.id == ue_id;
+            });
+        if (!is_kept) {
+            eraseLink(ue_id, gnb_id);
+        }
+    }
+
+    for (const RxSample& sample : ues) {
+        setLink(sample.id, gnb_id, dbmToMw(sample.rx_dbm));
+        affected_ues.push_back(sample.id);
+    }
+
+    std::sort(affected_ues.begin(), affected_ues.end());
+    affected_ues.erase(std::unique(affected_ues.begin(), affected_ues.end()),
+                       affected_ues.end());
+}
+
+void InterferenceTable::removeUe(uint32_t ue_id)
+{
+    const auto it = ue_links_.find(ue_id);
+    if (it == ue_links_.end()) {
+        return;
+    }
+    for (const Link& link : it->second) {
+        eraseId(gnb_ues_[link.gnb_id], ue_id);
+    }
+    ue_links_.erase(it);
+}
+
+void InterferenceTable::removeGnb(uint32_t gnb_id,
+                                  std::vector<uint32_t>& affected_ues)
+{
+    const auto it = gnb_ues_.find(gnb_id);
+    if (it == gnb_ues_.end()) {
+        return;
+    }
+    const std::vector<uint32_t> ues = std::move(it->second);
+    gnb_ues_.erase(it);
+
+    for (const uint32_t ue_id : ues) {
+        std::vector<Link>& links = ue_links_[ue_id];
+        links.erase(std::remove_if(links.begin(), links.end(),
+                                   [gnb_id](const Link& link) {
+                                       return link.gnb_id == gnb_id;
+                                   }),
+                    links.end());
+        affected_ues.push_back(ue_id);
+    }
+}
+
+double InterferenceTable::sinrDb(uint32_t ue_id, uint32_t gnb_id) const
+{
+    const auto it = ue_links_.find(ue_id);
+    if (it == ue_links_.end()) {
+        return NOT_HEARD;
+    }
+    for (const Link& link : it->second) {
+        if (link.gnb_id == gnb_id) {
+            return sinrDb(it->second, link);
+        }
+    }
+    return NOT_HEARD;
+}
+
+double InterferenceTable::bestSinrDb(uint32_t ue_id) const
+{
+    const auto it = ue_links_.find(ue_id);
+    if (it == ue_links_.end() || it->second.empty()) {
+        return NOT_HEARD;
+    }
+    const auto strongest = std::max_element(
+        it->second.begin(), it->second.end(),
+        [](const Link& a, const Link& b) { return a.rx_mw < b.rx_mw; });
+    return sinrDb(it->second, *strongest);
+}
+
+bool InterferenceTable::shouldReport(uint32_t ue_id, uint32_t gnb_id,
+                                     double sinr_db, double threshold_db)
+{
+    const auto it = ue_links_.find(ue_id);
+    if (it == ue_links_.end()) {
+        return false;
+    }
+    for (Link& link : it->second) {
+        if (link.gnb_id != gnb_id) {
+            continue;
+        }
+        // NaN (never reported) compares false, so it always reports.
+        if (std::abs(sinr_db - link.reported_sinr_db) < threshold_db) {
+            return false;
+        }
+        link.reported_sinr_db = sinr_db;
+        return true;
+    }
+    return false;
+}
+
+void InterferenceTable::setLink(uint32_t ue_id, uint32_t gnb_id,
+                                double rx_mw)
+{
+    std::vector<Link>& links = ue_links_[ue_id];
+    for (Link& link : links) {
+        if (link.gnb_id == gnb_id) {
+            link.rx_mw = rx_mw;
+            return;
+        }
+    }
+    links.push_back({gnb_id, rx_mw, NOT_HEARD});
+    gnb_ues_[gnb_id].push_back(ue_id);
+}
+
+void InterferenceTable::eraseLink(uint32_t ue_id, uint32_t gnb_id)
+{
+    std::vector<Link>& links = ue_links_[ue_id];
+    for (size_t i = 0; i < links.size(); ++i) {
+        if (links[i].gnb_id == gnb_id) {
+            links[i] = links.back();
+            links.pop_back();
+            break;
+        }
+    }
+    eraseId(gnb_ues_[gnb_id], ue_id);
+}
+
+double InterferenceTable::sinrDb(const std::vector<Link>& links,
+                                 const Link& link) const
+{
+    double total_mw = 0.0;
+    for (const Link& other : links) {
+        total_mw += other.rx_mw;
+    }
+    return 10.0 * std::log10(link.rx_mw / (total_mw - link.rx_mw + noise_mw_));
+}
@@ -0,0 +1,138 @@
+#include "link_budget.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct PathLossCoefficients {
+    double a;
+    double b;
+    double c;
+};
+
+PathLossCoefficients coefficientsFor(PathLossModel model)
+{
+    switch (model) {
+        case PathLossModel::FreeSpace:
+            return {32.45, 20.0, 20.0};
+        case PathLossModel::UrbanMacro:
+            return {13.54, 39.08, 20.0};
+        case PathLossModel::UrbanMicro:
+            return {22.4, 35.3, 21.3};
+        case PathLossModel::None:
+        default:
+            return {0.0, 0.0, 0.0};
+    }
+}
+
+}  // namespace
+
+LinkBudget::LinkBudget(PathLossModel model, double carrier_frequency_ghz)
+    : model_(model)
+{
+    const PathLossCoefficients coeff = coefficientsFor(model);
+    const double fc = carrier_frequency_ghz > 0.0 ? carrier_frequency_ghz : 1.0;
+
+    intercept_db_ = coeff.a + coeff.c * std::log10(fc);
+    // log10(d) = 0.5 * log10(d^2) = 0.5 * ln(d^2) / ln(10): no sqrt needed.
+    slope_per_log10_d2_ = 0.5 * coeff.b / std::log(10.0);
+}
+
+bool LinkBudget::isEnabled() const
+{
+    return model_ != PathLossModel::None;
+}
+
+double LinkBudget::pathLossDb(double distance_m) const
+{
+    const double d = std::max(distance_m, MIN_DISTANCE_M);
+    return intercept_db_ + slope_per_log10_d2_ * std::log(d * d);
+}
+
+bool LinkBudget::isAudible(double rsrp_dbm, double min_rx_level_dbm) const
+{
+    return !isEnabled() || rsrp_dbm >= min_rx_level_dbm;
+}
+
+void LinkBudget::pathLossBatch(const double* __restrict xs,
+                               const double* __restrict ys, size_t count,
+                               double x, double y,
+                               double* __restrict out_db) const
+{
+    const double min_d2 = MIN_DISTANCE_M * MIN_DISTANCE_M;
+    const double intercept = intercept_db_;
+    const double slope = slope_per_log10_d2_;
+
+    for (size_t i = 0; i < count; ++i) {
+        const double dx = xs[i] - x;
+        const double dy = ys[i] - y;
+        const double d2 = std::max(dx * dx + dy * dy, min_d2);
+        out_db[i] = intercept + slope * std::log(d2);
+    }
+}
+
+void GnbRadioTable::upsert(uint32_t id, double x, double y, double radius,
+                           double tx_power_dbm, double min_rx_level_dbm)
+{
+    const uint32_t i = index_.find(id);
+    if (i != IdSlotMap::NPOS) {
+        xs_[i] = x;
+        ys_[i] = y;
+        radius_[i] = radius;
+        tx_power_dbm_[i] = tx_power_dbm;
+        min_rx_level_dbm_[i] = min_rx_level_dbm;
+        return;
+    }
+
+    index_.assign(id, static_cast<uint32_t>(ids_.size()));
+    ids_.push_back(id);
+    xs_.push_back(x);
+    ys_.push_back(y);
+    radius_.push_back(radius);
+    tx_power_dbm_.push_back(tx_power_dbm);
+    min_rx_level_dbm_.push_back(min_rx_level_dbm);
+}
+
+void GnbRadioTable::move(uint32_t id, double x, double y)
+{
+    const uint32_t i = index_.find(id);
+    if (i == IdSlotMap::NPOS) {
+        return;
+    }
+    xs_[i] = x;
+    ys_[i] = y;
+}
+
+bool GnbRadioTable::remove(uint32_t id)
+{
+    const uint32_t i = index_.find(id);
+    if (i == IdSlotMap::NPOS) {
+        return false;
+    }
+
+    const uint32_t last = static_cast<uint32_t>(ids_.size() - 1);
+    if (i != last) {
+        ids_[i] = ids_[last];
+        xs_[i] = xs_[last];
+        ys_[i] = ys_[last];
+        radius_[i] = radius_[last];
+        tx_power_dbm_[i] = tx_power_dbm_[last];
+        min_rx_level_dbm_[i] = min_rx_level_dbm_[last];
+        index_.assign(ids_[i], i);
+    }
+
+    ids_.pop_back();
+    xs_.pop_back();
+    ys_.pop_back();
+    radius_.pop_back();
+    tx_power_dbm_.pop_back();
+    min_rx_level_dbm_.pop_back();
+    index_.erase(id);
+    return true;
+}
+
+size_t GnbRadioTable::size() const
+{
+    return ids_.size();
+}
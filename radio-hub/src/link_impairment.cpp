@@ -0,0 +1,73 @@
+#include "link_impairment.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+bool isImpairing(const LinkProfile& profile)
+{
+    return profile.delay_ms > 0.0 || profile.jitter_ms > 0.0 ||
+           profile.loss_probability > 0.0;
+}
+
+}  // namespace
+
+LinkImpairment::LinkImpairment(const LinkImpairmentSettings& settings)
+    : base_(settings.base)
+    , delay_per_km_ms_(settings.delay_per_km_ms)
+    , is_enabled_(isImpairing(settings.base) || settings.delay_per_km_ms > 0.0)
+{
+    for (const LinkOverride& link : settings.links) {
+        overrides_[linkKey(link.src_id, link.dst_id)] = link.profile;
+        is_enabled_ = is_enabled_ || isImpairing(link.profile);
+    }
+}
+
+bool LinkImpairment::isEnabled() const
+{
+    return is_enabled_;
+}
+
+LinkDecision LinkImpairment::decide(uint32_t src_id, uint32_t dst_id,
+                                    double distance_m,
+                                    std::mt19937& rng) const
+{
+    LinkDecision decision;
+    if (!is_enabled_) {
+        return decision;
+    }
+
+    LinkProfile profile = base_;
+    auto it = overrides_.find(linkKey(src_id, dst_id));
+    if (it != overrides_.end()) {
+        profile = it->second;
+    } else {
+        profile.delay_ms += delay_per_km_ms_ * distance_m / 1000.0;
+    }
+
+    if (profile.loss_probability > 0.0) {
+        std::bernoulli_distribution loss(
+            std::min(profile.loss_probability, 1.0));
+        if (loss(rng)) {
+            decision.is_lost = true;
+            return decision;
+        }
+    }
+
+    double delay_ms = profile.delay_ms;
+    if (profile.jitter_ms > 0.0) {
+        std::uniform_real_distribution<double> jitter(-profile.jitter_ms,
+                                                      profile.jitter_ms);
+        delay_ms += jitter(rng);
+    }
+
+    decision.delay_ms =
+        static_cast<uint32_t>(std::lround(std::max(delay_ms, 0.0)));
+    return decision;
+}
+
+uint64_t LinkImpairment::linkKey(uint32_t src_id, uint32_t dst_id)
+{
+    return (static_cast<uint64_t>(src_id) << 32) | dst_id;
+}
@@ -0,0 +1,89 @@
+#include "liveness_tracker.hpp"
+
+#include <algorithm>
+
+LivenessTracker::LivenessTracker(uint32_t timeout_ms)
+    : timeout_ms_(std::max(timeout_ms, 1u))
+{
+}
+
+void LivenessTracker::track(uint32_t id, uint64_t now_ms)
+{
+    auto [it, is_new] = entries_.try_emplace(id);
+    it->second.last_seen_ms.store(now_ms, std::memory_order_relaxed);
+    if (is_new) {
+        it->second.timer = wheel_.schedule(now_ms + timeout_ms_, id);
+    }
+}
+
+void LivenessTracker::forget(uint32_t id)
+{
+    const auto it = entries_.find(id);
+    if (it == entries_.end()) {
+        return;
+    }
+    wheel_.cancel(it->second.timer);
+    entries_.erase(it);
+}
+
+void LivenessTracker::touch(uint32_t id, uint64_t now_ms)
+{
+    const auto it = entries_.find(id);
+    if (it != entries_.end()) {
+        it->second.last_seen_ms.store(now_ms, std::memory_order_relaxed);
+    }
+}
+
+bool LivenessTracker::isTracked(uint32_t id) const
+{
+    return entries_.count(id) != 0;
+}
+
+size_t LivenessTracker::size() const
+{
+    return entries_.size();
+}
+
+SendQuarantine::SendQuarantine(uint32_t max_errors, uint32_t quarantine_ms)
+    : max_errors_(std::max(max_errors, 1u))
+    , quarantine_ms_(quarantine_ms)
+{
+}
+
+bool SendQuarantine::isBlocked(uint64_t endpoint, uint64_t now_ms)
+{
+    if (size_.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = entries_.find(endpoint);
+    return it != entries_.end() && it->second.blocked_until_ms > now_ms;
+}
+
+bool SendQuarantine::recordFailure(uint64_t endpoint, uint64_t now_ms)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_[endpoint];
+    size_.store(entries_.size(), std::memory_order_relaxed);
+    entry.errors = std::min(entry.errors + 1, max_errors_);
+    if (entry.errors < max_errors_) {
+        return false;
+    }
+    entry.blocked_until_ms = now_ms + quarantine_ms_;
+    return true;
+}
+
+void SendQuarantine::clear(uint64_t endpoint)
+{
+    if (size_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(endpoint);
+    size_.store(entries_.size(), std::memory_order_relaxed);
+}
+
+size_t SendQuarantine::size() const
+{
+    return size_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,70 @@
+#include "metrics_server.hpp"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "hub_metrics.hpp"
+
+MetricsServer::MetricsServer(const HubMetrics& metrics, QObject* parent)
+    : QObject(parent)
+    , metrics_(metrics)
+    , server_(new QTcpServer(this))
+{
+    connect(server_, &QTcpServer::newConnection, this,
+            &MetricsServer::onNewConnection);
+}
+
+bool MetricsServer::listen(quint16 port)
+{
+    return server_->listen(QHostAddress::LocalHost, port);
+}
+
+void MetricsServer::onNewConnection()
+{
+    while (QTcpSocket* socket = server_->nextPendingConnection()) {
+        requests_.insert(socket, QByteArray());
+        connect(socket, &QTcpSocket::readyRead, this,
+                [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            requests_.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MetricsServer::onReadyRead(QTcpSocket* socket)
+{
+    QByteArray& request = requests_[socket];
+    request.append(socket->readAll());
+
+    if (!request.contains("\r\n\r\n")) {
+        if (request.size() > MAX_REQUEST_SIZE) {
+            reply(socket, "413 Payload Too Large", QByteArray());
+        }
+        return;
+    }
+
+    const QList<QByteArray> request_line =
+        request.left(request.indexOf("\r\n")).split(' ');
+    if (request_line.size() < 2 || request_line[0] != "GET") {
+        reply(socket, "405 Method Not Allowed", QByteArray());
+    } else if (request_line[1] != "/metrics" && request_line[1] != "/") {
+        reply(socket, "404 Not Found", QByteArray());
+    } else {
+        reply(socket, "200 OK",
+              QByteArray::fromStdString(metrics_.renderPrometheus()));
+    }
+}
+
+void MetricsServer::reply(QTcpSocket* socket, const QByteArray& status,
+                          const QByteArray& body)
+{
+    QByteArray response = "HTTP/1.1 " + status + "\r\n";
+    response += "Content-Type: text/plain; version=0.0.4\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+
+    socket->write(response);
+    socket->disconnectFromHost();
+}
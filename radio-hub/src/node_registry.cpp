@@ -0,0 +1,145 @@
+#include "node_registry.hpp"
+
+uint32_t NodeRegistry::insert(const NodeInfo& node, bool is_remote,
+                              bool shared_endpoint)
+{
+    const auto* gnb = std::get_if<GnbData>(&node.specific_data);
+    const double radius = gnb ? gnb->radius : 0.0;
+
+    uint32_t slot = index_.find(node.id);
+    if (slot != NPOS) {
+        types_[slot] = node.type;
+        xs_[slot] = node.position.x();
+        ys_[slot] = node.position.y();
+        radii_[slot] = radius;
+        addresses_[slot] = node.address;
+        ports_[slot] = node.port;
+        remote_[slot] = is_remote;
+        shared_[slot] = shared_endpoint;
+        details_[slot] = node.specific_data;
+        return slot;
+    }
+
+    slot = static_cast<uint32_t>(ids_.size());
+    index_.assign(node.id, slot);
+    ids_.push_back(node.id);
+    types_.push_back(node.type);
+    xs_.push_back(node.position.x());
+    ys_.push_back(node.position.y());
+    radii_.push_back(radius);
+    addresses_.push_back(node.address);
+    ports_.push_back(node.port);
+    remote_.push_back(is_remote);
+    shared_.push_back(shared_endpoint);
+    details_.push_back(node.specific_data);
+    return slot;
+}
+
+bool NodeRegistry::remove(uint32_t id)
+{
+    const uint32_t slot = index_.find(id);
+    if (slot == NPOS) {
+        return false;
+    }
+
+    const uint32_t last = static_cast<uint32_t>(ids_.size() - 1);
+    if (slot != last) {
+        ids_[slot] = ids_[last];
+        types_[slot] = types_[last];
+        xs_[slot] = xs_[last];
+        ys_[slot] = ys_[last];
+        radii_[slot] = radii_[last];
+        addresses_[slot] = std::move(addresses_[last]);
+        ports_[slot] = ports_[last];
+        remote_[slot] = remote_[last];
+        shared_[slot] = shared_[last];
+        details_[slot] = std::move(details_[last]);
+        index_.assign(ids_[slot], slot);
+    }
+
+    ids_.pop_back();
+    types_.pop_back();
+    xs_.pop_back();
+    ys_.pop_back();
+    radii_.pop_back();
+    addresses_.pop_back();
+    ports_.pop_back();
+    remote_.pop_back();
+    shared_.pop_back();
+    details_.pop_back();
+    index_.erase(id);
+    return true;
+}
+
+uint32_t NodeRegistry::find(uint32_t id) const
+{
+    return index_.find(id);
+}
+
+size_t NodeRegistry::size() const
+{
+    return ids_.size();
+}
+
+uint32_t NodeRegistry::id(uint32_t slot) const
+{
+    return ids_[slot];
+}
+
+EntityType NodeRegistry::type(uint32_t slot) const
+{
+    return types_[slot];
+}
+
+QPointF NodeRegistry::position(uint32_t slot) const
+{
+    return QPointF(xs_[slot], ys_[slot]);
+}
+
+void NodeRegistry::setPosition(uint32_t slot, const QPointF& position)
+{
+    xs_[slot] = position.x();
+    ys_[slot] = position.y();
+}
+
+const QHostAddress& NodeRegistry::address(uint32_t slot) const
+{
+    return addresses_[slot];
+}
+
+quint16 NodeRegistry::port(uint32_t slot) const
+{
+    return ports_[slot];
+}
+
+double NodeRegistry::radius(uint32_t slot) const
+{
+    return radii_[slot];
+}
+
+const GnbData* NodeRegistry::gnbData(uint32_t slot) const
+{
+    return std::get_if<GnbData>(&details_[slot]);
+}
+
+bool NodeRegistry::isRemote(uint32_t slot) const
+{
+    return remote_[slot] != 0;
+}
+
+bool NodeRegistry::hasSharedEndpoint(uint32_t slot) const
+{
+    return shared_[slot] != 0;
+}
+
+NodeInfo NodeRegistry::nodeInfo(uint32_t slot) const
+{
+    NodeInfo info;
+    info.id = ids_[slot];
+    info.type = types_[slot];
+    info.address = addresses_[slot];
+    info.port = ports_[slot];
+    info.position = position(slot);
+    info.specific_data = details_[slot];
+    return info;
+}
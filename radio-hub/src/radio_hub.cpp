@@ -1,24 +1,86 @@
 #include "radio_hub.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <optional>
+#include <utility>
 
 #include <QDataStream>
 #include <QDebug>
 #include <QLine>
+#include <QReadLocker>
+#include <QTimer>
+#include <QWriteLocker>
+
+#include "hub_worker.hpp"
 
 RadioHub::RadioHub(const HubSettings set, QObject* parent)
     : QObject(parent)
-    , transport_(new UdpTransport(this))
+    , transport_(new UdpTransport(this, set.udp_backend))
+    , egress_(new HubEgress(transport_, 0, &shm_router_, this))
+    , ue_grid_(set.grid_cell_size)
+    , link_budget_(set.path_loss_model, set.carrier_frequency_ghz)
+    , link_impairment_(set.link_impairment)
+    , metrics_(std::max(set.worker_threads, 1u))
+    , metrics_settings_(set.metrics)
+    , federation_(set.federation)
+    , shm_router_(set.shm_transport)
+    , interference_settings_(set.interference)
+    , is_interference_enabled_(set.interference.enabled &&
+                               link_budget_.isEnabled())
+    , interference_(set.interference.noise_floor_dbm)
+    , liveness_settings_(set.liveness)
+    , liveness_(set.liveness.node_timeout_ms)
+    , send_quarantine_(set.liveness.max_send_errors, set.liveness.quarantine_ms)
+    , recording_settings_(set.recording)
     , port_(set.port)
     , hub_id_(set.id)
     , broadcast_id_(set.broadcast_id)
     , position_(QPointF(set.virt_pos.X, set.virt_pos.Y))
     , address_(set.address)
+    , worker_count_(set.worker_threads)
+    , udp_backend_(set.udp_backend)
 {
+    qRegisterMetaType<NodeInfo>("NodeInfo");
+    clock_.start();
+
+    if (set.capture.enabled) {
+        capture_ = std::make_unique<SignalingCapture>(
+            set.capture, std::max(worker_count_, 1u));
+    }
+
+    if (federation_.isEnabled()) {
+        port_ = federation_.ownPort();
+        qDebug() << "[RadioHub] Federated hub of region"
+                 << set.federation.region_id;
+    }
+
+    if (set.interference.enabled && !is_interference_enabled_) {
+        qWarning() << "[RadioHub] Interference needs a path loss model,"
+                   << "SINR is disabled";
+    }
+}
+
+RadioHub::~RadioHub()
+{
+    stopWorkers();
 }
 
 bool RadioHub::run()
 {
+    startCapture();
+    startMetricsServer();
+
+    if (recording_settings_.mode == TrafficMode::Replay) {
+        return startReplay();
+    }
+    startRecording();
+
+    if (worker_count_ > 1) {
+        return startWorkers();
+    }
+
     if (!transport_->init(port_)) {
         qCritical() << "[RadioHub] Failed to bind to port " << port_;
         return false;
@@ -26,48 +88,291 @@ bool RadioHub::run()
 
     connect(transport_, &UdpTransport::dataReceived, this,
             &RadioHub::onDataReceived);
+    attachEgress(egress_);
 
     qDebug() << "[RadioHub] Core started. Listening on port:" << port_;
 
     return true;
 }
 
+bool RadioHub::startWorkers()
+{
+    for (uint32_t index = 0; index < worker_count_; ++index) {
+        auto* thread = new QThread(this);
+        thread->setObjectName(QString("hub-worker-%1").arg(index));
+
+        auto* worker = new HubWorker(index, port_, udp_backend_,
+                                     &shm_router_, this);
+        worker->moveToThread(thread);
+        connect(thread, &QThread::finished, worker, &QObject::deleteLater);
+        thread->start();
+        worker_threads_.push_back(thread);
+
+        bool is_ready = false;
+        QMetaObject::invokeMethod(worker, &HubWorker::init,
+                                  Qt::BlockingQueuedConnection, &is_ready);
+        if (!is_ready) {
+            qCritical() << "[RadioHub] Worker" << index
+                        << "failed to bind to shared port" << port_;
+            stopWorkers();
+            return false;
+        }
+    }
+
+    qDebug() << "[RadioHub] Core started with" << worker_count_
+             << "workers. Listening on port:" << port_;
+
+    return true;
+}
+
+void RadioHub::startCapture()
+{
+    if (!capture_) {
+        return;
+    }
+
+    if (capture_->start()) {
+        qDebug() << "[RadioHub] Signaling capture is written to"
+                 << QString::fromStdString(capture_->path());
+    } else {
+        qWarning() << "[RadioHub] Failed to open signaling capture file,"
+                   << "capture is disabled";
+        capture_.reset();
+    }
+}
+
+void RadioHub::startMetricsServer()
+{
+    if (!metrics_settings_.enabled) {
+        return;
+    }
+
+    metrics_server_ = new MetricsServer(metrics_, this);
+    if (metrics_server_->listen(metrics_settings_.port)) {
+        qDebug() << "[RadioHub] Metrics are served on 127.0.0.1:"
+                 << metrics_settings_.port;
+    } else {
+        qWarning() << "[RadioHub] Failed to bind metrics port"
+                   << metrics_settings_.port;
+    }
+}
+
+void RadioHub::startRecording()
+{
+    if (recording_settings_.mode != TrafficMode::Record) {
+        return;
+    }
+
+    recorder_ = std::make_unique<TrafficRecorder>(recording_settings_.path);
+    if (recorder_->open()) {
+        qDebug() << "[RadioHub] Inbound traffic is recorded to"
+                 << QString::fromStdString(recorder_->path());
+    } else {
+        qWarning() << "[RadioHub] Failed to open traffic recording file,"
+                   << "recording is disabled";
+        recorder_.reset();
+    }
+}
+
+bool RadioHub::startReplay()
+{
+    if (!recording_settings_.replay_output_path.empty()) {
+        replay_output_ = std::make_unique<TrafficRecorder>(
+            recording_settings_.replay_output_path);
+        if (!replay_output_->open()) {
+            qWarning() << "[RadioHub] Failed to open replay output file,"
+                       << "sends are only counted";
+            replay_output_.reset();
+        }
+    }
+
+    // Replay runs on this thread only; nothing is sent.
+    attachEgress(egress_);
+    egress_->setSendSink([this](const QByteArray& data,
+                                const QHostAddress& address, quint16 port) {
+        ++replay_sends_;
+        if (replay_output_) {
+            replay_output_->record(nowUs(), address.toIPv4Address(), port,
+                                   data.constData(),
+                                   static_cast<size_t>(data.size()));
+        }
+    });
+
+    replayer_ = new TrafficReplayer(
+        recording_settings_.path, recording_settings_.replay_speed,
+        [this](const QByteArray& data, const QHostAddress& sender_ip,
+               quint16 sender_port) {
+            onDataReceived(data, sender_ip, sender_port);
+        },
+        this);
+    connect(replayer_, &TrafficReplayer::finished, this,
+            &RadioHub::onReplayFinished);
+
+    qDebug() << "[RadioHub] Replaying"
+             << QString::fromStdString(recording_settings_.path)
+             << "at speed" << recording_settings_.replay_speed
+             << "(0 = as fast as possible)";
+    if (!replayer_->start()) {
+        qCritical() << "[RadioHub] Failed to open traffic recording"
+                    << QString::fromStdString(recording_settings_.path);
+        return false;
+    }
+    return true;
+}
+
+void RadioHub::onReplayFinished()
+{
+    const qint64 elapsed_ms = std::max<qint64>(replayer_->elapsedMs(), 1);
+    qInfo() << "[RadioHub] Replay finished:" << replayer_->replayed()
+            << "datagrams in" << elapsed_ms << "ms,"
+            << replayer_->replayed() * 1000 / elapsed_ms << "datagrams/s,"
+            << replay_sends_ << "sends captured," << egress_->inFlight()
+            << "still delayed";
+
+    if (replay_output_) {
+        replay_output_->close();
+    }
+    emit replayFinished();
+}
+
+void RadioHub::stopWorkers()
+{
+    for (QThread* thread : worker_threads_) {
+        thread->quit();
+        thread->wait();
+    }
+    qDeleteAll(worker_threads_);
+    worker_threads_.clear();
+}
+
+void RadioHub::attachEgress(HubEgress* egress)
+{
+    if (!liveness_settings_.enabled) {
+        return;
+    }
+
+    egress->enableQuarantine(&send_quarantine_, &metrics_.lane(egress->lane()));
+    if (egress->lane() != 0) {
+        return;
+    }
+
+    // Removals of expired nodes are sent from a routing socket, so peers
+    // recognise this hub's port.
+    auto* expiry_timer = new QTimer(egress);
+    connect(expiry_timer, &QTimer::timeout, egress,
+            [this, egress]() { expireSilentNodes(egress); });
+    expiry_timer->start(
+        static_cast<int>(std::max(liveness_settings_.node_timeout_ms / 4, 1u)));
+}
+
 void RadioHub::onDataReceived(const QByteArray& raw_data,
                               const QHostAddress& sender_ip,
                               quint16 sender_port)
 {
-    auto packet = SimProtocol::parse(raw_data);
+    processDatagram(raw_data, sender_ip, sender_port, egress_);
+}
+
+void RadioHub::processDatagram(const QByteArray& raw_data,
+                               const QHostAddress& sender_ip,
+                               quint16 sender_port, HubEgress* egress)
+{
+    HubThreadMetrics& stats = metrics_.lane(egress->lane());
+    const auto started = std::chrono::steady_clock::now();
+    bump(stats.packets_in);
+    egress->noteHeardFrom(sender_ip, sender_port);
+
+    if (recorder_) {
+        recorder_->record(nowUs(), sender_ip.toIPv4Address(), sender_port,
+                          raw_data.constData(),
+                          static_cast<size_t>(raw_data.size()));
+    }
 
-    if (!packet.isValid) {
+    const auto header = SimProtocol::peekHeader(raw_data);
+
+    if (!header.isValid) {
+        bump(stats.dropped_invalid);
         return;
     }
 
-    if (packet.isForHub(hub_id_)) {
-        handleHubMessage(packet, sender_ip, sender_port);
+    bump(stats.sim_msg_types[static_cast<uint8_t>(header.type)]);
+    if (header.type == SimMessageType::Data) {
+        bump(stats.protocol_msg_types[static_cast<uint8_t>(
+            SimProtocol::peekProtocolType(raw_data))]);
+    }
+
+    if (capture_) {
+        capture_->record(egress->lane(), raw_data.constData(),
+                         static_cast<size_t>(raw_data.size()), header.srcId,
+                         header.dstId, static_cast<uint8_t>(header.type));
+    }
+
+    routeDatagram(raw_data, header, sender_ip, sender_port, egress);
+
+    stats.processing_ns.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started)
+            .count()));
+}
+
+void RadioHub::routeDatagram(const QByteArray& raw_data,
+                             const SimProtocol::HeaderView& header,
+                             const QHostAddress& sender_ip,
+                             quint16 sender_port, HubEgress* egress)
+{
+    if (header.type == SimMessageType::HubForward) {
+        handleHubForward(raw_data, header.dstId, sender_ip, sender_port,
+                         egress);
+        return;
+    }
+
+    if (header.type == SimMessageType::Bundle && header.isForHub(hub_id_)) {
+        handleBundle(raw_data, header, egress);
+        return;
+    }
+
+    if (header.isForHub(hub_id_)) {
+        const auto packet = SimProtocol::parse(raw_data);
+        handleHubMessage(packet, sender_ip, sender_port, egress);
         return;
     }
 
-    updatePosition(packet.srcId, packet.nodeType, packet.position);
+    updatePosition(header.srcId, header.nodeType, header.position, egress);
 
-    if (packet.isBroadcast(broadcast_id_)) {
-        broadcastFromGbn(raw_data, packet.srcId);
+    if (header.isBroadcast(broadcast_id_)) {
+        broadcastFromGbn(raw_data, header.srcId, egress);
         return;
     }
 
-    forwardToNode(raw_data, packet.dstId, packet.srcId);
+    forwardToNode(raw_data, header.dstId, header.srcId, egress);
 }
 
 void RadioHub::handleRegistration(const uint32_t node_id,
                                   const QHostAddress& sender_ip,
                                   quint16 sender_port, const EntityType type,
-                                  const QPointF& position, const double& radius)
+                                  const QPointF& position,
+                                  const GnbRegistrationInfo& gnb_info,
+                                  bool shared_endpoint, HubEgress* egress)
 {
+    const uint32_t owner = federation_.isEnabled()
+                               ? federation_.ownerIndex(position)
+                               : RegionMap::NONE;
+    if (owner != RegionMap::NONE) {
+        qDebug() << "[RadioHub] Node" << node_id
+                 << "belongs to another region, redirecting";
+        sendRedirect(node_id, owner, true, sender_ip, sender_port, egress);
+        return;
+    }
+
     uint8_t reg_status = HubResponse::REG_DENIED;
+    std::optional<NodeInfo> registered_node;
+    QWriteLocker locker(&registry_lock_);
+
+    const uint32_t existing = nodes_.find(node_id);
 
     if (node_id == hub_id_ || node_id == broadcast_id_) {
         qWarning() << "Registration REJECTED: Invalid Reserved ID";
         reg_status = HubResponse::REG_DENIED;
-    } else if (ues_.contains(node_id) || gnbs_.contains(node_id)) {
+    } else if (existing != NodeRegistry::NPOS && !nodes_.isRemote(existing)) {
         qWarning() << "Registration stoped: the node with "
                       "this ID already registred";
         reg_status = HubResponse::REG_DENIED;
@@ -76,23 +381,27 @@ void RadioHub::handleRegistration(const uint32_t node_id,
             case EntityType::UE: {
                 const NodeInfo ue_data{node_id,     EntityType::UE, sender_ip,
                                        sender_port, position,       UeData{}};
-                ues_[node_id] = ue_data;
+                syncMirrors(insertNode(ue_data, false, shared_endpoint),
+                            egress);
                 qDebug() << QString("[RadioHub] UE %1 registered").arg(node_id);
                 reg_status = HubResponse::REG_ACCEPTED;
-
-                emit nodeRegistered(ue_data);
+                registered_node = ue_data;
                 break;
             }
             case EntityType::GNB: {
-                const NodeInfo gnb_data{
-                    node_id,   EntityType::GNB,
-                    sender_ip, sender_port,
-                    position,  GnbData{radius, GnbData::INITIAL_UE_COUNT}};
-                gnbs_[node_id] = gnb_data;
+                const GnbData radio{
+                    gnb_info.radius, GnbData::INITIAL_UE_COUNT,
+                    gnb_info.tx_power_dbm,
+                    static_cast<double>(gnb_info.min_rx_level)};
+                const NodeInfo gnb_data{node_id,     EntityType::GNB,
+                                        sender_ip,   sender_port,
+                                        position,    radio};
+                syncMirrors(insertNode(gnb_data, false, shared_endpoint),
+                            egress);
                 qDebug()
                     << QString("[RadioHub] GNB %1 registered").arg(node_id);
                 reg_status = HubResponse::REG_ACCEPTED;
-                emit nodeRegistered(gnb_data);
+                registered_node = gnb_data;
                 break;
             }
             case EntityType::RadioHub: {
@@ -115,11 +424,116 @@ void RadioHub::handleRegistration(const uint32_t node_id,
         }
     }
 
-    sendRegistrationResponse(node_id, reg_status, sender_ip, sender_port);
+    flushLinkReports(egress);
+    locker.unlock();
+
+    if (registered_node) {
+        emit nodeRegistered(registered_node.value());
+    }
+
+    sendRegistrationResponse(node_id, reg_status, sender_ip, sender_port,
+                             egress);
+}
+
+void RadioHub::handleShmAttach(uint32_t node_id, const QHostAddress& sender_ip,
+                               quint16 sender_port, HubEgress* egress)
+{
+    bool is_registered = false;
+    if (shm_router_.isEnabled() && sender_ip.isLoopback()) {
+        QReadLocker locker(&registry_lock_);
+        const uint32_t slot = nodes_.find(node_id);
+        is_registered = slot != NodeRegistry::NPOS &&
+                        !nodes_.isRemote(slot) &&
+                        nodes_.port(slot) == sender_port;
+    }
+
+    // Owned by the egress, so the ring is drained by the routing thread
+    // that also receives this node's UDP traffic.
+    ShmChannel* channel =
+        is_registered
+            ? shm_router_.attach(sender_port,
+                                 ShmChannel::nameFor(port_, node_id), egress)
+            : nullptr;
+
+    uint8_t status = HubResponse::REG_DENIED;
+    if (channel) {
+        connect(
+            channel, &ShmChannel::datagramReceived, egress,
+            [this, egress, sender_port](const QByteArray& data) {
+                processDatagram(data, QHostAddress(QHostAddress::LocalHost),
+                                sender_port, egress);
+            },
+            Qt::DirectConnection);
+        channel->listen();
+        status = HubResponse::REG_ACCEPTED;
+        qDebug() << "[RadioHub] Node" << node_id
+                 << "switched to shared-memory transport";
+    }
+
+    QByteArray payload;
+    payload.append(static_cast<char>(status));
+    egress->send(SimProtocol::buildPacket(hub_id_, EntityType::RadioHub,
+                                          node_id, SimMessageType::ShmAttach,
+                                          position_, payload),
+                 sender_ip, sender_port);
+    bump(metrics_.lane(egress->lane()).packets_out);
+}
+
+void RadioHub::handleHeartbeat(uint32_t node_id, const QHostAddress& sender_ip,
+                               quint16 sender_port, HubEgress* egress)
+{
+    {
+        QReadLocker locker(&registry_lock_);
+        const uint32_t slot = nodes_.find(node_id);
+        if (slot != NodeRegistry::NPOS && !nodes_.isRemote(slot) &&
+            nodes_.port(slot) == sender_port) {
+            liveness_.touch(node_id, nowMs());
+            return;
+        }
+    }
+
+    // Expired or never registered here: the node has to register again.
+    QByteArray payload;
+    payload.append(static_cast<char>(HubResponse::REG_DENIED));
+    egress->send(SimProtocol::buildPacket(hub_id_, EntityType::RadioHub,
+                                          node_id, SimMessageType::Heartbeat,
+                                          position_, payload),
+                 sender_ip, sender_port);
+    bump(metrics_.lane(egress->lane()).packets_out);
+}
+
+void RadioHub::expireSilentNodes(HubEgress* egress)
+{
+    QWriteLocker locker(&registry_lock_);
+
+    liveness_.expire(nowMs(), [this, egress](uint32_t id) {
+        const uint32_t slot = nodes_.find(id);
+        if (slot == NodeRegistry::NPOS || nodes_.isRemote(slot)) {
+            return;
+        }
+        qWarning() << "[RadioHub] Node" << id << "silent for"
+                   << liveness_settings_.node_timeout_ms
+                   << "ms, dropping its registration";
+        dropMirrors(id, RegionMap::NONE, egress);
+        removeNode(id);
+        bump(metrics_.lane(egress->lane()).nodes_expired);
+    });
+    flushLinkReports(egress);
+}
+
+uint64_t RadioHub::nowMs() const
+{
+    return static_cast<uint64_t>(clock_.elapsed());
+}
+
+uint64_t RadioHub::nowUs() const
+{
+    return static_cast<uint64_t>(clock_.nsecsElapsed() / 1000);
 }
 
 void RadioHub::sendRegistrationResponse(uint32_t node_id, uint8_t status,
-                                        const QHostAddress& ip, quint16 port)
+                                        const QHostAddress& ip, quint16 port,
+                                        HubEgress* egress)
 {
     QByteArray payload;
     QDataStream ds(&payload, QIODevice::WriteOnly);
@@ -130,22 +544,47 @@ void RadioHub::sendRegistrationResponse(uint32_t node_id, uint8_t status,
         hub_id_, EntityType::RadioHub, node_id,
         SimMessageType::RegistrationResponse, position_, payload);
 
-    transport_->sendData(response, ip, port);
+    egress->send(response, ip, port);
+    bump(metrics_.lane(egress->lane()).packets_out);
 }
 
 void RadioHub::handleHubMessage(const SimProtocol::DecodedPacket& packet,
                                 const QHostAddress& sender_ip,
-                                quint16 sender_port)
+                                quint16 sender_port, HubEgress* egress)
 {
     switch (packet.type) {
         case SimMessageType::Registration: {
-            handleRegistration(packet.srcId, sender_ip, sender_port,
-                               packet.nodeType, packet.position,
-                               SimProtocol::parseRadius(packet.payload));
+            handleRegistration(
+                packet.srcId, sender_ip, sender_port, packet.nodeType,
+                packet.position,
+                SimProtocol::parseGnbRegistration(packet.payload), false,
+                egress);
+            break;
+        }
+        case SimMessageType::RegistrationBatch: {
+            // Each node is answered on its own; the host demultiplexes.
+            for (const SimProtocol::BatchedNode& node :
+                 SimProtocol::parseRegistrationBatch(packet.payload)) {
+                handleRegistration(node.id, sender_ip, sender_port,
+                                   packet.nodeType, node.position,
+                                   GnbRegistrationInfo{}, true, egress);
+            }
             break;
         }
         case SimMessageType::Deregistration: {
-            handleDeregistration(packet.srcId, packet.nodeType);
+            handleDeregistration(packet.srcId, packet.nodeType, egress);
+            break;
+        }
+        case SimMessageType::HubSync: {
+            handlePeerSync(packet, sender_ip, sender_port, egress);
+            break;
+        }
+        case SimMessageType::ShmAttach: {
+            handleShmAttach(packet.srcId, sender_ip, sender_port, egress);
+            break;
+        }
+        case SimMessageType::Heartbeat: {
+            handleHeartbeat(packet.srcId, sender_ip, sender_port, egress);
             break;
         }
         default: {
@@ -154,85 +593,163 @@ void RadioHub::handleHubMessage(const SimProtocol::DecodedPacket& packet,
     }
 }
 
-void RadioHub::broadcastFromGbn(const QByteArray& raw_data, uint32_t src_id)
+void RadioHub::broadcastFromGbn(const QByteArray& raw_data, uint32_t src_id,
+                                HubEgress* egress)
 {
-    const NodeInfo* node = findNode(src_id);
+    QReadLocker locker(&registry_lock_);
 
-    if (!node) {
+    const uint32_t gnb_slot = nodes_.find(src_id);
+
+    if (gnb_slot == NodeRegistry::NPOS ||
+        nodes_.type(gnb_slot) != EntityType::GNB) {
+        bump(metrics_.lane(egress->lane()).dropped_not_registered);
+        if (gnb_slot != NodeRegistry::NPOS) {
+            qWarning() << "[RadioHub] Broadcast error: Node is not a GNB!";
+        }
         return;
     }
 
-    std::visit(
-        overloaded{[this, &raw_data, node](const GnbData& gnb) {
-                       double radius = gnb.radius;
-                       QPointF gnb_pos = node->position;
-
-                       qDebug()
-                           << QString(
-                                  "[RadioHub] Processing broadcast from GNB %1 "
-                                  "with radius %2")
-                                  .arg(node->id)
-                                  .arg(radius);
+    liveness_.touch(src_id, nowMs());
+    const CoveredUes& covered_ues = coverage_.uesOf(src_id);
+    metrics_.lane(egress->lane()).broadcast_fanout.record(covered_ues.size());
 
-                       for (auto it = ues_.begin(); it != ues_.end(); ++it) {
-                           const NodeInfo& ue_node = it.value();
+    qDebug() << QString(
+                    "[RadioHub] Processing broadcast from GNB %1 to %2 UEs in "
+                    "coverage")
+                    .arg(src_id)
+                    .arg(covered_ues.size());
 
-                           double distance =
-                               QLineF(gnb_pos, ue_node.position).length();
-
-                           if (distance <= radius) {
-                               transport_->sendData(raw_data, ue_node.address,
-                                                    ue_node.port);
-                           }
-                       }
-                   },
-                   [](const UeData&) {
-                       qWarning()
-                           << "[RadioHub] Broadcast error: Node is not a GNB!";
-                   }},
-        node->specific_data);
+    for (size_t i = 0; i < covered_ues.size(); ++i) {
+        const uint32_t ue_id = covered_ues.ids[i];
+        const uint32_t ue_slot = covered_ues.slots[i];
+        if (nodes_.hasSharedEndpoint(ue_slot)) {
+            deliver(SimProtocol::readdress(raw_data, ue_id), gnb_slot, ue_slot,
+                    egress);
+        } else {
+            deliver(raw_data, gnb_slot, ue_slot, egress);
+        }
+    }
 }
 
 void RadioHub::forwardToNode(const QByteArray& raw_data, const uint32_t dst_id,
-                             const uint32_t src_id)
+                             const uint32_t src_id, HubEgress* egress)
 {
-    const NodeInfo* target = findNode(dst_id);
-    const NodeInfo* source = findNode(src_id);
+    QReadLocker locker(&registry_lock_);
+
+    const uint32_t target = nodes_.find(dst_id);
+    const uint32_t source = nodes_.find(src_id);
+
+    HubThreadMetrics& stats = metrics_.lane(egress->lane());
 
-    if (!source) {
+    if (source == NodeRegistry::NPOS) {
+        bump(stats.dropped_not_registered);
         qWarning() << "[RadioHub] Forwarding FAILED: Source Node" << src_id
                    << "not registered";
         return;
     }
-    if (!target) {
+    liveness_.touch(src_id, nowMs());
+    if (target == NodeRegistry::NPOS) {
+        bump(stats.dropped_not_registered);
         qWarning() << "[RadioHub] Forwarding FAILED: Destination Node" << dst_id
                    << "not registered";
         return;
     }
 
     if (areWithinCoverageArea(source, target)) {
-        transport_->sendData(raw_data, target->address, target->port);
-        qDebug() << "[RadioHub] Packet delivered from" << src_id << "to"
-                 << dst_id;
+        deliver(raw_data, source, target, egress);
     } else {
+        bump(stats.dropped_out_of_coverage);
         qDebug() << "[RadioHub] Packet LOST: Distance between " << src_id
                  << " and " << dst_id << " exceeds coverage";
     }
 }
 
-const NodeInfo* RadioHub::findNode(uint32_t id) const
+void RadioHub::handleBundle(const QByteArray& raw_data,
+                            const SimProtocol::HeaderView& header,
+                            HubEgress* egress)
 {
-    auto itUe = ues_.find(id);
-    if (itUe != ues_.end()) {
-        return &itUe.value();
+    HubThreadMetrics& stats = metrics_.lane(egress->lane());
+
+    std::vector<SimProtocol::BundlePdu> pdus;
+    if (!SimProtocol::parseBundle(SimProtocol::view(raw_data), pdus)) {
+        bump(stats.dropped_invalid);
+        return;
+    }
+    bump(stats.bundled_pdus, pdus.size());
+    for (const SimProtocol::BundlePdu& pdu : pdus) {
+        bump(stats.protocol_msg_types[static_cast<uint8_t>(pdu.type)]);
     }
 
-    auto itGnb = gnbs_.find(id);
-    if (itGnb != gnbs_.end()) {
-        return &itGnb.value();
+    updatePosition(header.srcId, header.nodeType, header.position, egress);
+
+    // The PDUs of one destination leave together, in bundle order: a lone
+    // PDU as a plain Data datagram, several as a Bundle for that node.
+    std::vector<bool> routed(pdus.size(), false);
+    std::vector<SimProtocol::BundlePdu> group;
+    for (size_t first = 0; first < pdus.size(); ++first) {
+        if (routed[first]) {
+            continue;
+        }
+        const uint32_t dst_id = pdus[first].dstId;
+        group.clear();
+        for (size_t i = first; i < pdus.size(); ++i) {
+            if (!routed[i] && pdus[i].dstId == dst_id) {
+                group.push_back(pdus[i]);
+                routed[i] = true;
+            }
+        }
+
+        const QByteArray datagram =
+            group.size() == 1
+                ? SimProtocol::buildDataPacket(
+                      header.srcId, header.nodeType, dst_id, header.position,
+                      group.front().type, group.front().payload())
+                : SimProtocol::buildBundlePacket(header.srcId,
+                                                 header.nodeType, dst_id,
+                                                 header.position, group);
+        if (dst_id == broadcast_id_) {
+            broadcastFromGbn(datagram, header.srcId, egress);
+        } else {
+            forwardToNode(datagram, dst_id, header.srcId, egress);
+        }
+    }
+}
+
+void RadioHub::deliver(const QByteArray& raw_data, uint32_t source_slot,
+                       uint32_t target_slot, HubEgress* egress)
+{
+    const uint32_t source_id = nodes_.id(source_slot);
+    const uint32_t target_id = nodes_.id(target_slot);
+
+    LinkDecision link;
+    if (link_impairment_.isEnabled()) {
+        link = link_impairment_.decide(
+            source_id, target_id,
+            calculateDistance(nodes_.position(source_slot),
+                              nodes_.position(target_slot)),
+            egress->rng());
     }
 
-    return nullptr;
+    HubThreadMetrics& stats = metrics_.lane(egress->lane());
+    if (link.is_lost) {
+        bump(stats.dropped_link_loss);
+        qDebug() << "[RadioHub] Packet LOST: link impairment dropped packet"
+                 << "from" << source_id << "to" << target_id;
+        return;
+    }
+
+    // Mirrors are reached through their owning hub, which unwraps the packet.
+    const QByteArray& packet =
+        nodes_.isRemote(target_slot)
+            ? SimProtocol::buildPacket(hub_id_, EntityType::RadioHub, target_id,
+                                       SimMessageType::HubForward, position_,
+                                       raw_data)
+            : raw_data;
+    egress->send(packet, nodes_.address(target_slot), nodes_.port(target_slot),
+                 link.delay_ms);
+    bump(stats.packets_out);
+    qDebug() << "[RadioHub] Packet delivered from" << source_id << "to"
+             << target_id << "delay" << link.delay_ms << "ms";
 }
 
 double RadioHub::calculateDistance(const QPointF& position_1,
@@ -241,52 +758,548 @@ double RadioHub::calculateDistance(const QPointF& position_1,
     return QLineF(position_1, position_2).length();
 }
 
-bool RadioHub::areWithinCoverageArea(const NodeInfo* source,
-                                     const NodeInfo* target)
+bool RadioHub::areWithinCoverageArea(uint32_t source_slot,
+                                     uint32_t target_slot)
 {
-    const double distance =
-        calculateDistance(source->position, target->position);
+    const EntityType source_type = nodes_.type(source_slot);
+    const EntityType target_type = nodes_.type(target_slot);
+    const uint32_t source_id = nodes_.id(source_slot);
+    const uint32_t target_id = nodes_.id(target_slot);
+
+    if (source_type == EntityType::GNB && target_type == EntityType::UE) {
+        return coverage_.covers(source_id, target_id);
+    }
+
+    if (source_type == EntityType::UE && target_type == EntityType::GNB) {
+        return coverage_.covers(target_id, source_id);
+    }
 
-    if (const auto* gnb = std::get_if<GnbData>(&source->specific_data)) {
-        return distance <= gnb->radius;
+    const double distance = calculateDistance(nodes_.position(source_slot),
+                                              nodes_.position(target_slot));
+
+    if (source_type == EntityType::GNB) {
+        return distance <= nodes_.radius(source_slot);
     }
 
-    if (const auto* gnb = std::get_if<GnbData>(&target->specific_data)) {
-        return distance <= gnb->radius;
+    if (target_type == EntityType::GNB) {
+        return distance <= nodes_.radius(target_slot);
     }
 
     return false;
 }
 
 void RadioHub::updatePosition(const uint32_t& id, const EntityType& type,
-                              const QPointF& position)
+                              const QPointF& position, HubEgress* egress)
 {
-    if (type == EntityType::UE) {
-        auto it = ues_.find(id);
-        if (it != ues_.end()) {
-            it.value().position = position;
+    // Mirrors are positioned by their owning hub only.
+    {
+        QReadLocker locker(&registry_lock_);
+        const uint32_t slot = nodes_.find(id);
+        if (slot == NodeRegistry::NPOS || nodes_.isRemote(slot) ||
+            nodes_.position(slot) == position) {
+            return;
         }
+    }
+
+    QWriteLocker locker(&registry_lock_);
+
+    const uint32_t slot = nodes_.find(id);
+    if (slot == NodeRegistry::NPOS || nodes_.type(slot) != type ||
+        nodes_.isRemote(slot) || nodes_.position(slot) == position) {
+        return;
+    }
+
+    const uint32_t owner = federation_.isEnabled()
+                               ? federation_.ownerIndex(position)
+                               : RegionMap::NONE;
+    if (owner != RegionMap::NONE) {
+        handOff(slot, owner, position, egress);
+        flushLinkReports(egress);
+        return;
+    }
+
+    nodes_.setPosition(slot, position);
+    if (type == EntityType::UE) {
+        ue_grid_.move(id, position);
+        refreshUeCoverage(slot);
     } else if (type == EntityType::GNB) {
-        auto it = gnbs_.find(id);
-        if (it != gnbs_.end()) {
-            it.value().position = position;
+        gnb_radio_.move(id, position.x(), position.y());
+        refreshGnbCoverage(slot);
+    }
+    syncMirrors(slot, egress);
+    flushLinkReports(egress);
+}
+
+uint32_t RadioHub::insertNode(const NodeInfo& node, bool is_remote,
+                              bool shared_endpoint)
+{
+    const uint32_t slot = nodes_.insert(node, is_remote, shared_endpoint);
+    if (liveness_settings_.enabled && !is_remote) {
+        liveness_.track(node.id, nowMs());
+    }
+
+    if (node.type == EntityType::UE) {
+        // A peer sync may refresh an existing mirror in place.
+        if (ue_grid_.contains(node.id)) {
+            ue_grid_.move(node.id, node.position);
+        } else {
+            ue_grid_.insert(node.id, node.position);
+        }
+        refreshUeCoverage(slot);
+    } else if (const GnbData* gnb = nodes_.gnbData(slot)) {
+        gnb_radio_.upsert(node.id, node.position.x(), node.position.y(),
+                          gnb->radius, gnb->tx_power_dbm,
+                          gnb->min_rx_level_dbm);
+        refreshGnbCoverage(slot);
+    }
+    return slot;
+}
+
+bool RadioHub::removeNode(uint32_t id)
+{
+    const uint32_t slot = nodes_.find(id);
+    if (slot == NodeRegistry::NPOS) {
+        return false;
+    }
+
+    if (!nodes_.isRemote(slot)) {
+        shm_router_.detach(nodes_.port(slot));
+    }
+    liveness_.forget(id);
+
+    if (nodes_.type(slot) == EntityType::UE) {
+        ue_grid_.remove(id);
+        coverage_.removeUe(id);
+        pending_rsrp_.remove(id);
+        interference_.removeUe(id);
+    } else {
+        gnb_radio_.remove(id);
+        if (link_budget_.isEnabled()) {
+            for (const uint32_t ue_id : coverage_.uesOf(id).ids) {
+                pending_rsrp_.insert(ue_id);
+            }
+        }
+        coverage_.removeGnb(id);
+        pending_sinr_.erase(id);
+        if (is_interference_enabled_) {
+            affected_ues_.clear();
+            interference_.removeGnb(id, affected_ues_);
+            for (const uint32_t ue_id : affected_ues_) {
+                queueSinrReports(ue_id);
+            }
+        }
+    }
+
+    // The registry fills the freed slot with its last node.
+    const uint32_t last = static_cast<uint32_t>(nodes_.size() - 1);
+    const uint32_t moved_id = nodes_.id(last);
+    nodes_.remove(id);
+    if (moved_id != id && nodes_.type(slot) == EntityType::UE) {
+        coverage_.renumberUe(moved_id, slot);
+    }
+    return true;
+}
+
+PeerNodeRecord RadioHub::peerRecord(uint32_t slot,
+                                    PeerNodeRecord::Op op) const
+{
+    PeerNodeRecord record;
+    record.op = op;
+    record.id = nodes_.id(slot);
+    record.type = nodes_.type(slot);
+    record.position = nodes_.position(slot);
+    record.address = nodes_.address(slot);
+    record.port = nodes_.port(slot);
+    if (const GnbData* gnb = nodes_.gnbData(slot)) {
+        record.radio.radius = gnb->radius;
+        record.radio.tx_power_dbm = gnb->tx_power_dbm;
+        record.radio.min_rx_level =
+            static_cast<int16_t>(gnb->min_rx_level_dbm);
+    }
+    return record;
+}
+
+void RadioHub::sendToPeer(uint32_t region_index, const PeerNodeRecord& record,
+                          HubEgress* egress)
+{
+    const QByteArray packet = SimProtocol::buildPacket(
+        hub_id_, EntityType::RadioHub, hub_id_, SimMessageType::HubSync,
+        position_, HubFederation::encode(record));
+    egress->send(packet, federation_.peerAddress(region_index),
+                 federation_.peerPort(region_index));
+}
+
+void RadioHub::sendRedirect(uint32_t node_id, uint32_t region_index,
+                            bool must_register, const QHostAddress& ip,
+                            quint16 port, HubEgress* egress)
+{
+    const QByteArray packet = SimProtocol::buildPacket(
+        hub_id_, EntityType::RadioHub, node_id, SimMessageType::HubRedirect,
+        position_,
+        SimProtocol::buildHubRedirectPayload(
+            federation_.peerAddress(region_index),
+            federation_.peerPort(region_index), must_register));
+    egress->send(packet, ip, port);
+}
+
+void RadioHub::syncMirrors(uint32_t slot, HubEgress* egress)
+{
+    if (!federation_.isEnabled()) {
+        return;
+    }
+
+    const uint32_t id = nodes_.id(slot);
+    const uint64_t targets = federation_.mirrorTargets(nodes_.position(slot));
+    const uint64_t previous = federation_.exchangeMirrors(id, targets);
+
+    const PeerNodeRecord sync = peerRecord(slot, PeerNodeRecord::Op::Sync);
+    for (uint32_t i = 0; i < RegionMap::MAX_REGIONS; ++i) {
+        if (targets & (uint64_t{1} << i)) {
+            sendToPeer(i, sync, egress);
         }
     }
+    dropMirrorsIn(id, previous & ~targets, egress);
+}
+
+void RadioHub::dropMirrors(uint32_t id, uint32_t except_index,
+                           HubEgress* egress)
+{
+    if (!federation_.isEnabled()) {
+        return;
+    }
+
+    uint64_t peers = federation_.exchangeMirrors(id, 0);
+    if (except_index != RegionMap::NONE) {
+        peers &= ~(uint64_t{1} << except_index);
+    }
+    dropMirrorsIn(id, peers, egress);
 }
 
-void RadioHub::handleDeregistration(uint32_t src_id, EntityType type)
+void RadioHub::dropMirrorsIn(uint32_t id, uint64_t peers, HubEgress* egress)
+{
+    PeerNodeRecord remove;
+    remove.op = PeerNodeRecord::Op::Remove;
+    remove.id = id;
+
+    for (uint32_t i = 0; i < RegionMap::MAX_REGIONS; ++i) {
+        if (peers & (uint64_t{1} << i)) {
+            sendToPeer(i, remove, egress);
+        }
+    }
+}
+
+void RadioHub::handOff(uint32_t slot, uint32_t region_index,
+                       const QPointF& position, HubEgress* egress)
+{
+    PeerNodeRecord record = peerRecord(slot, PeerNodeRecord::Op::Handoff);
+    record.position = position;
+
+    // The new owner mirrors the node back to this hub if it is still near.
+    sendToPeer(region_index, record, egress);
+    dropMirrors(record.id, region_index, egress);
+    removeNode(record.id);
+    sendRedirect(record.id, region_index, false, record.address, record.port,
+                 egress);
+
+    qDebug() << "[RadioHub] Node" << record.id << "handed off to region"
+             << region_index;
+}
+
+void RadioHub::handlePeerSync(const SimProtocol::DecodedPacket& packet,
+                              const QHostAddress& sender_ip,
+                              quint16 sender_port, HubEgress* egress)
+{
+    const uint32_t peer = federation_.isEnabled()
+                              ? federation_.peerIndex(sender_ip, sender_port)
+                              : RegionMap::NONE;
+    const PeerNodeRecord record = HubFederation::decode(packet.payload);
+    if (peer == RegionMap::NONE || !record.isValid) {
+        qWarning() << "[RadioHub] Dropped HubSync from unknown peer"
+                   << sender_ip << sender_port;
+        return;
+    }
+
+    QWriteLocker locker(&registry_lock_);
+
+    const uint32_t slot = nodes_.find(record.id);
+    const bool is_local = slot != NodeRegistry::NPOS && !nodes_.isRemote(slot);
+
+    NodeInfo node;
+    node.id = record.id;
+    node.type = record.type;
+    node.position = record.position;
+    if (record.type == EntityType::GNB) {
+        node.specific_data =
+            GnbData{record.radio.radius, GnbData::INITIAL_UE_COUNT,
+                    record.radio.tx_power_dbm,
+                    static_cast<double>(record.radio.min_rx_level)};
+    } else {
+        node.specific_data = UeData{};
+    }
+
+    switch (record.op) {
+        case PeerNodeRecord::Op::Sync: {
+            if (is_local) {
+                qWarning() << "[RadioHub] Peer mirror of local node"
+                           << record.id << "ignored";
+                return;
+            }
+            node.address = federation_.peerAddress(peer);
+            node.port = federation_.peerPort(peer);
+            insertNode(node, true);
+            break;
+        }
+        case PeerNodeRecord::Op::Remove: {
+            if (slot != NodeRegistry::NPOS && !is_local) {
+                removeNode(record.id);
+            }
+            break;
+        }
+        case PeerNodeRecord::Op::Handoff: {
+            node.address = record.address;
+            node.port = record.port;
+            syncMirrors(insertNode(node, false), egress);
+            qDebug() << "[RadioHub] Took over node" << record.id
+                     << "from region" << peer;
+            break;
+        }
+    }
+    flushLinkReports(egress);
+}
+
+void RadioHub::handleHubForward(const QByteArray& raw_data, uint32_t dst_id,
+                                const QHostAddress& sender_ip,
+                                quint16 sender_port, HubEgress* egress)
+{
+    HubThreadMetrics& stats = metrics_.lane(egress->lane());
+    if (!federation_.isEnabled() ||
+        federation_.peerIndex(sender_ip, sender_port) == RegionMap::NONE) {
+        bump(stats.dropped_invalid);
+        return;
+    }
+
+    QReadLocker locker(&registry_lock_);
+
+    const uint32_t slot = nodes_.find(dst_id);
+    if (slot == NodeRegistry::NPOS || nodes_.isRemote(slot)) {
+        bump(stats.dropped_not_registered);
+        return;
+    }
+
+    // Coverage and link impairment were applied by the sending hub.
+    egress->send(raw_data.mid(SimProtocol::HEADER_SIZE), nodes_.address(slot),
+                 nodes_.port(slot));
+    bump(stats.packets_out);
+}
+
+void RadioHub::refreshUeCoverage(uint32_t ue_slot)
+{
+    QSet<uint32_t> covering_gnbs;
+    const QPointF position = nodes_.position(ue_slot);
+
+    gnb_radio_.forEachAudible(position.x(), position.y(), link_budget_,
+                              [&covering_gnbs](uint32_t gnb_id, double) {
+                                  covering_gnbs.insert(gnb_id);
+                              });
+
+    coverage_.assignUe(nodes_.id(ue_slot), ue_slot, covering_gnbs);
+    queueRsrpReport(ue_slot);
+    refreshUeInterference(ue_slot);
+}
+
+void RadioHub::refreshGnbCoverage(uint32_t gnb_slot)
+{
+    const GnbData* gnb_data = nodes_.gnbData(gnb_slot);
+    if (!gnb_data) {
+        return;
+    }
+    const QPointF position = nodes_.position(gnb_slot);
+
+    candidate_ids_.clear();
+    candidate_xs_.clear();
+    candidate_ys_.clear();
+    ue_grid_.forEachInRadius(position, gnb_data->radius,
+                             [this](uint32_t ue_id, const QPointF& pos) {
+                                 candidate_ids_.push_back(ue_id);
+                                 candidate_xs_.push_back(pos.x());
+                                 candidate_ys_.push_back(pos.y());
+                             });
+
+    candidate_path_loss_.resize(candidate_ids_.size());
+    link_budget_.pathLossBatch(candidate_xs_.data(), candidate_ys_.data(),
+                               candidate_ids_.size(), position.x(),
+                               position.y(), candidate_path_loss_.data());
+
+    QHash<uint32_t, uint32_t> covered_ues;
+    for (size_t i = 0; i < candidate_ids_.size(); ++i) {
+        const double rsrp = gnb_data->tx_power_dbm - candidate_path_loss_[i];
+        if (link_budget_.isAudible(rsrp, gnb_data->min_rx_level_dbm)) {
+            covered_ues.insert(candidate_ids_[i],
+                               nodes_.find(candidate_ids_[i]));
+        }
+    }
+
+    const uint32_t gnb_id = nodes_.id(gnb_slot);
+    if (link_budget_.isEnabled()) {
+        // UEs leaving coverage lose this gNB from their RSRP view too.
+        for (const uint32_t ue_id : coverage_.uesOf(gnb_id).ids) {
+            pending_rsrp_.insert(ue_id);
+        }
+        for (auto it = covered_ues.constBegin(); it != covered_ues.constEnd();
+             ++it) {
+            pending_rsrp_.insert(it.key());
+        }
+    }
+    coverage_.assignGnb(gnb_id, covered_ues);
+    refreshGnbInterference(gnb_slot);
+}
+
+void RadioHub::refreshUeInterference(uint32_t ue_slot)
+{
+    if (!is_interference_enabled_) {
+        return;
+    }
+    const QPointF position = nodes_.position(ue_slot);
+    const uint32_t ue_id = nodes_.id(ue_slot);
+
+    rx_samples_.clear();
+    gnb_radio_.forEachInRange(position.x(), position.y(),
+                              interference_settings_.interference_range_m,
+                              link_budget_,
+                              [this](uint32_t gnb_id, double rx_dbm) {
+                                  rx_samples_.push_back({gnb_id, rx_dbm});
+                              });
+
+    interference_.assignUe(ue_id, rx_samples_);
+    queueSinrReports(ue_id);
+}
+
+void RadioHub::refreshGnbInterference(uint32_t gnb_slot)
+{
+    const GnbData* gnb_data = nodes_.gnbData(gnb_slot);
+    if (!is_interference_enabled_ || !gnb_data) {
+        return;
+    }
+    const QPointF position = nodes_.position(gnb_slot);
+    const double tx_power_dbm = gnb_data->tx_power_dbm;
+
+    rx_samples_.clear();
+    ue_grid_.forEachInRadius(
+        position, interference_settings_.interference_range_m,
+        [&](uint32_t ue_id, const QPointF& pos) {
+            const double distance = QLineF(position, pos).length();
+            rx_samples_.push_back(
+                {ue_id, tx_power_dbm - link_budget_.pathLossDb(distance)});
+        });
+
+    affected_ues_.clear();
+    interference_.assignGnb(nodes_.id(gnb_slot), rx_samples_, affected_ues_);
+    for (const uint32_t ue_id : affected_ues_) {
+        queueSinrReports(ue_id);
+    }
+}
+
+void RadioHub::queueSinrReports(uint32_t ue_id)
+{
+    // Only the serving candidates of a UE hear about its SINR; mirrored
+    // gNBs get theirs from the owning hub.
+    for (const uint32_t gnb_id : coverage_.gnbsOf(ue_id)) {
+        const uint32_t gnb_slot = nodes_.find(gnb_id);
+        if (gnb_slot == NodeRegistry::NPOS || nodes_.isRemote(gnb_slot)) {
+            continue;
+        }
+        const double sinr_db = interference_.sinrDb(ue_id, gnb_id);
+        if (!std::isnan(sinr_db) &&
+            interference_.shouldReport(
+                ue_id, gnb_id, sinr_db,
+                interference_settings_.report_threshold_db)) {
+            pending_sinr_[gnb_id].push_back({ue_id, sinr_db});
+        }
+    }
+}
+
+void RadioHub::flushSinrReports(HubEgress* egress)
+{
+    for (auto& [gnb_id, samples] : pending_sinr_) {
+        const uint32_t slot = nodes_.find(gnb_id);
+        if (samples.empty() || slot == NodeRegistry::NPOS) {
+            continue;
+        }
+        egress->send(SimProtocol::buildPacket(
+                         hub_id_, EntityType::RadioHub, gnb_id,
+                         SimMessageType::SinrReport, position_,
+                         SimProtocol::buildSinrReportPayload(samples)),
+                     nodes_.address(slot), nodes_.port(slot));
+        bump(metrics_.lane(egress->lane()).packets_out);
+        samples.clear();
+    }
+}
+
+void RadioHub::queueRsrpReport(uint32_t ue_slot)
+{
+    // Without a path loss model there is no RSRP to report.
+    if (link_budget_.isEnabled() && !nodes_.isRemote(ue_slot)) {
+        pending_rsrp_.insert(nodes_.id(ue_slot));
+    }
+}
+
+void RadioHub::flushRsrpReports(HubEgress* egress)
+{
+    for (const uint32_t ue_id : std::as_const(pending_rsrp_)) {
+        const uint32_t slot = nodes_.find(ue_id);
+        if (slot == NodeRegistry::NPOS || nodes_.isRemote(slot)) {
+            continue;
+        }
+        const QPointF position = nodes_.position(slot);
+        rsrp_samples_.clear();
+        gnb_radio_.forEachAudible(position.x(), position.y(), link_budget_,
+                                  [this](uint32_t gnb_id, double rsrp) {
+                                      rsrp_samples_.push_back({gnb_id, rsrp});
+                                  });
+        egress->send(SimProtocol::buildPacket(
+                         hub_id_, EntityType::RadioHub, ue_id,
+                         SimMessageType::RsrpReport, position_,
+                         SimProtocol::buildRsrpReportPayload(rsrp_samples_)),
+                     nodes_.address(slot), nodes_.port(slot));
+        bump(metrics_.lane(egress->lane()).packets_out);
+    }
+    pending_rsrp_.clear();
+}
+
+void RadioHub::flushLinkReports(HubEgress* egress)
+{
+    flushSinrReports(egress);
+    flushRsrpReports(egress);
+}
+
+QHash<uint32_t, double> RadioHub::ueSinrSnapshot() const
+{
+    QHash<uint32_t, double> snapshot;
+    QReadLocker locker(&registry_lock_);
+    interference_.forEachUe([&snapshot](uint32_t ue_id, double sinr_db) {
+        snapshot.insert(ue_id, sinr_db);
+    });
+    return snapshot;
+}
+
+void RadioHub::handleDeregistration(uint32_t src_id, EntityType type,
+                                    HubEgress* egress)
 {
     bool removed = false;
     QString typeStr;
+    QWriteLocker locker(&registry_lock_);
+
+    const uint32_t slot = nodes_.find(src_id);
+    const bool is_registered = slot != NodeRegistry::NPOS &&
+                               nodes_.type(slot) == type &&
+                               !nodes_.isRemote(slot);
 
     switch (type) {
         case EntityType::UE:
-            removed = (ues_.remove(src_id) > 0);
             typeStr = "UE";
             break;
 
         case EntityType::GNB:
-            removed = (gnbs_.remove(src_id) > 0);
             typeStr = "gNB";
             break;
 
@@ -297,6 +1310,12 @@ void RadioHub::handleDeregistration(uint32_t src_id, EntityType type)
             return;
     }
 
+    if (is_registered) {
+        dropMirrors(src_id, RegionMap::NONE, egress);
+        removed = removeNode(src_id);
+        flushLinkReports(egress);
+    }
+
     if (removed) {
         qDebug() << QString(
                         "[RadioHub] %1 %2 successfully deregistered and "
@@ -17,9 +17,18 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
-    const auto set = ConfigManager::instance().getHubSettings();
+    auto set = ConfigManager::instance().getHubSettings();
+    if (set.federation.enabled) {
+        set.federation.region_id = ConfigManager::instance().getId();
+    }
 
     auto radio_hub = std::make_unique<RadioHub>(set);
+    QObject::connect(radio_hub.get(), &RadioHub::replayFinished, &a,
+                     &QCoreApplication::quit, Qt::QueuedConnection);
+
+    if (!radio_hub->run()) {
+        return EXIT_FAILURE;
+    }
 
     return a.exec();
 }
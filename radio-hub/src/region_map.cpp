@@ -0,0 +1,61 @@
+#include "region_map.hpp"
+
+#include <algorithm>
+#include <utility>
+
+RegionMap::RegionMap(std::vector<HubRegion> regions)
+    : regions_(std::move(regions))
+{
+    if (regions_.size() > MAX_REGIONS) {
+        regions_.resize(MAX_REGIONS);
+    }
+}
+
+size_t RegionMap::size() const
+{
+    return regions_.size();
+}
+
+const HubRegion& RegionMap::region(uint32_t index) const
+{
+    return regions_[index];
+}
+
+uint32_t RegionMap::indexOf(uint32_t region_id) const
+{
+    for (uint32_t i = 0; i < regions_.size(); ++i) {
+        if (regions_[i].id == region_id) {
+            return i;
+        }
+    }
+    return NONE;
+}
+
+uint32_t RegionMap::indexAt(double x, double y) const
+{
+    for (uint32_t i = 0; i < regions_.size(); ++i) {
+        const HubRegion& r = regions_[i];
+        if (x >= r.min_x && x < r.max_x && y >= r.min_y && y < r.max_y) {
+            return i;
+        }
+    }
+    return NONE;
+}
+
+uint64_t RegionMap::regionsNear(double x, double y, double margin,
+                                uint32_t except_index) const
+{
+    uint64_t mask = 0;
+    for (uint32_t i = 0; i < regions_.size(); ++i) {
+        if (i == except_index) {
+            continue;
+        }
+        const HubRegion& r = regions_[i];
+        const double dx = std::max({r.min_x - x, 0.0, x - r.max_x});
+        const double dy = std::max({r.min_y - y, 0.0, y - r.max_y});
+        if (dx * dx + dy * dy <= margin * margin) {
+            mask |= uint64_t{1} << i;
+        }
+    }
+    return mask;
+}
@@ -0,0 +1,68 @@
+#include "shm_router.hpp"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+ShmRouter::ShmRouter(const ShmTransportSettings& settings)
+    : is_enabled_(settings.enabled)
+{
+}
+
+bool ShmRouter::isEnabled() const
+{
+    return is_enabled_;
+}
+
+ShmChannel* ShmRouter::attach(quint16 node_port, const QString& name,
+                              QObject* owner)
+{
+    if (!is_enabled_) {
+        return nullptr;
+    }
+
+    std::unique_ptr<ShmChannel> channel = ShmChannel::attach(name);
+    if (!channel) {
+        return nullptr;
+    }
+    channel->setParent(owner);
+
+    QWriteLocker locker(&lock_);
+    ShmChannel*& slot = channels_[node_port];
+    if (slot) {
+        slot->deleteLater();
+    }
+    slot = channel.release();
+    return slot;
+}
+
+void ShmRouter::detach(quint16 node_port)
+{
+    QWriteLocker locker(&lock_);
+
+    const auto it = channels_.find(node_port);
+    if (it == channels_.end()) {
+        return;
+    }
+    // Deleted in the owning thread once its current drain has finished.
+    it->second->deleteLater();
+    channels_.erase(it);
+}
+
+bool ShmRouter::send(const QHostAddress& address, quint16 port,
+                     const QByteArray& data) const
+{
+    if (!is_enabled_ || !address.isLoopback()) {
+        return false;
+    }
+
+    QReadLocker locker(&lock_);
+
+    const auto it = channels_.find(port);
+    return it != channels_.end() && it->second->send(data);
+}
+
+size_t ShmRouter::size() const
+{
+    QReadLocker locker(&lock_);
+    return channels_.size();
+}
@@ -0,0 +1,247 @@
+#include "signaling_capture.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t BLOCK_SECTION_HEADER = 0x0A0D0D0A;
+constexpr uint32_t BLOCK_INTERFACE_DESCRIPTION = 0x00000001;
+constexpr uint32_t BLOCK_INTERFACE_STATISTICS = 0x00000005;
+constexpr uint32_t BLOCK_ENHANCED_PACKET = 0x00000006;
+constexpr uint32_t BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+constexpr uint16_t OPT_END = 0;
+constexpr uint16_t OPT_COMMENT = 1;
+constexpr uint16_t OPT_IF_NAME = 2;
+constexpr uint16_t OPT_IF_TSRESOL = 9;
+constexpr uint16_t OPT_ISB_IFDROP = 5;
+
+// Nanosecond timestamps.
+constexpr uint8_t TSRESOL_NS = 9;
+constexpr auto IDLE_SLEEP = std::chrono::milliseconds(1);
+
+template <typename T>
+void put(std::vector<char>& out, T value)
+{
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void pad(std::vector<char>& out)
+{
+    out.resize((out.size() + 3) & ~size_t{3}, 0);
+}
+
+void putOption(std::vector<char>& out, uint16_t code, const void* data,
+               size_t size)
+{
+    put<uint16_t>(out, code);
+    put<uint16_t>(out, static_cast<uint16_t>(size));
+    const char* bytes = static_cast<const char*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+    pad(out);
+}
+
+void putEndOfOptions(std::vector<char>& out)
+{
+    put<uint16_t>(out, OPT_END);
+    put<uint16_t>(out, 0);
+}
+
+uint64_t wallClockNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+}
+
+}  // namespace
+
+SignalingCapture::SignalingCapture(const CaptureSettings& settings,
+                                   uint32_t lane_count)
+    : path_(settings.path)
+{
+    for (uint32_t i = 0; i < std::max(lane_count, 1u); ++i) {
+        lanes_.push_back(std::make_unique<Lane>(settings.ring_capacity));
+    }
+}
+
+SignalingCapture::~SignalingCapture()
+{
+    stop();
+}
+
+bool SignalingCapture::start()
+{
+    if (is_running_) {
+        return true;
+    }
+
+    file_ = std::fopen(path_.c_str(), "wb");
+    if (!file_) {
+        return false;
+    }
+
+    writeSectionHeader();
+    for (uint32_t lane = 0; lane < lanes_.size(); ++lane) {
+        writeInterfaceDescription(lane);
+    }
+
+    is_running_ = true;
+    writer_ = std::thread(&SignalingCapture::writerLoop, this);
+    return true;
+}
+
+void SignalingCapture::stop()
+{
+    if (!is_running_.exchange(false)) {
+        return;
+    }
+    writer_.join();
+
+    drainLanes();
+    for (uint32_t lane = 0; lane < lanes_.size(); ++lane) {
+        writeInterfaceStatistics(lane);
+    }
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+void SignalingCapture::record(uint32_t lane, const char* data, size_t size,
+                              uint32_t src_id, uint32_t dst_id,
+                              uint8_t msg_type)
+{
+    Lane& target = *lanes_[lane % lanes_.size()];
+    const uint64_t timestamp_ns = wallClockNs();
+
+    const bool is_queued = target.ring.tryPush([&](CaptureRecord& record) {
+        record.timestamp_ns = timestamp_ns;
+        record.src_id = src_id;
+        record.dst_id = dst_id;
+        record.msg_type = msg_type;
+        record.original_length = static_cast<uint32_t>(size);
+        record.captured_length = static_cast<uint32_t>(
+            std::min(size, CaptureRecord::SNAP_LENGTH));
+        std::memcpy(record.data.data(), data, record.captured_length);
+    });
+
+    if (!is_queued) {
+        target.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+const std::string& SignalingCapture::path() const
+{
+    return path_;
+}
+
+uint64_t SignalingCapture::written() const
+{
+    return written_.load(std::memory_order_relaxed);
+}
+
+uint64_t SignalingCapture::dropped() const
+{
+    uint64_t total = 0;
+    for (const auto& lane : lanes_) {
+        total += lane->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void SignalingCapture::writerLoop()
+{
+    while (is_running_.load(std::memory_order_acquire)) {
+        if (drainLanes() == 0) {
+            std::fflush(file_);
+            std::this_thread::sleep_for(IDLE_SLEEP);
+        }
+    }
+}
+
+size_t SignalingCapture::drainLanes()
+{
+    size_t total = 0;
+    for (uint32_t lane = 0; lane < lanes_.size(); ++lane) {
+        total += lanes_[lane]->ring.drain(
+            [this, lane](const CaptureRecord& record) {
+                writePacket(lane, record);
+            });
+    }
+    written_.fetch_add(total, std::memory_order_relaxed);
+    return total;
+}
+
+void SignalingCapture::writeBlock(uint32_t type, const std::vector<char>& body)
+{
+    // Type, total length, body, total length again.
+    const uint32_t total_length = static_cast<uint32_t>(body.size() + 12);
+    std::fwrite(&type, sizeof(type), 1, file_);
+    std::fwrite(&total_length, sizeof(total_length), 1, file_);
+    std::fwrite(body.data(), 1, body.size(), file_);
+    std::fwrite(&total_length, sizeof(total_length), 1, file_);
+}
+
+void SignalingCapture::writeSectionHeader()
+{
+    block_.clear();
+    put<uint32_t>(block_, BYTE_ORDER_MAGIC);
+    put<uint16_t>(block_, 1);   // major version
+    put<uint16_t>(block_, 0);   // minor version
+    put<int64_t>(block_, -1);   // section length not known
+    writeBlock(BLOCK_SECTION_HEADER, block_);
+}
+
+void SignalingCapture::writeInterfaceDescription(uint32_t lane)
+{
+    const std::string name = "radiohub-lane-" + std::to_string(lane);
+
+    block_.clear();
+    put<uint16_t>(block_, LINKTYPE_USER0);
+    put<uint16_t>(block_, 0);
+    put<uint32_t>(block_, CaptureRecord::SNAP_LENGTH);
+    putOption(block_, OPT_IF_NAME, name.data(), name.size());
+    putOption(block_, OPT_IF_TSRESOL, &TSRESOL_NS, sizeof(TSRESOL_NS));
+    putEndOfOptions(block_);
+    writeBlock(BLOCK_INTERFACE_DESCRIPTION, block_);
+}
+
+void SignalingCapture::writePacket(uint32_t lane, const CaptureRecord& record)
+{
+    char comment[64];
+    const int comment_length =
+        std::snprintf(comment, sizeof(comment), "src=%u dst=%u type=%u",
+                      record.src_id, record.dst_id, record.msg_type);
+
+    block_.clear();
+    put<uint32_t>(block_, lane);
+    put<uint32_t>(block_, static_cast<uint32_t>(record.timestamp_ns >> 32));
+    put<uint32_t>(block_, static_cast<uint32_t>(record.timestamp_ns));
+    put<uint32_t>(block_, record.captured_length);
+    put<uint32_t>(block_, record.original_length);
+    block_.insert(block_.end(), record.data.data(),
+                  record.data.data() + record.captured_length);
+    pad(block_);
+    putOption(block_, OPT_COMMENT, comment,
+              static_cast<size_t>(std::max(comment_length, 0)));
+    putEndOfOptions(block_);
+    writeBlock(BLOCK_ENHANCED_PACKET, block_);
+}
+
+void SignalingCapture::writeInterfaceStatistics(uint32_t lane)
+{
+    const uint64_t timestamp_ns = wallClockNs();
+    const uint64_t dropped =
+        lanes_[lane]->dropped.load(std::memory_order_relaxed);
+
+    block_.clear();
+    put<uint32_t>(block_, lane);
+    put<uint32_t>(block_, static_cast<uint32_t>(timestamp_ns >> 32));
+    put<uint32_t>(block_, static_cast<uint32_t>(timestamp_ns));
+    putOption(block_, OPT_ISB_IFDROP, &dropped, sizeof(dropped));
+    putEndOfOptions(block_);
+    writeBlock(BLOCK_INTERFACE_STATISTICS, block_);
+}
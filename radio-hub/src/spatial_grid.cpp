@@ -0,0 +1,108 @@
+#include "spatial_grid.hpp"
+
+#include <cmath>
+
+SpatialGrid::SpatialGrid(double cell_size)
+    : cell_size_(cell_size > 0.0 ? cell_size : DEFAULT_CELL_SIZE)
+{
+}
+
+void SpatialGrid::insert(uint32_t id, const QPointF& position)
+{
+    if (slots_.count(id)) {
+        move(id, position);
+        return;
+    }
+
+    const CellKey key = keyFor(position);
+    auto& items = cells_[key];
+    items.push_back({id, position.x(), position.y()});
+    slots_[id] = {key, items.size() - 1};
+}
+
+void SpatialGrid::move(uint32_t id, const QPointF& position)
+{
+    auto it = slots_.find(id);
+    if (it == slots_.end()) {
+        insert(id, position);
+        return;
+    }
+
+    const CellKey key = keyFor(position);
+    Slot& slot = it->second;
+
+    if (slot.cell == key) {
+        Item& item = cells_[key][slot.index];
+        item.x = position.x();
+        item.y = position.y();
+        return;
+    }
+
+    detach(slot);
+
+    auto& items = cells_[key];
+    items.push_back({id, position.x(), position.y()});
+    slot = {key, items.size() - 1};
+}
+
+bool SpatialGrid::remove(uint32_t id)
+{
+    auto it = slots_.find(id);
+    if (it == slots_.end()) {
+        return false;
+    }
+
+    detach(it->second);
+    slots_.erase(it);
+    return true;
+}
+
+bool SpatialGrid::contains(uint32_t id) const
+{
+    return slots_.count(id) > 0;
+}
+
+size_t SpatialGrid::size() const
+{
+    return slots_.size();
+}
+
+double SpatialGrid::cellSize() const
+{
+    return cell_size_;
+}
+
+int32_t SpatialGrid::cellCoord(double value) const
+{
+    return static_cast<int32_t>(std::floor(value / cell_size_));
+}
+
+SpatialGrid::CellKey SpatialGrid::keyFor(const QPointF& position) const
+{
+    return makeKey(cellCoord(position.x()), cellCoord(position.y()));
+}
+
+SpatialGrid::CellKey SpatialGrid::makeKey(int32_t cx, int32_t cy)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+           static_cast<uint32_t>(cy);
+}
+
+void SpatialGrid::detach(const Slot& slot)
+{
+    auto cell = cells_.find(slot.cell);
+    if (cell == cells_.end()) {
+        return;
+    }
+
+    auto& items = cell->second;
+    if (slot.index != items.size() - 1) {
+        items[slot.index] = items.back();
+        slots_[items[slot.index].id].index = slot.index;
+    }
+    items.pop_back();
+
+    if (items.empty()) {
+        cells_.erase(cell);
+    }
+}
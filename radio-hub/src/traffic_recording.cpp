@@ -0,0 +1,181 @@
+#include "traffic_recording.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Keeps the file buffered in large chunks; records are small.
+constexpr size_t FILE_BUFFER_SIZE = 1 << 20;
+
+void putVarint(std::vector<char>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+template <typename T>
+void putLittleEndian(std::vector<char>& out, T value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+template <typename T>
+T getLittleEndian(const unsigned char* bytes)
+{
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+}  // namespace
+
+TrafficRecorder::TrafficRecorder(std::string path)
+    : path_(std::move(path))
+{
+}
+
+TrafficRecorder::~TrafficRecorder()
+{
+    close();
+}
+
+bool TrafficRecorder::open()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        return true;
+    }
+
+    file_ = std::fopen(path_.c_str(), "wb");
+    if (!file_) {
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, FILE_BUFFER_SIZE);
+
+    buffer_.clear();
+    putLittleEndian<uint32_t>(buffer_, TrafficFormat::MAGIC);
+    putLittleEndian<uint16_t>(buffer_, TrafficFormat::VERSION);
+    putLittleEndian<uint16_t>(buffer_, 0);
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    return true;
+}
+
+void TrafficRecorder::close()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+void TrafficRecorder::record(uint64_t arrival_us, uint32_t ipv4,
+                             uint16_t port, const char* data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || size > TrafficFormat::MAX_DATAGRAM) {
+        return;
+    }
+
+    arrival_us = std::max(arrival_us, last_arrival_us_);
+    buffer_.clear();
+    putVarint(buffer_, arrival_us - last_arrival_us_);
+    putLittleEndian<uint32_t>(buffer_, ipv4);
+    putLittleEndian<uint16_t>(buffer_, port);
+    putVarint(buffer_, size);
+    buffer_.insert(buffer_.end(), data, data + size);
+
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    last_arrival_us_ = arrival_us;
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+}
+
+const std::string& TrafficRecorder::path() const
+{
+    return path_;
+}
+
+uint64_t TrafficRecorder::recorded() const
+{
+    return recorded_.load(std::memory_order_relaxed);
+}
+
+TrafficReader::TrafficReader(std::string path)
+    : path_(std::move(path))
+{
+}
+
+TrafficReader::~TrafficReader()
+{
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+bool TrafficReader::open()
+{
+    file_ = std::fopen(path_.c_str(), "rb");
+    if (!file_) {
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, FILE_BUFFER_SIZE);
+
+    unsigned char header[TrafficFormat::HEADER_SIZE];
+    if (std::fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        getLittleEndian<uint32_t>(header) != TrafficFormat::MAGIC ||
+        getLittleEndian<uint16_t>(header + 4) != TrafficFormat::VERSION) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    arrival_us_ = 0;
+    return true;
+}
+
+bool TrafficReader::next(TrafficRecord& record)
+{
+    uint64_t delta_us = 0;
+    uint64_t length = 0;
+    unsigned char endpoint[6];
+    if (!file_ || !readVarint(delta_us) ||
+        std::fread(endpoint, 1, sizeof(endpoint), file_) != sizeof(endpoint) ||
+        !readVarint(length) || length > TrafficFormat::MAX_DATAGRAM) {
+        return false;
+    }
+
+    record.data.resize(static_cast<size_t>(length));
+    if (std::fread(record.data.data(), 1, record.data.size(), file_) !=
+        record.data.size()) {
+        return false;
+    }
+
+    arrival_us_ += delta_us;
+    record.arrival_us = arrival_us_;
+    record.ipv4 = getLittleEndian<uint32_t>(endpoint);
+    record.port = getLittleEndian<uint16_t>(endpoint + 4);
+    return true;
+}
+
+bool TrafficReader::readVarint(uint64_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+        const int byte = std::fgetc(file_);
+        if (byte == EOF) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,80 @@
+#include "traffic_replayer.hpp"
+
+#include <utility>
+
+#include <QTimer>
+
+TrafficReplayer::TrafficReplayer(std::string path, double speed,
+                                 Deliver deliver, QObject* parent)
+    : QObject(parent)
+    , reader_(std::move(path))
+    , speed_(speed > 0.0 ? speed : 0.0)
+    , deliver_(std::move(deliver))
+    , timer_(new QTimer(this))
+{
+    timer_->setSingleShot(true);
+    timer_->setTimerType(Qt::PreciseTimer);
+    connect(timer_, &QTimer::timeout, this, &TrafficReplayer::onTimer);
+}
+
+bool TrafficReplayer::start()
+{
+    if (!reader_.open()) {
+        return false;
+    }
+
+    has_next_ = reader_.next(next_);
+    first_arrival_us_ = has_next_ ? next_.arrival_us : 0;
+    clock_.start();
+    scheduleNext();
+    return true;
+}
+
+uint64_t TrafficReplayer::replayed() const
+{
+    return replayed_;
+}
+
+qint64 TrafficReplayer::elapsedMs() const
+{
+    return clock_.elapsed();
+}
+
+void TrafficReplayer::onTimer()
+{
+    const double replay_us =
+        static_cast<double>(clock_.nsecsElapsed()) / 1000.0 * speed_;
+
+    for (uint32_t batch = 0; has_next_ && batch < MAX_BATCH; ++batch) {
+        const uint64_t offset_us = next_.arrival_us - first_arrival_us_;
+        if (speed_ > 0.0 && static_cast<double>(offset_us) > replay_us) {
+            break;
+        }
+        deliver_(QByteArray(next_.data.data(),
+                            static_cast<int>(next_.data.size())),
+                 QHostAddress(next_.ipv4), next_.port);
+        ++replayed_;
+        has_next_ = reader_.next(next_);
+    }
+
+    scheduleNext();
+}
+
+void TrafficReplayer::scheduleNext()
+{
+    if (!has_next_) {
+        emit finished();
+        return;
+    }
+    if (speed_ == 0.0) {
+        timer_->start(0);
+        return;
+    }
+
+    const double due_ms =
+        static_cast<double>(next_.arrival_us - first_arrival_us_) / 1000.0 /
+        speed_;
+    const double wait_ms =
+        due_ms - static_cast<double>(clock_.nsecsElapsed()) / 1e6;
+    timer_->start(wait_ms > 0.0 ? static_cast<int>(wait_ms) : 0);
+}
@@ -0,0 +1,78 @@
+#include "coverage_table.hpp"
+
+#include <gtest/gtest.h>
+
+class CoverageTableTest : public ::testing::Test
+{
+protected:
+    const uint32_t GNB_A = 101;
+    const uint32_t GNB_B = 102;
+    const uint32_t UE_1 = 501;
+    const uint32_t UE_2 = 502;
+    const uint32_t SLOT_1 = 3;
+    const uint32_t SLOT_2 = 4;
+
+    QSet<uint32_t> idsOf(uint32_t gnb_id) const
+    {
+        const CoveredUes& ues = table.uesOf(gnb_id);
+        return QSet<uint32_t>(ues.ids.begin(), ues.ids.end());
+    }
+
+    uint32_t slotOf(uint32_t gnb_id, uint32_t ue_id) const
+    {
+        const CoveredUes& ues = table.uesOf(gnb_id);
+        return ues.slots[ues.positions.value(ue_id)];
+    }
+
+    CoverageTable table;
+};
+
+TEST_F(CoverageTableTest, AssignGnbIsVisibleFromBothSides)
+{
+    table.assignGnb(GNB_A, {{UE_1, SLOT_1}, {UE_2, SLOT_2}});
+
+    EXPECT_TRUE(table.covers(GNB_A, UE_1));
+    EXPECT_TRUE(table.covers(GNB_A, UE_2));
+    EXPECT_EQ(table.gnbsOf(UE_1), QSet<uint32_t>({GNB_A}));
+    EXPECT_EQ(slotOf(GNB_A, UE_2), SLOT_2);
+}
+
+TEST_F(CoverageTableTest, UeMoveReplacesItsGnbSet)
+{
+    table.assignGnb(GNB_A, {{UE_1, SLOT_1}});
+    table.assignGnb(GNB_B, {});
+
+    table.assignUe(UE_1, SLOT_1, {GNB_B});
+
+    EXPECT_FALSE(table.covers(GNB_A, UE_1));
+    EXPECT_TRUE(table.covers(GNB_B, UE_1));
+    EXPECT_TRUE(table.uesOf(GNB_A).isEmpty());
+    EXPECT_EQ(slotOf(GNB_B, UE_1), SLOT_1);
+}
+
+TEST_F(CoverageTableTest, RemovingNodesCleansReverseMap)
+{
+    table.assignGnb(GNB_A, {{UE_1, SLOT_1}, {UE_2, SLOT_2}});
+    table.assignGnb(GNB_B, {{UE_1, SLOT_1}});
+
+    table.removeUe(UE_1);
+    EXPECT_EQ(idsOf(GNB_A), QSet<uint32_t>({UE_2}));
+    EXPECT_EQ(slotOf(GNB_A, UE_2), SLOT_2);
+    EXPECT_TRUE(table.uesOf(GNB_B).isEmpty());
+
+    table.removeGnb(GNB_A);
+    EXPECT_TRUE(table.gnbsOf(UE_2).isEmpty());
+    EXPECT_FALSE(table.covers(GNB_A, UE_2));
+}
+
+TEST_F(CoverageTableTest, RenumberedUeKeepsCoverage)
+{
+    table.assignGnb(GNB_A, {{UE_1, SLOT_1}, {UE_2, SLOT_2}});
+    table.assignGnb(GNB_B, {{UE_2, SLOT_2}});
+
+    table.renumberUe(UE_2, SLOT_1);
+
+    EXPECT_EQ(slotOf(GNB_A, UE_2), SLOT_1);
+    EXPECT_EQ(slotOf(GNB_B, UE_2), SLOT_1);
+    EXPECT_EQ(slotOf(GNB_A, UE_1), SLOT_1);
+}
@@ -0,0 +1,51 @@
+#include "hub_egress.hpp"
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QSignalSpy>
+
+#include "hub_metrics.hpp"
+#include "liveness_tracker.hpp"
+#include "udp_transport.hpp"
+
+namespace {
+
+constexpr quint16 NODE_PORT = 47000;
+const QHostAddress NODE_ADDRESS(QHostAddress::LocalHost);
+
+}  // namespace
+
+TEST(HubEgressTest, DatagramOnAnyWorkerLiftsTheQuarantine)
+{
+    SendQuarantine quarantine(2, 60000);
+    HubThreadMetrics stats_a;
+    HubThreadMetrics stats_b;
+    UdpTransport transport_a(nullptr, UdpBackend::InProcess);
+    UdpTransport transport_b(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(transport_a.init(0));
+    ASSERT_TRUE(transport_b.init(0));
+    HubEgress worker_a(&transport_a, 0);
+    HubEgress worker_b(&transport_b, 1);
+    worker_a.enableQuarantine(&quarantine, &stats_a);
+    worker_b.enableQuarantine(&quarantine, &stats_b);
+
+    // The node is not up yet: worker A's sends fail and quarantine it.
+    worker_a.send("sib1", NODE_ADDRESS, NODE_PORT);
+    worker_a.send("sib1", NODE_ADDRESS, NODE_PORT);
+    EXPECT_EQ(stats_a.send_errors.load(), 2u);
+
+    UdpTransport node(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(node.init(NODE_PORT));
+    QSignalSpy node_spy(&node, &UdpTransport::dataReceived);
+    worker_b.send("sib1", NODE_ADDRESS, NODE_PORT);
+    EXPECT_EQ(stats_b.dropped_quarantined.load(), 1u);
+
+    // Its datagrams reach worker B only; worker A must send again.
+    worker_b.noteHeardFrom(NODE_ADDRESS, NODE_PORT);
+    worker_a.send("sib1", NODE_ADDRESS, NODE_PORT);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(node_spy.count(), 1);
+    EXPECT_EQ(stats_a.dropped_quarantined.load(), 0u);
+    EXPECT_EQ(quarantine.size(), 0u);
+}
@@ -0,0 +1,64 @@
+#include "hub_metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "types.hpp"
+
+TEST(LogHistogramTest, SmallValuesHaveExactBuckets)
+{
+    for (uint64_t value = 0; value < LogHistogram::SUB_BUCKETS; ++value) {
+        EXPECT_EQ(LogHistogram::bucketOf(value), value);
+        EXPECT_EQ(LogHistogram::bucketUpperBound(value), value);
+    }
+}
+
+TEST(LogHistogramTest, BucketBoundsContainValueWithinRelativeError)
+{
+    for (uint64_t value = 1; value < (uint64_t{1} << 30);
+         value = value * 3 + 1) {
+        const size_t bucket = LogHistogram::bucketOf(value);
+        const uint64_t upper = LogHistogram::bucketUpperBound(bucket);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value) / value,
+                  1.0 / LogHistogram::SUB_BUCKETS);
+        if (bucket > 0) {
+            EXPECT_LT(LogHistogram::bucketUpperBound(bucket - 1), value);
+        }
+    }
+}
+
+TEST(LogHistogramTest, OutOfRangeValuesAreClampedToLastBucket)
+{
+    EXPECT_EQ(LogHistogram::bucketOf(UINT64_MAX),
+              LogHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(HubMetricsTest, RendersSumsOverAllLanes)
+{
+    HubMetrics metrics(2);
+    bump(metrics.lane(0).packets_in, 3);
+    bump(metrics.lane(1).packets_in, 4);
+    bump(metrics.lane(1).dropped_out_of_coverage);
+    bump(metrics.lane(0).sim_msg_types[static_cast<uint8_t>(
+        SimMessageType::Data)]);
+    bump(metrics.lane(0).protocol_msg_types[static_cast<uint8_t>(
+        ProtocolMsgType::Sib1)]);
+    metrics.lane(0).processing_ns.record(1500);
+    metrics.lane(1).broadcast_fanout.record(12);
+
+    const std::string text = metrics.renderPrometheus();
+
+    EXPECT_NE(text.find("radiohub_packets_in_total 7\n"), std::string::npos);
+    EXPECT_NE(text.find("radiohub_dropped_total{reason=\"out_of_coverage\"} 1"),
+              std::string::npos);
+    EXPECT_NE(text.find("radiohub_sim_messages_total{type=\"data\"} 1"),
+              std::string::npos);
+    EXPECT_NE(text.find("radiohub_protocol_messages_total{type=\"sib1\"} 1"),
+              std::string::npos);
+    EXPECT_NE(text.find("radiohub_processing_seconds_count 1\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("radiohub_broadcast_fanout_bucket{le=\"15\"} 1"),
+              std::string::npos);
+}
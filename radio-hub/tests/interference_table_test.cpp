@@ -0,0 +1,75 @@
+#include "interference_table.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+class InterferenceTableTest : public ::testing::Test
+{
+protected:
+    const uint32_t GNB_A = 101;
+    const uint32_t GNB_B = 102;
+    const uint32_t UE_1 = 501;
+    const uint32_t UE_2 = 502;
+
+    // Noise far below the signals keeps the expected values simple.
+    InterferenceTable table{-200.0};
+};
+
+TEST_F(InterferenceTableTest, SingleGnbIsLimitedByNoiseOnly)
+{
+    InterferenceTable noisy(-100.0);
+    noisy.assignUe(UE_1, {{GNB_A, -80.0}});
+
+    EXPECT_NEAR(noisy.sinrDb(UE_1, GNB_A), 20.0, 1e-9);
+    EXPECT_TRUE(std::isnan(noisy.sinrDb(UE_1, GNB_B)));
+    EXPECT_TRUE(std::isnan(noisy.bestSinrDb(UE_2)));
+}
+
+TEST_F(InterferenceTableTest, OverlappingCellsInterfere)
+{
+    table.assignUe(UE_1, {{GNB_A, -70.0}, {GNB_B, -80.0}});
+
+    EXPECT_NEAR(table.sinrDb(UE_1, GNB_A), 10.0, 1e-6);
+    EXPECT_NEAR(table.sinrDb(UE_1, GNB_B), -10.0, 1e-6);
+    EXPECT_NEAR(table.bestSinrDb(UE_1), 10.0, 1e-6);
+}
+
+TEST_F(InterferenceTableTest, GnbMoveTouchesOnlyUesInRange)
+{
+    table.assignUe(UE_1, {{GNB_A, -70.0}});
+    table.assignUe(UE_2, {{GNB_A, -70.0}, {GNB_B, -70.0}});
+
+    std::vector<uint32_t> affected;
+    table.assignGnb(GNB_B, {{UE_1, -80.0}}, affected);
+
+    EXPECT_EQ(affected, (std::vector<uint32_t>{UE_1, UE_2}));
+    EXPECT_NEAR(table.sinrDb(UE_1, GNB_A), 10.0, 1e-6);
+    EXPECT_NEAR(table.sinrDb(UE_2, GNB_A), 130.0, 1e-6);
+}
+
+TEST_F(InterferenceTableTest, RemovedGnbStopsInterfering)
+{
+    table.assignUe(UE_1, {{GNB_A, -70.0}, {GNB_B, -70.0}});
+    EXPECT_NEAR(table.sinrDb(UE_1, GNB_A), 0.0, 1e-6);
+
+    std::vector<uint32_t> affected;
+    table.removeGnb(GNB_B, affected);
+
+    EXPECT_EQ(affected, (std::vector<uint32_t>{UE_1}));
+    EXPECT_NEAR(table.sinrDb(UE_1, GNB_A), 130.0, 1e-6);
+}
+
+TEST_F(InterferenceTableTest, ReportsOnlyChangesAboveThreshold)
+{
+    table.assignUe(UE_1, {{GNB_A, -70.0}});
+
+    EXPECT_TRUE(table.shouldReport(UE_1, GNB_A, 10.0, 1.0));
+    EXPECT_FALSE(table.shouldReport(UE_1, GNB_A, 10.5, 1.0));
+    EXPECT_TRUE(table.shouldReport(UE_1, GNB_A, 11.0, 1.0));
+    EXPECT_FALSE(table.shouldReport(UE_1, GNB_B, 11.0, 1.0));
+
+    // A UE move keeps what was reported on its remaining links.
+    table.assignUe(UE_1, {{GNB_A, -75.0}});
+    EXPECT_FALSE(table.shouldReport(UE_1, GNB_A, 11.2, 1.0));
+}
@@ -0,0 +1,92 @@
+#include "link_budget.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <set>
+
+class LinkBudgetTest : public ::testing::Test
+{
+protected:
+    const double CARRIER_GHZ = 3.5;
+    const double TX_POWER_DBM = 43.0;
+    const double MIN_RX_DBM = -115.0;
+};
+
+TEST_F(LinkBudgetTest, FreeSpaceMatchesClosedForm)
+{
+    LinkBudget budget(PathLossModel::FreeSpace, CARRIER_GHZ);
+    const double expected =
+        32.45 + 20.0 * std::log10(1000.0) + 20.0 * std::log10(CARRIER_GHZ);
+
+    EXPECT_NEAR(budget.pathLossDb(1000.0), expected, 1e-9);
+}
+
+TEST_F(LinkBudgetTest, BatchKernelMatchesScalarPathLoss)
+{
+    LinkBudget budget(PathLossModel::UrbanMacro, CARRIER_GHZ);
+    const std::vector<double> xs{0.0, 300.0, -1200.0, 0.5};
+    const std::vector<double> ys{0.0, 400.0, 0.0, 0.0};
+    std::vector<double> out(xs.size());
+
+    budget.pathLossBatch(xs.data(), ys.data(), xs.size(), 0.0, 0.0,
+                         out.data());
+
+    EXPECT_NEAR(out[0], budget.pathLossDb(LinkBudget::MIN_DISTANCE_M), 1e-9);
+    EXPECT_NEAR(out[1], budget.pathLossDb(500.0), 1e-9);
+    EXPECT_NEAR(out[2], budget.pathLossDb(1200.0), 1e-9);
+    EXPECT_NEAR(out[3], budget.pathLossDb(LinkBudget::MIN_DISTANCE_M), 1e-9);
+}
+
+TEST_F(LinkBudgetTest, AudibleRequiresRadiusAndMinRxLevel)
+{
+    LinkBudget budget(PathLossModel::UrbanMacro, CARRIER_GHZ);
+    GnbRadioTable table;
+    table.upsert(101, 0.0, 0.0, 5000.0, TX_POWER_DBM, MIN_RX_DBM);
+    table.upsert(102, 0.0, 0.0, 100.0, TX_POWER_DBM, MIN_RX_DBM);
+    table.upsert(103, 5000.0, 0.0, 6000.0, TX_POWER_DBM, MIN_RX_DBM);
+
+    std::set<uint32_t> heard;
+    table.forEachAudible(500.0, 0.0, budget,
+                         [&heard](uint32_t id, double rsrp) {
+                             heard.insert(id);
+                             EXPECT_LT(rsrp, 0.0);
+                         });
+
+    // 102 is outside its radius, 103 is 4.5 km away and below -115 dBm.
+    EXPECT_EQ(heard, (std::set<uint32_t>{101}));
+}
+
+TEST_F(LinkBudgetTest, DisabledModelFallsBackToRadius)
+{
+    LinkBudget budget(PathLossModel::None, CARRIER_GHZ);
+    GnbRadioTable table;
+    table.upsert(101, 0.0, 0.0, 10000.0, TX_POWER_DBM, MIN_RX_DBM);
+
+    size_t heard = 0;
+    table.forEachAudible(9000.0, 0.0, budget,
+                         [&heard](uint32_t, double) { ++heard; });
+
+    EXPECT_FALSE(budget.isEnabled());
+    EXPECT_EQ(heard, 1u);
+}
+
+TEST_F(LinkBudgetTest, RemoveKeepsTableDense)
+{
+    LinkBudget budget(PathLossModel::None, CARRIER_GHZ);
+    GnbRadioTable table;
+    table.upsert(1, 0.0, 0.0, 100.0, TX_POWER_DBM, MIN_RX_DBM);
+    table.upsert(2, 10.0, 0.0, 100.0, TX_POWER_DBM, MIN_RX_DBM);
+    table.upsert(3, 20.0, 0.0, 100.0, TX_POWER_DBM, MIN_RX_DBM);
+
+    EXPECT_TRUE(table.remove(1));
+    EXPECT_FALSE(table.remove(1));
+    table.move(3, 500.0, 0.0);
+
+    std::set<uint32_t> heard;
+    table.forEachAudible(0.0, 0.0, budget,
+                         [&heard](uint32_t id, double) { heard.insert(id); });
+
+    EXPECT_EQ(table.size(), 2u);
+    EXPECT_EQ(heard, (std::set<uint32_t>{2}));
+}
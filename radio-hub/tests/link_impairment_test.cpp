@@ -0,0 +1,69 @@
+#include "link_impairment.hpp"
+
+#include <gtest/gtest.h>
+
+class LinkImpairmentTest : public ::testing::Test
+{
+protected:
+    std::mt19937 rng{42};
+};
+
+TEST_F(LinkImpairmentTest, DefaultSettingsPassPacketsUntouched)
+{
+    LinkImpairment impairment;
+    EXPECT_FALSE(impairment.isEnabled());
+
+    const LinkDecision decision = impairment.decide(1, 2, 5000.0, rng);
+    EXPECT_FALSE(decision.is_lost);
+    EXPECT_EQ(decision.delay_ms, 0u);
+}
+
+TEST_F(LinkImpairmentTest, DelayGrowsWithDistance)
+{
+    LinkImpairmentSettings settings;
+    settings.base.delay_ms = 2.0;
+    settings.delay_per_km_ms = 1.0;
+    LinkImpairment impairment(settings);
+
+    EXPECT_EQ(impairment.decide(1, 2, 0.0, rng).delay_ms, 2u);
+    EXPECT_EQ(impairment.decide(1, 2, 3000.0, rng).delay_ms, 5u);
+}
+
+TEST_F(LinkImpairmentTest, JitterStaysWithinBounds)
+{
+    LinkImpairmentSettings settings;
+    settings.base.delay_ms = 10.0;
+    settings.base.jitter_ms = 3.0;
+    LinkImpairment impairment(settings);
+
+    for (int i = 0; i < 1000; ++i) {
+        const uint32_t delay = impairment.decide(1, 2, 0.0, rng).delay_ms;
+        EXPECT_GE(delay, 7u);
+        EXPECT_LE(delay, 13u);
+    }
+}
+
+TEST_F(LinkImpairmentTest, OverrideAppliesOnlyToItsDirection)
+{
+    LinkImpairmentSettings settings;
+    settings.links.push_back({1, 2, LinkProfile{0.0, 0.0, 1.0}});
+    LinkImpairment impairment(settings);
+
+    EXPECT_TRUE(impairment.isEnabled());
+    EXPECT_TRUE(impairment.decide(1, 2, 0.0, rng).is_lost);
+    EXPECT_FALSE(impairment.decide(2, 1, 0.0, rng).is_lost);
+}
+
+TEST_F(LinkImpairmentTest, LossRateFollowsProbability)
+{
+    LinkImpairmentSettings settings;
+    settings.base.loss_probability = 0.25;
+    LinkImpairment impairment(settings);
+
+    const int total = 20000;
+    int lost = 0;
+    for (int i = 0; i < total; ++i) {
+        lost += impairment.decide(1, 2, 0.0, rng).is_lost ? 1 : 0;
+    }
+    EXPECT_NEAR(static_cast<double>(lost) / total, 0.25, 0.02);
+}
@@ -0,0 +1,77 @@
+#include "liveness_tracker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+class LivenessTrackerTest : public ::testing::Test
+{
+protected:
+    const uint32_t TIMEOUT_MS = 1000;
+    const uint32_t GNB_ID = 101;
+    const uint32_t UE_ID = 501;
+
+    LivenessTracker tracker{TIMEOUT_MS};
+    std::vector<uint32_t> expired;
+
+    size_t expireAt(uint64_t now_ms)
+    {
+        return tracker.expire(now_ms,
+                              [this](uint32_t id) { expired.push_back(id); });
+    }
+};
+
+TEST_F(LivenessTrackerTest, SilentNodeExpiresAfterTimeout)
+{
+    tracker.track(UE_ID, 0);
+
+    EXPECT_EQ(expireAt(TIMEOUT_MS - 1), 0u);
+    EXPECT_EQ(expireAt(TIMEOUT_MS), 1u);
+    EXPECT_EQ(expired, std::vector<uint32_t>{UE_ID});
+    EXPECT_FALSE(tracker.isTracked(UE_ID));
+}
+
+TEST_F(LivenessTrackerTest, TouchPostponesExpiry)
+{
+    tracker.track(UE_ID, 0);
+    tracker.track(GNB_ID, 0);
+    tracker.touch(GNB_ID, 800);
+
+    EXPECT_EQ(expireAt(1500), 1u);
+    EXPECT_EQ(expired, std::vector<uint32_t>{UE_ID});
+    EXPECT_TRUE(tracker.isTracked(GNB_ID));
+
+    EXPECT_EQ(expireAt(1799), 0u);
+    EXPECT_EQ(expireAt(1800), 1u);
+    EXPECT_EQ(tracker.size(), 0u);
+}
+
+TEST_F(LivenessTrackerTest, ForgottenNodeNeverExpires)
+{
+    tracker.track(UE_ID, 0);
+    tracker.forget(UE_ID);
+    tracker.touch(UE_ID, 10);
+
+    EXPECT_EQ(expireAt(10 * TIMEOUT_MS), 0u);
+    EXPECT_TRUE(expired.empty());
+}
+
+TEST(SendQuarantineTest, ConsecutiveErrorsQuarantineUntilProbe)
+{
+    const uint64_t endpoint = 0x7f0000010000 | 40000;
+    SendQuarantine quarantine(3, 500);
+
+    EXPECT_FALSE(quarantine.recordFailure(endpoint, 0));
+    EXPECT_FALSE(quarantine.recordFailure(endpoint, 0));
+    EXPECT_TRUE(quarantine.recordFailure(endpoint, 100));
+    EXPECT_TRUE(quarantine.isBlocked(endpoint, 599));
+
+    // The probe after the quarantine fails once: blocked again at once.
+    EXPECT_FALSE(quarantine.isBlocked(endpoint, 600));
+    EXPECT_TRUE(quarantine.recordFailure(endpoint, 600));
+    EXPECT_TRUE(quarantine.isBlocked(endpoint, 700));
+
+    quarantine.clear(endpoint);
+    EXPECT_FALSE(quarantine.isBlocked(endpoint, 700));
+    EXPECT_EQ(quarantine.size(), 0u);
+}
@@ -0,0 +1,111 @@
+#include "node_registry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+
+TEST(IdSlotMapTest, MatchesReferenceMapUnderChurn)
+{
+    IdSlotMap map;
+    std::unordered_map<uint32_t, uint32_t> reference;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<uint32_t> id_dist(0, 2000);
+
+    for (uint32_t step = 0; step < 20000; ++step) {
+        const uint32_t id = id_dist(rng);
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(map.erase(id), reference.erase(id) > 0);
+        } else {
+            map.assign(id, step);
+            reference[id] = step;
+        }
+    }
+
+    EXPECT_EQ(map.size(), reference.size());
+    for (uint32_t id = 0; id <= 2000; ++id) {
+        auto it = reference.find(id);
+        EXPECT_EQ(map.find(id),
+                  it == reference.end() ? IdSlotMap::NPOS : it->second);
+    }
+}
+
+class NodeRegistryTest : public ::testing::Test
+{
+protected:
+    static NodeInfo makeUe(uint32_t id, double x)
+    {
+        return NodeInfo{{id, EntityType::UE, QHostAddress::LocalHost,
+                         static_cast<quint16>(40000 + id), QPointF(x, 0.0)},
+                        UeData{}};
+    }
+
+    static NodeInfo makeGnb(uint32_t id, double radius)
+    {
+        GnbData data;
+        data.radius = radius;
+        return NodeInfo{{id, EntityType::GNB, QHostAddress::LocalHost,
+                         static_cast<quint16>(40000 + id), QPointF()},
+                        data};
+    }
+
+    NodeRegistry registry;
+};
+
+TEST_F(NodeRegistryTest, StoresColumnsPerSlot)
+{
+    registry.insert(makeUe(1, 10.0));
+    const uint32_t gnb = registry.insert(makeGnb(2, 750.0), true);
+
+    EXPECT_EQ(registry.size(), 2u);
+    EXPECT_EQ(registry.find(2), gnb);
+    EXPECT_EQ(registry.type(gnb), EntityType::GNB);
+    EXPECT_EQ(registry.port(gnb), 40002);
+    EXPECT_DOUBLE_EQ(registry.radius(gnb), 750.0);
+    EXPECT_TRUE(registry.isRemote(gnb));
+    EXPECT_FALSE(registry.isRemote(registry.find(1)));
+    ASSERT_NE(registry.gnbData(gnb), nullptr);
+    EXPECT_EQ(registry.gnbData(registry.find(1)), nullptr);
+    EXPECT_EQ(registry.find(3), NodeRegistry::NPOS);
+}
+
+TEST_F(NodeRegistryTest, RemoveSwapsLastSlotIntoHole)
+{
+    for (uint32_t id = 1; id <= 4; ++id) {
+        registry.insert(makeUe(id, id * 100.0));
+    }
+
+    ASSERT_TRUE(registry.remove(2));
+    EXPECT_FALSE(registry.remove(2));
+    EXPECT_EQ(registry.size(), 3u);
+
+    const uint32_t moved = registry.find(4);
+    EXPECT_EQ(moved, 1u);
+    EXPECT_EQ(registry.id(moved), 4u);
+    EXPECT_EQ(registry.position(moved), QPointF(400.0, 0.0));
+    EXPECT_EQ(registry.nodeInfo(moved).port, 40004);
+    EXPECT_EQ(registry.find(2), NodeRegistry::NPOS);
+}
+
+TEST_F(NodeRegistryTest, SetPositionUpdatesOnlyThatSlot)
+{
+    const uint32_t first = registry.insert(makeUe(1, 0.0));
+    const uint32_t second = registry.insert(makeUe(2, 0.0));
+
+    registry.setPosition(first, QPointF(5.0, 6.0));
+
+    EXPECT_EQ(registry.position(first), QPointF(5.0, 6.0));
+    EXPECT_EQ(registry.position(second), QPointF(0.0, 0.0));
+}
+
+TEST_F(NodeRegistryTest, SharedEndpointFlagMovesWithSlot)
+{
+    registry.insert(makeUe(1, 0.0));
+    registry.insert(makeUe(2, 0.0), false, true);
+
+    ASSERT_TRUE(registry.remove(1));
+    EXPECT_TRUE(registry.hasSharedEndpoint(registry.find(2)));
+
+    const uint32_t local = registry.insert(makeUe(3, 0.0));
+    EXPECT_FALSE(registry.hasSharedEndpoint(local));
+}
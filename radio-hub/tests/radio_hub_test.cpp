@@ -0,0 +1,91 @@
+#include "radio_hub.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <QSignalSpy>
+#include <QtTest/QTest>
+
+#include "qdatastream_serializer.hpp"
+#include "sim_protocol.hpp"
+#include "udp_transport.hpp"
+
+namespace {
+
+constexpr uint16_t HUB_PORT = 5555;
+constexpr uint32_t HUB_ID = 0;
+constexpr uint32_t BROADCAST_ID = 0xFFFFFFFF;
+constexpr uint32_t GNB_ID = 10;
+
+HubSettings inProcessHubSettings()
+{
+    HubSettings set(HUB_PORT, HUB_ID, BROADCAST_ID, Point2D{0.0, 0.0},
+                    "127.0.0.1");
+    set.udp_backend = UdpBackend::InProcess;
+    return set;
+}
+
+}  // namespace
+
+TEST(RadioHubTest, BatchedUesShareAnEndpointAndGetReaddressedBroadcasts)
+{
+    RadioHub hub(inProcessHubSettings());
+    ASSERT_TRUE(hub.run());
+
+    UdpTransport gnb(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(gnb.init(0));
+    const QByteArray gnb_info =
+        QDataStreamSerializer().serializeRegistrationPayload(
+            GnbRegistrationInfo{1000.0, 43.0, -115});
+    gnb.sendData(SimProtocol::buildPacket(GNB_ID, EntityType::GNB, HUB_ID,
+                                          SimMessageType::Registration,
+                                          QPointF(0, 0), gnb_info),
+                 QHostAddress::LocalHost, HUB_PORT);
+
+    // One datagram from one endpoint registers every UE of the host.
+    UdpTransport ue_host(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(ue_host.init(0));
+    QSignalSpy ue_host_spy(&ue_host, &UdpTransport::dataReceived);
+    const QByteArray batch = SimProtocol::buildRegistrationBatchPayload(
+        {{201, QPointF(10, 0)}, {202, QPointF(20, 0)}, {203, QPointF(30, 0)}});
+    ue_host.sendData(SimProtocol::buildPacket(201, EntityType::UE, HUB_ID,
+                                              SimMessageType::RegistrationBatch,
+                                              QPointF(), batch),
+                     QHostAddress::LocalHost, HUB_PORT);
+    QTest::qWait(50);
+
+    std::vector<uint32_t> accepted;
+    for (const auto& signal : ue_host_spy) {
+        const auto packet = SimProtocol::parse(signal.at(0).toByteArray());
+        if (packet.type == SimMessageType::RegistrationResponse &&
+            !packet.payload.isEmpty() &&
+            packet.payload.at(0) == HubResponse::REG_ACCEPTED) {
+            accepted.push_back(packet.dstId);
+        }
+    }
+    std::sort(accepted.begin(), accepted.end());
+    EXPECT_EQ(accepted, (std::vector<uint32_t>{201, 202, 203}));
+    ue_host_spy.clear();
+
+    gnb.sendData(SimProtocol::buildDataPacket(GNB_ID, EntityType::GNB,
+                                              BROADCAST_ID, QPointF(0, 0),
+                                              ProtocolMsgType::Sib1, "sib1"),
+                 QHostAddress::LocalHost, HUB_PORT);
+    QTest::qWait(50);
+
+    // The shared endpoint gets one copy per UE, addressed to that UE.
+    std::vector<uint32_t> addressed;
+    for (const auto& signal : ue_host_spy) {
+        const auto packet = SimProtocol::parse(signal.at(0).toByteArray());
+        if (packet.type != SimMessageType::Data) {
+            continue;
+        }
+        EXPECT_EQ(packet.srcId, GNB_ID);
+        EXPECT_EQ(packet.payload.mid(1), QByteArray("sib1"));
+        addressed.push_back(packet.dstId);
+    }
+    std::sort(addressed.begin(), addressed.end());
+    EXPECT_EQ(addressed, (std::vector<uint32_t>{201, 202, 203}));
+}
@@ -0,0 +1,37 @@
+#include "region_map.hpp"
+
+#include <gtest/gtest.h>
+
+class RegionMapTest : public ::testing::Test
+{
+protected:
+    // Two 10 km x 10 km regions side by side along x.
+    RegionMap map{{{1, 0.0, 0.0, 10000.0, 10000.0, "127.0.0.1", 5555},
+                   {2, 10000.0, 0.0, 20000.0, 10000.0, "127.0.0.1", 5556}}};
+};
+
+TEST_F(RegionMapTest, IndexOfFindsRegionById)
+{
+    EXPECT_EQ(map.indexOf(1), 0u);
+    EXPECT_EQ(map.indexOf(2), 1u);
+    EXPECT_EQ(map.indexOf(3), RegionMap::NONE);
+}
+
+TEST_F(RegionMapTest, SharedBorderBelongsToUpperRegion)
+{
+    EXPECT_EQ(map.indexAt(9999.0, 500.0), 0u);
+    EXPECT_EQ(map.indexAt(10000.0, 500.0), 1u);
+    EXPECT_EQ(map.indexAt(20000.0, 500.0), RegionMap::NONE);
+    EXPECT_EQ(map.indexAt(-1.0, 500.0), RegionMap::NONE);
+}
+
+TEST_F(RegionMapTest, RegionsNearHonoursMarginAndExclusion)
+{
+    EXPECT_EQ(map.regionsNear(5000.0, 5000.0, 3000.0, 0), 0u);
+    EXPECT_EQ(map.regionsNear(8000.0, 5000.0, 3000.0, 0), uint64_t{1} << 1);
+    EXPECT_EQ(map.regionsNear(8000.0, 5000.0, 3000.0, RegionMap::NONE),
+              uint64_t{0b11});
+    // Corner distance is Euclidean, not per axis.
+    EXPECT_EQ(map.regionsNear(22500.0, 12500.0, 3000.0, RegionMap::NONE),
+              0u);
+}
@@ -0,0 +1,128 @@
+#include "signaling_capture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+struct Block {
+    uint32_t type;
+    std::vector<char> body;
+};
+
+std::vector<Block> readBlocks(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(in)),
+                                  std::istreambuf_iterator<char>());
+
+    std::vector<Block> blocks;
+    size_t offset = 0;
+    while (offset + 12 <= bytes.size()) {
+        uint32_t type = 0;
+        uint32_t length = 0;
+        std::memcpy(&type, bytes.data() + offset, 4);
+        std::memcpy(&length, bytes.data() + offset + 4, 4);
+        if (length < 12 || length % 4 != 0 || offset + length > bytes.size()) {
+            break;
+        }
+        blocks.push_back({type, std::vector<char>(
+                                    bytes.begin() + offset + 8,
+                                    bytes.begin() + offset + length - 4)});
+        offset += length;
+    }
+    return blocks;
+}
+
+uint32_t readU32(const std::vector<char>& body, size_t offset)
+{
+    uint32_t value = 0;
+    std::memcpy(&value, body.data() + offset, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+class SignalingCaptureTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        settings.path = ::testing::TempDir() + "signaling_capture_test.pcapng";
+    }
+
+    void TearDown() override
+    {
+        std::remove(settings.path.c_str());
+    }
+
+    CaptureSettings settings;
+};
+
+TEST_F(SignalingCaptureTest, WritesPcapngWithOneInterfacePerLane)
+{
+    const std::string datagram = "sim-protocol-datagram";
+    {
+        SignalingCapture capture(settings, 2);
+        ASSERT_TRUE(capture.start());
+        capture.record(0, datagram.data(), datagram.size(), 101, 501, 3);
+        capture.record(1, datagram.data(), datagram.size(), 501, 101, 3);
+        capture.stop();
+        EXPECT_EQ(capture.written(), 2u);
+        EXPECT_EQ(capture.dropped(), 0u);
+    }
+
+    const auto blocks = readBlocks(settings.path);
+    ASSERT_EQ(blocks.size(), 7u);
+    EXPECT_EQ(blocks[0].type, 0x0A0D0D0Au);
+    EXPECT_EQ(readU32(blocks[0].body, 0), 0x1A2B3C4Du);
+    EXPECT_EQ(blocks[1].type, 1u);
+    EXPECT_EQ(blocks[2].type, 1u);
+
+    const Block& packet = blocks[3];
+    EXPECT_EQ(packet.type, 6u);
+    EXPECT_EQ(readU32(packet.body, 0), 0u);
+    EXPECT_EQ(readU32(packet.body, 12), datagram.size());
+    EXPECT_EQ(std::string(packet.body.data() + 20, datagram.size()),
+              datagram);
+    EXPECT_EQ(readU32(blocks[4].body, 0), 1u);
+
+    EXPECT_EQ(blocks[5].type, 5u);
+    EXPECT_EQ(blocks[6].type, 5u);
+}
+
+TEST_F(SignalingCaptureTest, FullRingDropsAndCountsRecords)
+{
+    settings.ring_capacity = 2;
+    SignalingCapture capture(settings, 1);
+
+    const char datagram[] = "x";
+    for (int i = 0; i < 5; ++i) {
+        capture.record(0, datagram, sizeof(datagram), 1, 2, 3);
+    }
+    EXPECT_EQ(capture.dropped(), 3u);
+
+    ASSERT_TRUE(capture.start());
+    capture.stop();
+    EXPECT_EQ(capture.written(), 2u);
+}
+
+TEST_F(SignalingCaptureTest, TruncatesToSnapLength)
+{
+    const std::vector<char> jumbo(CaptureRecord::SNAP_LENGTH + 100, 'j');
+    {
+        SignalingCapture capture(settings, 1);
+        ASSERT_TRUE(capture.start());
+        capture.record(0, jumbo.data(), jumbo.size(), 1, 2, 3);
+    }
+
+    const auto blocks = readBlocks(settings.path);
+    ASSERT_GE(blocks.size(), 3u);
+    EXPECT_EQ(readU32(blocks[2].body, 12), CaptureRecord::SNAP_LENGTH);
+    EXPECT_EQ(readU32(blocks[2].body, 16), jumbo.size());
+}
@@ -0,0 +1,83 @@
+#include "spatial_grid.hpp"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+namespace {
+
+std::set<uint32_t> query(const SpatialGrid& grid, const QPointF& center,
+                         double radius)
+{
+    std::set<uint32_t> ids;
+    grid.forEachInRadius(center, radius,
+                         [&ids](uint32_t id, const QPointF&) {
+                             ids.insert(id);
+                         });
+    return ids;
+}
+
+}  // namespace
+
+class SpatialGridTest : public ::testing::Test
+{
+protected:
+    const double CELL_SIZE = 100.0;
+    const QPointF GNB_POS{0.0, 0.0};
+    const double RADIUS = 150.0;
+};
+
+TEST_F(SpatialGridTest, FindsOnlyNodesInsideRadius)
+{
+    SpatialGrid grid(CELL_SIZE);
+    grid.insert(1, {10.0, 10.0});
+    grid.insert(2, {149.0, 0.0});
+    grid.insert(3, {120.0, 120.0});
+    grid.insert(4, {-2000.0, 500.0});
+
+    EXPECT_EQ(query(grid, GNB_POS, RADIUS), (std::set<uint32_t>{1, 2}));
+}
+
+TEST_F(SpatialGridTest, BoundaryDistanceIsCovered)
+{
+    SpatialGrid grid(CELL_SIZE);
+    grid.insert(7, {0.0, -150.0});
+
+    EXPECT_EQ(query(grid, GNB_POS, RADIUS), (std::set<uint32_t>{7}));
+}
+
+TEST_F(SpatialGridTest, MoveAcrossCellsUpdatesQueries)
+{
+    SpatialGrid grid(CELL_SIZE);
+    grid.insert(1, {10.0, 10.0});
+    grid.insert(2, {20.0, 20.0});
+
+    grid.move(1, {900.0, 900.0});
+
+    EXPECT_EQ(query(grid, GNB_POS, RADIUS), (std::set<uint32_t>{2}));
+    EXPECT_EQ(query(grid, {900.0, 900.0}, 10.0), (std::set<uint32_t>{1}));
+    EXPECT_EQ(grid.size(), 2u);
+}
+
+TEST_F(SpatialGridTest, RemoveKeepsOtherNodesReachable)
+{
+    SpatialGrid grid(CELL_SIZE);
+    grid.insert(1, {10.0, 10.0});
+    grid.insert(2, {15.0, 15.0});
+    grid.insert(3, {20.0, 20.0});
+
+    EXPECT_TRUE(grid.remove(1));
+    EXPECT_FALSE(grid.remove(1));
+    EXPECT_FALSE(grid.contains(1));
+
+    EXPECT_EQ(query(grid, GNB_POS, RADIUS), (std::set<uint32_t>{2, 3}));
+}
+
+TEST_F(SpatialGridTest, HandlesNegativeCoordinates)
+{
+    SpatialGrid grid(CELL_SIZE);
+    grid.insert(1, {-1.0, -1.0});
+    grid.insert(2, {-250.0, -250.0});
+
+    EXPECT_EQ(query(grid, {-50.0, -50.0}, 100.0), (std::set<uint32_t>{1}));
+}
@@ -0,0 +1,78 @@
+#include "traffic_recording.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+class TrafficRecordingTest : public ::testing::Test
+{
+protected:
+    const uint32_t LOCALHOST = 0x7F000001;
+    const std::string path =
+        ::testing::TempDir() + "traffic_recording_test.rec";
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+};
+
+TEST_F(TrafficRecordingTest, RoundTripKeepsOrderTimesAndBytes)
+{
+    const std::string first = "registration";
+    const std::string second(300, 'x');
+    {
+        TrafficRecorder recorder(path);
+        ASSERT_TRUE(recorder.open());
+        recorder.record(10, LOCALHOST, 40000, first.data(), first.size());
+        recorder.record(1'000'000, LOCALHOST, 40001, second.data(),
+                        second.size());
+        EXPECT_EQ(recorder.recorded(), 2u);
+    }
+
+    TrafficReader reader(path);
+    ASSERT_TRUE(reader.open());
+    TrafficRecord record;
+
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.arrival_us, 10u);
+    EXPECT_EQ(record.ipv4, LOCALHOST);
+    EXPECT_EQ(record.port, 40000);
+    EXPECT_EQ(std::string(record.data.begin(), record.data.end()), first);
+
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.arrival_us, 1'000'000u);
+    EXPECT_EQ(record.port, 40001);
+    EXPECT_EQ(std::string(record.data.begin(), record.data.end()), second);
+
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(TrafficRecordingTest, BackwardsTimeIsClampedToPreviousRecord)
+{
+    {
+        TrafficRecorder recorder(path);
+        ASSERT_TRUE(recorder.open());
+        recorder.record(500, LOCALHOST, 1, "a", 1);
+        recorder.record(400, LOCALHOST, 2, "b", 1);
+    }
+
+    TrafficReader reader(path);
+    ASSERT_TRUE(reader.open());
+    TrafficRecord record;
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.arrival_us, 500u);
+}
+
+TEST_F(TrafficRecordingTest, RejectsForeignFiles)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("not a recording", file);
+    std::fclose(file);
+
+    TrafficReader reader(path);
+    EXPECT_FALSE(reader.open());
+}
@@ -0,0 +1,73 @@
+#ifndef UE_HOST_HPP
+#define UE_HOST_HPP
+
+#include <memory>
+#include <vector>
+
+#include <QObject>
+
+#include "settings.hpp"
+#include "sim_protocol.hpp"
+#include "timer_scheduler.hpp"
+#include "ue_logic.hpp"
+#include "udp_transport.hpp"
+
+/**
+ * @brief Runs a range of UEs in one process.
+ *
+ * The UEs share one UdpTransport instead of a socket each, and their
+ * deadlines share the thread's TimerScheduler. They register at the hub
+ * in RegistrationBatch datagrams, and so do UEs that have to register
+ * again later. The hub then addresses every datagram, broadcasts
+ * included, to a single UE, and the host hands it to that UE by
+ * destination id.
+ */
+class UeHost : public QObject
+{
+    Q_OBJECT
+public:
+    UeHost(HostRange range, const UeSettings& set, QObject* parent = nullptr);
+
+    bool setupNetwork(quint16 port);
+    // Places every UE at random within radius of center.
+    void scatter(QPointF center, double radius);
+    void registerAtHub();
+    void run();
+
+    // nullptr when id is outside the hosted range.
+    UeLogic* ue(uint32_t id) const;
+    size_t size() const;
+
+private slots:
+    void onDatagram(const QByteArray& data, const QHostAddress& addr,
+                    quint16 port);
+    void sendRegistrationBatch();
+    void sendReregistrations();
+
+private:
+    struct PendingRegistration {
+        uint32_t id;
+        QHostAddress hub_address;
+        quint16 hub_port;
+    };
+
+    size_t batchSize() const;
+    void sendBatch(const std::vector<SimProtocol::BatchedNode>& nodes,
+                   const QHostAddress& hub_address, quint16 hub_port);
+    void queueRegistration(uint32_t id, const QHostAddress& hub_address,
+                           quint16 hub_port);
+
+    HostRange range_;
+    UeSettings set_;
+    QHostAddress hub_address_;
+    std::vector<std::unique_ptr<UeLogic>> ues_;
+
+    UdpTransport* transport_ = nullptr;
+    Deadline registration_deadline_;
+    size_t next_to_register_ = 0;
+    // UEs that registered again (expired, redirected), sent next turn.
+    std::vector<PendingRegistration> reregistrations_;
+    Deadline reregistration_deadline_;
+};
+
+#endif  // UE_HOST_HPP
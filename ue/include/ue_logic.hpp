@@ -1,13 +1,11 @@
 #ifndef UE_LOGIC_HPP
 #define UE_LOGIC_HPP
 
-#include <chrono>
-
 #include <QHash>
-#include <QTimer>
 
 #include "base_entity.hpp"
 #include "settings.hpp"
+#include "timer_scheduler.hpp"
 
 #ifdef UNIT_TESTS
 class UeLogicTestWrapper;
@@ -29,10 +27,11 @@ public:
 protected:
     void onProtocolMessageReceived(uint32_t gnb_id, ProtocolMsgType type,
                                    const QByteArray& payload) override;
+    void onRsrpReport(
+        const std::vector<SimProtocol::RsrpSample>& samples) override;
     void searchingForCell();
 
 private slots:
-    void onTick();
     void onRegistrationConfirmed();
 
 private:
@@ -50,6 +49,8 @@ private:
 
     void sendRegistrationRequest();
     void sendMeasurementReport();
+    // Reports every report_interval_ms_ while RRC_CONNECTED.
+    void scheduleMeasurementReport();
 
     void resetSessionContext();
     bool checkPlmnValidity(const SIB1Info& sib1);
@@ -68,9 +69,12 @@ private:
     uint16_t last_rach_ra_rnti_;
     uint64_t sent_msg3_identity_;
 
-    QTimer* timer_ = nullptr;
-    std::chrono::steady_clock::time_point last_report_time_;
-    const std::chrono::milliseconds report_interval_{500};
+    Deadline scan_deadline_;
+    Deadline report_deadline_;
+    const uint32_t report_interval_ms_ = 500;
+    // Latest RsrpReport from the hub; empty until the first one arrives.
+    QHash<uint32_t, double> gnb_rsrp_dbm_;
+    bool has_rsrp_view_ = false;
 
     QList<uint32_t> peers_;
 
@@ -0,0 +1,205 @@
+#include "ue_host.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDebug>
+#include <QRandomGenerator>
+#include <QtMath>
+
+#include "sim_protocol.hpp"
+
+UeHost::UeHost(HostRange range, const UeSettings& set, QObject* parent)
+    : QObject(parent)
+    , range_(range)
+    , set_(set)
+    , hub_address_(QString::fromStdString(set.hub.address))
+{
+    // A shared-memory ring per hosted UE would undo the shared socket.
+    set_.hub.shm_transport.enabled = false;
+
+    ues_.reserve(range_.count);
+    for (uint32_t i = 0; i < range_.count; ++i) {
+        ues_.push_back(std::make_unique<UeLogic>(range_.id_start + i, set_));
+        ues_.back()->setRegistrar(
+            [this](uint32_t id, const QHostAddress& address, quint16 port) {
+                queueRegistration(id, address, port);
+            });
+    }
+}
+
+bool UeHost::setupNetwork(quint16 port)
+{
+    if (!transport_) {
+        transport_ = new UdpTransport(this, set_.hub.udp_backend);
+        transport_->setObjectName(
+            QString("transport-UE-host-%1").arg(range_.id_start));
+    }
+
+    if (!transport_->init(port)) {
+        qCritical() << QString("[UE host %1+%2] Network setup failed on "
+                               "port %3")
+                           .arg(range_.id_start)
+                           .arg(range_.count)
+                           .arg(port);
+        return false;
+    }
+
+    for (const auto& ue : ues_) {
+        ue->attachTransport(transport_);
+        ue->setPort(transport_->localPort());
+    }
+    connect(transport_, &UdpTransport::dataReceived, this,
+            &UeHost::onDatagram, Qt::DirectConnection);
+
+    qDebug() << QString("[UE host %1+%2] Network is UP on port %3")
+                    .arg(range_.id_start)
+                    .arg(range_.count)
+                    .arg(transport_->localPort());
+    return true;
+}
+
+void UeHost::scatter(QPointF center, double radius)
+{
+    auto* rng = QRandomGenerator::global();
+    for (const auto& ue : ues_) {
+        // sqrt keeps the density uniform over the disc.
+        const double distance = radius * std::sqrt(rng->generateDouble());
+        const double angle = 2.0 * M_PI * rng->generateDouble();
+        ue->setPosition(center + QPointF(distance * std::cos(angle),
+                                         distance * std::sin(angle)));
+    }
+}
+
+void UeHost::registerAtHub()
+{
+    next_to_register_ = 0;
+    sendRegistrationBatch();
+}
+
+size_t UeHost::batchSize() const
+{
+    return std::clamp<size_t>(set_.host.registration_batch_size, 1,
+                              SimProtocol::MAX_REGISTRATION_BATCH);
+}
+
+void UeHost::sendBatch(const std::vector<SimProtocol::BatchedNode>& nodes,
+                       const QHostAddress& hub_address, quint16 hub_port)
+{
+    const SimProtocol::BatchedNode& first = nodes.front();
+    const QByteArray packet = SimProtocol::buildPacket(
+        first.id, EntityType::UE, set_.hub.id,
+        SimMessageType::RegistrationBatch, first.position,
+        SimProtocol::buildRegistrationBatchPayload(nodes));
+    transport_->sendData(packet, hub_address, hub_port);
+}
+
+void UeHost::sendRegistrationBatch()
+{
+    const size_t end =
+        std::min(ues_.size(), next_to_register_ + batchSize());
+    if (next_to_register_ >= end) {
+        return;
+    }
+
+    std::vector<SimProtocol::BatchedNode> nodes;
+    nodes.reserve(end - next_to_register_);
+    for (size_t i = next_to_register_; i < end; ++i) {
+        nodes.push_back({ues_[i]->getId(), ues_[i]->position()});
+    }
+    sendBatch(nodes, hub_address_, set_.hub.port);
+
+    next_to_register_ = end;
+    if (next_to_register_ < ues_.size()) {
+        registration_deadline_.start(set_.host.registration_interval_ms,
+                                     [this]() { sendRegistrationBatch(); });
+    }
+}
+
+void UeHost::queueRegistration(uint32_t id, const QHostAddress& hub_address,
+                               quint16 hub_port)
+{
+    const bool is_queued = std::any_of(
+        reregistrations_.begin(), reregistrations_.end(),
+        [id](const PendingRegistration& pending) { return pending.id == id; });
+    if (!is_queued) {
+        reregistrations_.push_back({id, hub_address, hub_port});
+    }
+    if (!reregistration_deadline_.isActive()) {
+        reregistration_deadline_.start(0, [this]() { sendReregistrations(); });
+    }
+}
+
+void UeHost::sendReregistrations()
+{
+    // Redirects may have spread the UEs over several hubs: one run of
+    // batches per hub.
+    std::vector<PendingRegistration> pending;
+    pending.swap(reregistrations_);
+    const size_t batch_size = batchSize();
+
+    while (!pending.empty()) {
+        const QHostAddress hub_address = pending.front().hub_address;
+        const quint16 hub_port = pending.front().hub_port;
+        const auto same_hub = [&](const PendingRegistration& registration) {
+            return registration.hub_address == hub_address &&
+                   registration.hub_port == hub_port;
+        };
+
+        std::vector<SimProtocol::BatchedNode> nodes;
+        for (const PendingRegistration& registration : pending) {
+            if (!same_hub(registration)) {
+                continue;
+            }
+            nodes.push_back({registration.id, ue(registration.id)->position()});
+            if (nodes.size() == batch_size) {
+                sendBatch(nodes, hub_address, hub_port);
+                nodes.clear();
+            }
+        }
+        if (!nodes.empty()) {
+            sendBatch(nodes, hub_address, hub_port);
+        }
+        pending.erase(std::remove_if(pending.begin(), pending.end(), same_hub),
+                      pending.end());
+    }
+}
+
+void UeHost::run()
+{
+    for (const auto& ue : ues_) {
+        ue->run();
+    }
+    qDebug() << QString("UE host %1+%2 started")
+                    .arg(range_.id_start)
+                    .arg(range_.count);
+}
+
+UeLogic* UeHost::ue(uint32_t id) const
+{
+    if (id < range_.id_start || id - range_.id_start >= ues_.size()) {
+        return nullptr;
+    }
+    return ues_[id - range_.id_start].get();
+}
+
+size_t UeHost::size() const
+{
+    return ues_.size();
+}
+
+void UeHost::onDatagram(const QByteArray& data, const QHostAddress& addr,
+                        quint16 port)
+{
+    const SimProtocol::HeaderView header = SimProtocol::peekHeader(data);
+    if (!header.isValid) {
+        return;
+    }
+
+    // Every hosted UE registers as sharing this endpoint, so the hub
+    // readdresses broadcasts to each UE in coverage. A raw broadcast names
+    // no UE and is dropped rather than handed to all of them.
+    if (UeLogic* target = ue(header.dstId)) {
+        target->handleIncomingRawData(data, addr, port);
+    }
+}
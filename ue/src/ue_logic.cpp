@@ -20,22 +20,13 @@ UeLogic::UeLogic(const uint32_t id, const UeSettings set, QObject* parent)
     qDebug() << "[UE #" << id_
              << "] Created. "
                 "Initial State: DETACHED";
-    timer_ = new QTimer(this);
-    timer_->setInterval(set.radio.radio_frame_duration);
-
-    connect(timer_, &QTimer::timeout, this, &UeLogic::onTick);
-    last_report_time_ = std::chrono::steady_clock::now();
     connect(this, &BaseEntity::registrationAtRadioHubConfirmed, this,
             &UeLogic::onRegistrationConfirmed);
 }
 
 void UeLogic::run()
 {
-    if (timer_->isActive()) {
-        return;
-    }
     qDebug() << "UE #" << id_ << " started";
-    timer_->start();
 }
 
 void UeLogic::resetSessionContext()
@@ -45,7 +36,7 @@ void UeLogic::resetSessionContext()
     crnti_ = 0;
     last_rach_ra_rnti_ = 0;
     sent_msg3_identity_ = 0;
-    last_report_time_ = std::chrono::steady_clock::now();
+    report_deadline_.stop();
 }
 
 bool UeLogic::checkPlmnValidity(const SIB1Info& sib1)
@@ -72,7 +63,7 @@ void UeLogic::searchingForCell()
     resetSessionContext();
     state_ = UeRrcState::DETACHED;
 
-    const int scan_delay = 2000;
+    const uint32_t scan_delay = 2000;
 
     qDebug() << QString(
                     "[UE %1] Connection lost/released. Waiting %2ms for "
@@ -80,7 +71,7 @@ void UeLogic::searchingForCell()
                     .arg(id_)
                     .arg(scan_delay);
 
-    QTimer::singleShot(scan_delay, this, [this]() {
+    scan_deadline_.start(scan_delay, [this]() {
         state_ = UeRrcState::SEARCHING_FOR_CELL;
         qDebug() << QString("[UE %1] Receiver active. Listening for SIB1...")
                         .arg(id_);
@@ -289,7 +280,7 @@ void UeLogic::handleRrcSetup(uint32_t gnb_id, const QByteArray& payload)
     state_ = UeRrcState::RRC_CONNECTED;
     is_connected_ = true;
 
-    last_report_time_ = std::chrono::steady_clock::now();
+    scheduleMeasurementReport();
 
     qDebug() << "[UE #" << id_ << "] Connected to gNB" << gnb_id
              << ". C-RNTI:" << crnti_;
@@ -403,16 +394,15 @@ void UeLogic::handleRegistrationAccept(const QByteArray& payload)
     }
 }
 
-void UeLogic::onTick()
+void UeLogic::scheduleMeasurementReport()
 {
-    auto now = std::chrono::steady_clock::now();
-
-    bool canSendReports = (state_ == UeRrcState::RRC_CONNECTED);
-
-    if (canSendReports && (now - last_report_time_ >= report_interval_)) {
+    report_deadline_.start(report_interval_ms_, [this]() {
+        if (state_ != UeRrcState::RRC_CONNECTED) {
+            return;
+        }
         sendMeasurementReport();
-        last_report_time_ = now;
-    }
+        scheduleMeasurementReport();
+    });
 }
 
 void UeLogic::sendMeasurementReport()
@@ -421,7 +411,18 @@ void UeLogic::sendMeasurementReport()
         return;
     }
 
-    const double rsrp = -90.0 + QRandomGenerator::global()->bounded(10);
+    double rsrp = 0.0;
+    if (has_rsrp_view_) {
+        const auto it = gnb_rsrp_dbm_.constFind(target_gnb_id_);
+        if (it == gnb_rsrp_dbm_.constEnd()) {
+            // The serving cell is no longer audible; nothing to measure.
+            return;
+        }
+        rsrp = it.value();
+    } else {
+        // The hub runs without a path loss model and sends no RSRP.
+        rsrp = -90.0 + QRandomGenerator::global()->bounded(10);
+    }
     const QByteArray report = serializer_->serializeMeasurementReport(
         MeasurementReportInfo{target_gnb_id_, rsrp});
 
@@ -430,6 +431,16 @@ void UeLogic::sendMeasurementReport()
     sendSimData(ProtocolMsgType::MeasurementReport, report, target_gnb_id_);
 }
 
+void UeLogic::onRsrpReport(const std::vector<SimProtocol::RsrpSample>& samples)
+{
+    // Each report lists every audible gNB and replaces the previous one.
+    gnb_rsrp_dbm_.clear();
+    for (const SimProtocol::RsrpSample& sample : samples) {
+        gnb_rsrp_dbm_.insert(sample.gnbId, sample.rsrpDbm);
+    }
+    has_rsrp_view_ = true;
+}
+
 void UeLogic::handleRrcReconfiguration(const QByteArray& payload)
 {
     const auto info = serializer_->deserializeRrcReconfiguration(payload);
@@ -455,7 +466,7 @@ void UeLogic::handleRrcReconfiguration(const QByteArray& payload)
                     .arg(id_)
                     .arg(target_gnb_id);
 
-    last_report_time_ = std::chrono::steady_clock::now();
+    report_deadline_.stop();
 
     sendRachPreamble();
 }
@@ -4,8 +4,43 @@
 #include <QHostAddress>
 
 #include "config_manager.hpp"
+#include "ue_host.hpp"
 #include "ue_logic.hpp"
 
+namespace {
+
+int runHost(QCoreApplication& app)
+{
+    const auto& config = ConfigManager::instance();
+    auto context = config.getUeHostContext();
+
+    if (!context) {
+        return EXIT_FAILURE;
+    }
+
+    UeHost host(context->range, context->set);
+    const Point2D hub_pos = context->set.hub.virt_pos;
+    host.scatter(QPointF{hub_pos.X, hub_pos.Y},
+                 context->set.host.placement_radius_m);
+    for (uint32_t i = 0; i < context->range.count; ++i) {
+        const uint32_t id = context->range.id_start + i;
+        if (const auto pos = config.getUePosition(id)) {
+            host.ue(id)->setPosition(QPointF{pos->X, pos->Y});
+        }
+    }
+
+    if (!host.setupNetwork(NetworkParam::EPHEMERAL_PORT)) {
+        return EXIT_FAILURE;
+    }
+
+    host.registerAtHub();
+    host.run();
+
+    return app.exec();
+}
+
+}  // namespace
+
 int main(int argc, char* argv[])
 {
     QCoreApplication a(argc, argv);
@@ -17,6 +52,10 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    if (ConfigManager::instance().getHostRange()) {
+        return runHost(a);
+    }
+
     auto context = ConfigManager::instance().getUeContext();
 
     if (!context) {
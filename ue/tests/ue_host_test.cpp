@@ -0,0 +1,131 @@
+#include "ue_host.hpp"
+
+#include "gnb_host.hpp"
+#include "ue_logic_test.hpp"
+
+namespace {
+
+UeSettings inProcessSettings()
+{
+    HubSettings hub_set = TestData::HUB_SET;
+    hub_set.udp_backend = UdpBackend::InProcess;
+    UeSettings set(hub_set, TestData::RADIO, TestData::CELL);
+    set.host.registration_batch_size = 2;
+    return set;
+}
+
+GnbSettings inProcessGnbSettings()
+{
+    HubSettings hub_set = TestData::HUB_SET;
+    hub_set.udp_backend = UdpBackend::InProcess;
+    return GnbSettings(hub_set, TestData::RADIO, TestData::CELL,
+                       TestData::RADIUS);
+}
+
+}  // namespace
+
+TEST(UeHostTest, RegistersInBatchesAndDemultiplexesByDestination)
+{
+    UdpTransport hub(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(hub.init(TestData::HUB_PORT));
+    QSignalSpy hub_spy(&hub, &UdpTransport::dataReceived);
+
+    UeHost host(HostRange{200, 3}, inProcessSettings());
+    ASSERT_EQ(host.size(), 3u);
+    EXPECT_EQ(host.ue(199), nullptr);
+    EXPECT_EQ(host.ue(203), nullptr);
+    ASSERT_TRUE(host.setupNetwork(0));
+
+    host.registerAtHub();
+    QTest::qWait(50);
+    ASSERT_EQ(hub_spy.count(), 2);
+
+    const auto first = SimProtocol::parse(hub_spy.at(0).at(0).toByteArray());
+    EXPECT_EQ(first.type, SimMessageType::RegistrationBatch);
+    const auto batch = SimProtocol::parseRegistrationBatch(first.payload);
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[0].id, 200u);
+    EXPECT_EQ(batch[1].id, 201u);
+    const auto rest = SimProtocol::parseRegistrationBatch(
+        SimProtocol::parse(hub_spy.at(1).at(0).toByteArray()).payload);
+    ASSERT_EQ(rest.size(), 1u);
+    EXPECT_EQ(rest[0].id, 202u);
+
+    QSignalSpy first_spy(host.ue(200),
+                         &BaseEntity::registrationAtRadioHubConfirmed);
+    QSignalSpy second_spy(host.ue(201),
+                          &BaseEntity::registrationAtRadioHubConfirmed);
+    QByteArray status;
+    status.append(static_cast<char>(HubResponse::REG_ACCEPTED));
+    const quint16 host_port = hub_spy.at(0).at(2).value<quint16>();
+    hub.sendData(SimProtocol::buildPacket(TestData::HUB_ID,
+                                          EntityType::RadioHub, 201,
+                                          SimMessageType::RegistrationResponse,
+                                          QPointF(), status),
+                 QHostAddress::LocalHost, host_port);
+    QCoreApplication::processEvents();
+
+    EXPECT_EQ(first_spy.count(), 0);
+    EXPECT_EQ(second_spy.count(), 1);
+}
+
+TEST(UeHostTest, ExpiredUeRegistersAgainInABatch)
+{
+    UdpTransport hub(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(hub.init(TestData::HUB_PORT));
+    QSignalSpy hub_spy(&hub, &UdpTransport::dataReceived);
+
+    UeHost host(HostRange{300, 2}, inProcessSettings());
+    ASSERT_TRUE(host.setupNetwork(0));
+    host.registerAtHub();
+    QTest::qWait(50);
+    ASSERT_EQ(hub_spy.count(), 1);
+    const quint16 host_port = hub_spy.at(0).at(2).value<quint16>();
+    hub_spy.clear();
+
+    // The hub no longer knows UE 301.
+    QByteArray denied;
+    denied.append(static_cast<char>(HubResponse::REG_DENIED));
+    hub.sendData(SimProtocol::buildPacket(TestData::HUB_ID,
+                                          EntityType::RadioHub, 301,
+                                          SimMessageType::Heartbeat,
+                                          QPointF(), denied),
+                 QHostAddress::LocalHost, host_port);
+    QTest::qWait(50);
+
+    ASSERT_EQ(hub_spy.count(), 1);
+    const auto packet = SimProtocol::parse(hub_spy.at(0).at(0).toByteArray());
+    EXPECT_EQ(packet.type, SimMessageType::RegistrationBatch);
+    const auto batch = SimProtocol::parseRegistrationBatch(packet.payload);
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(batch[0].id, 301u);
+}
+
+TEST(UeHostTest, UeCampsOnHostedGnbCell)
+{
+    UdpTransport hub(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(hub.init(TestData::HUB_PORT));
+    QSignalSpy hub_spy(&hub, &UdpTransport::dataReceived);
+
+    GnbHost gnb_host(HostRange{10, 2}, inProcessGnbSettings());
+    ASSERT_TRUE(gnb_host.setupNetwork(0));
+    // A confirmed registration makes the cell broadcast its SIB1.
+    emit gnb_host.cell(11)->registrationAtRadioHubConfirmed();
+    QCoreApplication::processEvents();
+    ASSERT_EQ(hub_spy.count(), 1);
+
+    const QByteArray datagram = hub_spy.at(0).at(0).toByteArray();
+    const auto sib1 = SimProtocol::view(datagram);
+    ASSERT_EQ(sib1.protocolType(), ProtocolMsgType::Sib1);
+    EXPECT_EQ(sib1.srcId, 11u);
+
+    UeLogicTestWrapper ue(TestData::UE_ID, TestData::UE_SETTINGS);
+    ue.setState(UeRrcState::SEARCHING_FOR_CELL);
+    ue.onProtocolMessageReceived(sib1.srcId, ProtocolMsgType::Sib1,
+                                 sib1.protocolPayload());
+
+    EXPECT_EQ(ue.target_gnb_id_, 11u);
+    EXPECT_EQ(ue.getCurrentState(), UeRrcState::RRC_CONNECTING);
+    ASSERT_FALSE(ue.sent_messages.isEmpty());
+    EXPECT_EQ(ue.sent_messages.last().type, ProtocolMsgType::RachPreamble);
+}
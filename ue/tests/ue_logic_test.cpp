@@ -1,5 +1,7 @@
 #include "ue_logic_test.hpp"
 
+#include <QCoreApplication>
+
 #include "qdatastream_serializer.hpp"
 
 class UeLogicTest : public ::testing::Test
@@ -117,6 +119,30 @@ TEST_F(UeLogicTest, MeasurementReportTimer)
     EXPECT_FALSE(found_report);
 }
 
+TEST_F(UeLogicTest, MeasurementReportCarriesHubRsrp)
+{
+    ue->state_ = UeRrcState::RRC_CONNECTED;
+    ue->target_gnb_id_ = 50;
+    ue->onRsrpReport({{50, -87.5}, {51, -101.0}});
+
+    ue->sendMeasurementReport();
+
+    ASSERT_FALSE(ue->sent_messages.isEmpty());
+    EXPECT_EQ(ue->sent_messages.last().type,
+              ProtocolMsgType::MeasurementReport);
+    const auto info = serializer_->deserializeMeasurementReport(
+        ue->sent_messages.last().payload);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->reported_gnb_id, 50u);
+    EXPECT_DOUBLE_EQ(info->rsrp, -87.5);
+
+    // Out of range of the serving gNB: no report.
+    ue->sent_messages.clear();
+    ue->onRsrpReport({{51, -101.0}});
+    ue->sendMeasurementReport();
+    EXPECT_TRUE(ue->sent_messages.isEmpty());
+}
+
 TEST_F(UeLogicTest, HandleRrcSetupSuccess)
 {
     ue->state_ = UeRrcState::RRC_CONNECTING;
@@ -235,3 +261,42 @@ TEST_F(UeLogicTest, HandleRegistrationAcceptSuccess)
 
     qDebug() << "Registration Accept processed. UE is now registered.";
 }
+
+TEST(UeInProcessLoopbackTest, RegistrationRoundTripWithoutSockets)
+{
+    HubSettings hub_set = TestData::HUB_SET;
+    hub_set.udp_backend = UdpBackend::InProcess;
+    const UeSettings settings(hub_set, TestData::RADIO, TestData::CELL);
+
+    UdpTransport hub(nullptr, UdpBackend::InProcess);
+    ASSERT_TRUE(hub.init(TestData::HUB_PORT));
+    QSignalSpy hub_spy(&hub, &UdpTransport::dataReceived);
+
+    UeLogic ue(TestData::UE_ID, settings);
+    ASSERT_TRUE(ue.setupNetwork(0));
+    QSignalSpy registered_spy(&ue,
+                              &BaseEntity::registrationAtRadioHubConfirmed);
+
+    ue.registerAtHub();
+    QCoreApplication::processEvents();
+    ASSERT_EQ(hub_spy.count(), 1);
+
+    const auto request = SimProtocol::parse(hub_spy.at(0).at(0).toByteArray());
+    EXPECT_EQ(request.type, SimMessageType::Registration);
+    EXPECT_EQ(request.srcId, TestData::UE_ID);
+    EXPECT_EQ(request.nodeType, EntityType::UE);
+    const quint16 ue_port = hub_spy.at(0).at(2).value<quint16>();
+    EXPECT_EQ(ue_port, ue.port());
+
+    QByteArray status;
+    status.append(static_cast<char>(HubResponse::REG_ACCEPTED));
+    ASSERT_FALSE(hub.sendData(SimProtocol::buildPacket(
+                                  TestData::HUB_ID, EntityType::RadioHub,
+                                  TestData::UE_ID,
+                                  SimMessageType::RegistrationResponse,
+                                  QPointF(), status),
+                              QHostAddress::LocalHost, ue_port)
+                     .is_socket_error_);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(registered_spy.count(), 1);
+}